@@ -61,6 +61,8 @@ class Node  {
 
   public:
     static IRGenerator* irgen;
+    // the unit's symbol table, which may sit on the frozen global scope
+    // of a prelude (see SymbolTable)
     static SymbolTable *symtab;
     Node(yyltype loc);
     Node();
@@ -80,9 +82,10 @@ class Node  {
 
 	static MyStack *stk;
 	static int globalScopeIndex;
-    virtual void Emit() {}
-	
-	//llvm::Value* Emit();
+    virtual void Check() {}
+
+    // expressions return the value they compute, everything else NULL
+    virtual llvm::Value *Emit() { return NULL; }
 };
    
 
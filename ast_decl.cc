@@ -17,6 +17,8 @@ Decl::Decl(Identifier *n) : Node(*n->GetLocation()) {
 VarDecl::VarDecl(Identifier *n, Type *t, Expr *e) : Decl(n) {
     Assert(n != NULL && t != NULL);
     (type=t)->SetParent(this);
+    constValue = NULL;
+    assignTo = NULL;
     if (e) (assignTo=e)->SetParent(this);
     typeq = NULL;
 }
@@ -24,6 +26,8 @@ VarDecl::VarDecl(Identifier *n, Type *t, Expr *e) : Decl(n) {
 VarDecl::VarDecl(Identifier *n, TypeQualifier *tq, Expr *e) : Decl(n) {
     Assert(n != NULL && tq != NULL);
     (typeq=tq)->SetParent(this);
+    constValue = NULL;
+    assignTo = NULL;
     if (e) (assignTo=e)->SetParent(this);
     type = NULL;
 }
@@ -32,6 +36,8 @@ VarDecl::VarDecl(Identifier *n, Type *t, TypeQualifier *tq, Expr *e) : Decl(n) {
     Assert(n != NULL && t != NULL && tq != NULL);
     (type=t)->SetParent(this);
     (typeq=tq)->SetParent(this);
+    constValue = NULL;
+    assignTo = NULL;
     if (e) (assignTo=e)->SetParent(this);
 }
   
@@ -48,6 +54,7 @@ FnDecl::FnDecl(Identifier *n, Type *r, List<VarDecl*> *d) : Decl(n) {
     (formals=d)->SetParentAll(this);
     body = NULL;
     returnTypeq = NULL;
+    builtin = false;
 }
 
 FnDecl::FnDecl(Identifier *n, Type *r, TypeQualifier *rq, List<VarDecl*> *d) : Decl(n) {
@@ -56,6 +63,7 @@ FnDecl::FnDecl(Identifier *n, Type *r, TypeQualifier *rq, List<VarDecl*> *d) : D
     (returnTypeq=rq)->SetParent(this);
     (formals=d)->SetParentAll(this);
     body = NULL;
+    builtin = false;
 }
 
 void FnDecl::SetFunctionBody(Stmt *b) { 
@@ -70,35 +78,216 @@ void FnDecl::PrintChildren(int indentLevel) {
 }
 
 
-void VarDecl::Emit(){
-	// llvm::Value* val = NULL;
-	// llvm::Value* init = NULL;
-    Symbol sym;
-    char* name = this->GetIdentifier()->GetName();
+llvm::Value *VarDecl::Emit() {
+    char *name = id->GetName();
+    llvm::Module *module = irgen->GetOrCreateModule("glc.bc");
+    llvm::Type *ty = irgen->GetType(type);
+    llvm::Value *value = NULL;
+    if (ty == NULL)
+        return NULL;   // no lowering for this type yet
 
-    // Symbol* symbol_f = symtab->tables[index]->find(name);
-    llvm::Module *module = irgen->GetOrCreateModule("foo.bc");
-    llvm::Type *type = irgen->GetType(this->GetType());
-    llvm::Twine *twine = new llvm::Twine(name);	
-    llvm::BasicBlock *bb = irgen->GetBasicBlock();
+    if (constValue != NULL && !dynamic_cast<ArrayType*>(type)) {
+        // a folded scalar const needs no storage, uses see the constant
+        value = irgen->GetConstant(constValue);
+    }
+    else if (constValue != NULL || symtab->isGlobalScope()) {
+        // a global's initializer folds, Check() reported any that doesn't
+        ConstValue *folded = constValue;
+        if (folded == NULL && assignTo != NULL)
+            folded = ConvertConst(assignTo->EvalConst(), type);
+        llvm::Constant *init = folded ? irgen->GetConstant(folded)
+                                      : llvm::Constant::getNullValue(ty);
+        llvm::GlobalValue::LinkageTypes linkage = constValue ?
+            llvm::GlobalValue::PrivateLinkage : llvm::GlobalValue::ExternalLinkage;
+        llvm::GlobalVariable *gv = new llvm::GlobalVariable(*module, ty, constValue != NULL, linkage, init, name);
+        if (IsUniform())
+            irgen->AddUniform(gv);
+        value = gv;
+    }
+    else if (dynamic_cast<ArrayType*>(type)) {
+        // arrays are indexed through their address, so they stay in memory
+        value = irgen->CreateEntryAlloca(ty, name);
+        if (assignTo) {
+            llvm::Value *init = assignTo->Emit();
+            irgen->GetBuilder()->CreateStore(init, value);
+        }
+    }
+    else {
+        // any other local is a register, each assignment a new definition
+        llvm::Value *init = assignTo ? assignTo->EmitAs(type) : llvm::UndefValue::get(ty);
+        irgen->DeclareLocal(this);
+        irgen->WriteLocal(this, init);
+    }
 
-	if (symtab->isGlobalScope()) {
-        llvm::GlobalVariable *variable = new llvm::GlobalVariable(module, type, false, llvm::GlobalValue::ExternalLinkage, llvm::Constant::getNullValue(type), name);
-        sym.name = name;
-        sym.value = variable;
-        symtab->insert(sym);
+    // globals were entered by Check(), locals are entered as their scope is emitted
+    Symbol *sym = symtab->currentScope()->find(name);
+    if (sym != NULL)
+        sym->value = value;
+    else {
+        Symbol s(name, this, E_VarDecl, value);
+        symtab->insert(s);
     }
-    else {  //if not global
-        llvm::AllocaInst *allocInst = new llvm::AllocaInst(type,*twine,bb);
-        sym.value = allocInst;
+    return NULL;
+}
+
+llvm::Value *VarDecl::EmitShared() {
+    char *name = id->GetName();
+    Symbol *sym = symtab->find(name);
+    if (sym != NULL && sym->value != NULL)
+        return sym->value;
+
+    // const arrays are materialized in each unit; the others are a weak
+    // zeroed definition, so the unit links and runs on its own while a
+    // host linking its own definition of the global still wins
+    llvm::Module *module = irgen->GetOrCreateModule("glc.bc");
+    llvm::Type *ty = irgen->GetType(type);
+    llvm::Constant *init = constValue ? irgen->GetConstant(constValue) : llvm::Constant::getNullValue(ty);
+    llvm::GlobalValue::LinkageTypes linkage = constValue ?
+        llvm::GlobalValue::PrivateLinkage : llvm::GlobalValue::WeakAnyLinkage;
+    llvm::GlobalVariable *gv = new llvm::GlobalVariable(*module, ty, constValue != NULL, linkage, init, name);
+    if (IsUniform())
+        irgen->AddUniform(gv);
+    Symbol s(name, this, E_VarDecl, gv);
+    symtab->tables.front()->insert(s);
+    return gv;
+}
+
+llvm::Value *FnDecl::Emit() {
+    // prototypes and built-ins are declared by their first call
+    if (body == NULL)
+        return NULL;
+
+    llvm::Function *f = irgen->GetOrDeclareFunction(this);
+    llvm::LLVMContext *context = irgen->GetContext();
+    llvm::BasicBlock *entry = llvm::BasicBlock::Create(*context, "entry", f);
+    irgen->SetFunction(f);
+    irgen->SetBasicBlock(entry);
+    irgen->SetDebugLocation(GetLocation());
+    irgen->SealBlock(entry);
+
+    // formals are locals whose first definition is the argument
+    symtab->push();
+    for (int i = 0; i < formals->NumElements(); i++) {
+        VarDecl *formal = formals->Nth(i);
+        formal->Emit();
+        if (irgen->IsLocal(formal))
+            irgen->WriteLocal(formal, f->getArg(i));
+        else {
+            Symbol *sym = symtab->find(formal->GetIdentifier()->GetName());
+            irgen->GetBuilder()->CreateStore(f->getArg(i), sym->value);
+        }
+    }
+    body->Emit();
+
+    // falling off the end returns, with an undefined value if there is one
+    if (irgen->GetBasicBlock()->getTerminator() == NULL) {
+        llvm::Type *retTy = f->getReturnType();
+        if (retTy->isVoidTy())
+            irgen->GetBuilder()->CreateRetVoid();
+        else
+            irgen->GetBuilder()->CreateRet(llvm::UndefValue::get(retTy));
+    }
+    symtab->pop();
+
+    irgen->SetFunction(NULL);
+    irgen->SetBasicBlock(NULL);
+    if (irgen->GetSPMDWidth() > 0)
+        irgen->EmitSPMDVariant(this);
+    return f;
+}
+
+bool VarDecl::IsConst() const {
+    return typeq == TypeQualifier::constTypeQualifier;
+}
+
+bool VarDecl::IsUniform() const {
+    return typeq == TypeQualifier::uniformTypeQualifier;
+}
+
+void VarDecl::Check() {
+    if (type == NULL)
+        type = Type::errorType;
+    type->Check();
+
+    Symbol *prev = symtab->currentScope()->find(id->GetName());
+    if (prev == NULL && symtab->isGlobalScope())
+        prev = symtab->findShared(id->GetName());
+    if (prev != NULL)
+        ReportError::DeclConflict(this, prev->decl);
+
+    if (assignTo) {
+        assignTo->Check();
+        Type *initType = assignTo->GetType();
+        if (!initType->IsError() && !type->IsError() && !initType->IsConvertibleTo(type))
+            ReportError::InvalidInitialization(id, type, initType);
+        else if (IsConst() && !initType->IsError()) {
+            constValue = ConvertConst(assignTo->EvalConst(), type);
+            if (constValue == NULL)
+                ReportError::Formatted(assignTo->GetLocation(),
+                    "Initializer of const variable '%s' must be a constant expression",
+                    id->GetName());
+        }
+        // a global is initialized before any code runs
+        else if (symtab->isGlobalScope() && !initType->IsError() &&
+                 assignTo->EvalConst() == NULL)
+            ReportError::Formatted(assignTo->GetLocation(),
+                "Initializer of global variable '%s' must be a constant expression",
+                id->GetName());
+    }
+    else if (IsConst())
+        ReportError::Formatted(GetLocation(),
+            "const variable '%s' must be initialized", id->GetName());
+    if (IsUniform() && !symtab->isGlobalScope())
+        ReportError::Formatted(GetLocation(),
+            "uniform variable '%s' must be declared at global scope", id->GetName());
+
+    if (prev == NULL) {
+        Symbol sym(id->GetName(), this, E_VarDecl);
         symtab->insert(sym);
     }
-	//return val;
 }
 
-void FnDecl::Emit() {
-	llvm::Value* val = NULL;
-	llvm::Value* init = NULL;
-	
-	//return val;
+void FnDecl::Check() {
+    // the signature is hashed with the formals' types, so array sizes
+    // given by constant expressions are folded first
+    for (int i = 0; i < formals->NumElements(); i++)
+        if (formals->Nth(i)->GetType() != NULL)
+            formals->Nth(i)->GetType()->Check();
+
+    // all functions of one name share a symbol, each signature is an overload;
+    // a name from the shared global scope gets a local set extending it
+    Symbol *prev = symtab->currentScope()->find(id->GetName());
+    Symbol *inherited = prev ? NULL : symtab->findShared(id->GetName());
+    if (inherited != NULL && inherited->overloads == NULL)
+        ReportError::DeclConflict(this, inherited->decl);
+    else if (prev == NULL) {
+        Symbol sym(id->GetName(), this, E_FunctionDecl);
+        sym.overloads = new OverloadSet(inherited ? inherited->overloads : NULL);
+        FnDecl *same = sym.overloads->insert(this);
+        if (same != NULL)
+            ReportError::DeclConflict(this, same);
+        symtab->insert(sym);
+    }
+    else if (prev->kind != E_FunctionDecl || prev->overloads == NULL)
+        ReportError::DeclConflict(this, prev->decl);
+    else {
+        FnDecl *same = prev->overloads->insert(this);
+        if (same != NULL)
+            ReportError::DeclConflict(this, same);
+    }
+
+    // formals live in their own scope, the body block opens one below it
+    symtab->push();
+    for (int i = 0; i < formals->NumElements(); i++)
+        formals->Nth(i)->Check();
+
+    symtab->returnType = returnType;
+    symtab->noReturnFlag = true;
+    if (body) {
+        body->Check();
+        if (symtab->noReturnFlag && !returnType->IsEquivalentTo(Type::voidType))
+            ReportError::ReturnMissing(this);
+    }
+    symtab->returnType = NULL;
+    symtab->pop();
 }
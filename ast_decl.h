@@ -45,9 +45,10 @@ class VarDecl : public Decl
     Type *type;
     TypeQualifier *typeq;
     Expr *assignTo;
+    ConstValue *constValue;   // folded initializer of a const variable
     
   public:
-    VarDecl() : type(NULL), typeq(NULL), assignTo(NULL) {}
+    VarDecl() : type(NULL), typeq(NULL), assignTo(NULL), constValue(NULL) {}
     VarDecl(Identifier *name, Type *type, Expr *assignTo = NULL);
     VarDecl(Identifier *name, TypeQualifier *typeq, Expr *assignTo = NULL);
     VarDecl(Identifier *name, Type *type, TypeQualifier *typeq, Expr *assignTo = NULL);
@@ -56,7 +57,15 @@ class VarDecl : public Decl
     Type *GetType() const { return type; }
 	
 	Expr* GetAssignTo() const { return assignTo; }
-	void Emit();   // emit function
+	TypeQualifier *GetTypeQualifier() const { return typeq; }
+	bool IsConst() const;
+	bool IsUniform() const;
+	ConstValue *GetConstValue() const { return constValue; }
+	void Check();
+	llvm::Value *Emit();   // emit function
+	// storage of a global of the shared scope in this unit's module,
+	// emitted on first use by the unit or the host
+	llvm::Value *EmitShared();
 };
 
 class VarDeclError : public VarDecl
@@ -73,9 +82,10 @@ class FnDecl : public Decl
     Type *returnType;
     TypeQualifier *returnTypeq;
     Stmt *body;
+    bool builtin;
     
   public:
-    FnDecl() : Decl(), formals(NULL), returnType(NULL), returnTypeq(NULL), body(NULL) {}
+    FnDecl() : Decl(), formals(NULL), returnType(NULL), returnTypeq(NULL), body(NULL), builtin(false) {}
     FnDecl(Identifier *name, Type *returnType, List<VarDecl*> *formals);
     FnDecl(Identifier *name, Type *returnType, TypeQualifier *returnTypeq, List<VarDecl*> *formals);
     void SetFunctionBody(Stmt *b);
@@ -84,8 +94,12 @@ class FnDecl : public Decl
 
     Type *GetType() const { return returnType; }
     List<VarDecl*> *GetFormals() {return formals;}
+    Stmt *GetBody() const { return body; }
+    bool IsBuiltin() const { return builtin; }
+    void SetBuiltin() { builtin = true; }
 	
-	void Emit();
+	void Check();
+	llvm::Value *Emit();
 };
 
 class FormalsError : public FnDecl
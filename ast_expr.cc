@@ -3,11 +3,17 @@
  * Implementation of expression node classes.
  */
 
+#include <math.h>
+#include <stdint.h>
 #include <string.h>
+#include <sstream>
 #include "ast_expr.h"
 #include "ast_type.h"
 #include "ast_decl.h"
 #include "symtable.h"
+#include "irgen.h"
+#include "builtins.h"
+#include "llvm/IR/Intrinsics.h"
 
 IntConstant::IntConstant(yyltype loc, int val) : Expr(loc) {
     value = val;
@@ -33,6 +39,7 @@ void BoolConstant::PrintChildren(int indentLevel) {
 VarExpr::VarExpr(yyltype loc, Identifier *ident) : Expr(loc) {
     Assert(ident != NULL);
     this->id = ident;
+    decl = NULL;
 }
 
 void VarExpr::PrintChildren(int indentLevel) {
@@ -71,6 +78,7 @@ CompoundExpr::CompoundExpr(Operator *o, Expr *r)
 CompoundExpr::CompoundExpr(Expr *l, Operator *o) 
   : Expr(Join(l->GetLocation(), o->GetLocation())) {
     Assert(l != NULL && o != NULL);
+    right = NULL;
     (left=l)->SetParent(this);
     (op=o)->SetParent(this);
 }
@@ -94,7 +102,7 @@ void ConditionalExpr::PrintChildren(int indentLevel) {
     trueExpr->Print(indentLevel+1, "(true) ");
     falseExpr->Print(indentLevel+1, "(false) ");
 }
-ArrayAccess::ArrayAccess(yyltype loc, Expr *b, Expr *s) : LValue(loc) {
+ArrayAccess::ArrayAccess(yyltype loc, Expr *b, Expr *s) : LValue(loc), index(NULL), pins(0) {
     (base=b)->SetParent(this); 
     (subscript=s)->SetParent(this);
 }
@@ -110,6 +118,7 @@ FieldAccess::FieldAccess(Expr *b, Identifier *f)
     base = b; 
     if (base) base->SetParent(this); 
     (field=f)->SetParent(this);
+    swizzleLen = 0;
 }
 
 
@@ -120,15 +129,1572 @@ void FieldAccess::PrintChildren(int indentLevel) {
 
 Call::Call(yyltype loc, Expr *b, Identifier *f, List<Expr*> *a) : Expr(loc)  {
     Assert(f != NULL && a != NULL); // b can be be NULL (just means no explicit base)
+    decl = NULL;
     base = b;
     if (base) base->SetParent(this);
     (field=f)->SetParent(this);
     (actuals=a)->SetParentAll(this);
 }
 
+ConstructorExpr::ConstructorExpr(yyltype loc, Type *t, List<Expr*> *a) : Expr(loc) {
+    Assert(t != NULL && a != NULL);
+    ctorType = t;
+    (args=a)->SetParentAll(this);
+}
+
+void ConstructorExpr::PrintChildren(int indentLevel) {
+    ctorType->Print(indentLevel+1);
+    args->PrintAll(indentLevel+1, "(args) ");
+}
+
 void Call::PrintChildren(int indentLevel) {
    if (base) base->Print(indentLevel+1);
    if (field) field->Print(indentLevel+1);
    if (actuals) actuals->PrintAll(indentLevel+1, "(actuals) ");
 }
 
+
+/* Semantic checks
+ * ---------------
+ * Each CheckType() checks the node's children, reports any error on this
+ * node and returns its type. An operand that is already errorType was
+ * reported further down, so it silently makes the parent errorType too.
+ */
+
+Type *VarExpr::CheckType() {
+    Symbol *sym = symtab->find(id->GetName());
+    if (sym == NULL) {
+        ReportError::IdentifierNotDeclared(id, LookingForVariable);
+        return Type::errorType;
+    }
+    decl = dynamic_cast<VarDecl*>(sym->decl);
+    if (decl == NULL) {
+        ReportError::IdentifierNotDeclared(id, LookingForVariable);
+        return Type::errorType;
+    }
+    return decl->GetType();
+}
+
+bool CompoundExpr::CheckOperands() {
+    bool isError = false;
+    if (left) {
+        left->Check();
+        isError = isError || left->GetType()->IsError();
+    }
+    if (right) {
+        right->Check();
+        isError = isError || right->GetType()->IsError();
+    }
+    return isError;
+}
+
+Type *ArithmeticExpr::ResultType(Operator *op, Type *l, Type *r) {
+    bool isMul = op->IsOp("*") || op->IsOp("*=");
+
+    if (l->IsEquivalentTo(r)) {
+        if (l->IsNumeric() || l->IsEquivalentTo(Type::uintType) ||
+            (l->IsVector() && !l->GetScalarType()->IsBool()) || l->IsMatrix())
+            return l;
+        return Type::errorType;
+    }
+
+    // a scalar combines with a vector or matrix of the same base type
+    if ((l->IsVector() || l->IsMatrix()) && r->GetScalarType()->IsEquivalentTo(r) &&
+        l->GetScalarType()->IsEquivalentTo(r) && !r->IsBool())
+        return l;
+    if ((r->IsVector() || r->IsMatrix()) && l->GetScalarType()->IsEquivalentTo(l) &&
+        r->GetScalarType()->IsEquivalentTo(l) && !l->IsBool())
+        return r;
+
+    // linear algebra products: matN * vecN and vecN * matN give vecN
+    if (isMul && l->IsMatrix() && r->IsVector() &&
+        r->GetScalarType() == Type::floatType && l->GetVectorSize() == r->GetVectorSize())
+        return r;
+    if (isMul && l->IsVector() && r->IsMatrix() &&
+        l->GetScalarType() == Type::floatType && l->GetVectorSize() == r->GetVectorSize())
+        return l;
+
+    return Type::errorType;
+}
+
+Type *ArithmeticExpr::CheckType() {
+    if (CheckOperands())
+        return Type::errorType;
+
+    Type *rType = right->GetType();
+    if (left == NULL) {
+        // unary + - ++ --
+        if (rType->IsNumeric() || rType->IsVector() || rType->IsMatrix())
+            if (!rType->GetScalarType()->IsBool())
+                return rType;
+        ReportError::IncompatibleOperand(op, rType);
+        return Type::errorType;
+    }
+
+    Type *lType = left->GetType();
+    Type *result = ResultType(op, lType, rType);
+    if (result->IsError())
+        ReportError::IncompatibleOperands(op, lType, rType);
+    return result;
+}
+
+Type *RelationalExpr::CheckType() {
+    if (CheckOperands())
+        return Type::errorType;
+
+    Type *lType = left->GetType(), *rType = right->GetType();
+    if (!lType->IsEquivalentTo(rType) ||
+        !(lType->IsNumeric() || lType->IsEquivalentTo(Type::uintType))) {
+        ReportError::IncompatibleOperands(op, lType, rType);
+        return Type::errorType;
+    }
+    return Type::boolType;
+}
+
+Type *EqualityExpr::CheckType() {
+    if (CheckOperands())
+        return Type::errorType;
+
+    Type *lType = left->GetType(), *rType = right->GetType();
+    if (!lType->IsEquivalentTo(rType) || lType->IsEquivalentTo(Type::voidType)) {
+        ReportError::IncompatibleOperands(op, lType, rType);
+        return Type::errorType;
+    }
+    return Type::boolType;
+}
+
+// bvec2 to bvec4, which logic and ?: take component-wise
+static bool IsBoolVector(Type *t) {
+    return t->IsVector() && t->GetScalarType() == Type::boolType;
+}
+
+Type *LogicalExpr::CheckType() {
+    if (CheckOperands())
+        return Type::errorType;
+
+    Type *rType = right->GetType();
+    if (left == NULL) {
+        if (!rType->IsBool() && !IsBoolVector(rType)) {
+            ReportError::IncompatibleOperand(op, rType);
+            return Type::errorType;
+        }
+        return rType;
+    }
+
+    Type *lType = left->GetType();
+    if (!lType->IsEquivalentTo(rType) || (!lType->IsBool() && !IsBoolVector(lType))) {
+        ReportError::IncompatibleOperands(op, lType, rType);
+        return Type::errorType;
+    }
+    return lType;
+}
+
+// reports an assignment, ++ or -- whose target is a const variable,
+// (any part of) a uniform, which only the host sets, or a swizzle that
+// writes one component twice
+static void CheckNotConst(Expr *target) {
+    Expr *root = target;
+    for (Expr *base = root; base != NULL; ) {
+        root = base;
+        ArrayAccess *a = dynamic_cast<ArrayAccess*>(root);
+        FieldAccess *f = dynamic_cast<FieldAccess*>(root);
+        if (f && f->RepeatsComponent())
+            ReportError::Formatted(f->GetField()->GetLocation(),
+                "Cannot assign to swizzle '%s', it repeats a component", f->GetField()->GetName());
+        base = a ? a->GetBase() : f ? f->GetBase() : NULL;
+    }
+    VarExpr *var = dynamic_cast<VarExpr*>(root);
+    if (var && var->GetDecl() && var->GetDecl()->IsUniform()) {
+        ReportError::Formatted(target->GetLocation(),
+            "Cannot assign to uniform variable '%s'", var->GetIdentifier()->GetName());
+        return;
+    }
+    var = dynamic_cast<VarExpr*>(target);
+    if (var && var->GetDecl() && var->GetDecl()->IsConst())
+        ReportError::Formatted(target->GetLocation(),
+            "Cannot assign to const variable '%s'", var->GetIdentifier()->GetName());
+}
+
+Type *AssignExpr::CheckType() {
+    if (CheckOperands())
+        return Type::errorType;
+    CheckNotConst(left);
+
+    Type *lType = left->GetType(), *rType = right->GetType();
+    if (op->IsOp("=")) {
+        if (!rType->IsConvertibleTo(lType)) {
+            ReportError::IncompatibleOperands(op, lType, rType);
+            return Type::errorType;
+        }
+        return lType;
+    }
+
+    // compound assignment: the arithmetic result must fit back into lhs
+    if (!ArithmeticExpr::ResultType(op, lType, rType)->IsEquivalentTo(lType)) {
+        ReportError::IncompatibleOperands(op, lType, rType);
+        return Type::errorType;
+    }
+    return lType;
+}
+
+Type *PostfixExpr::CheckType() {
+    if (CheckOperands())
+        return Type::errorType;
+    CheckNotConst(left);
+
+    Type *lType = left->GetType();
+    if (lType->IsNumeric() || lType->IsVector() || lType->IsMatrix())
+        if (!lType->GetScalarType()->IsBool())
+            return lType;
+    ReportError::IncompatibleOperand(op, lType);
+    return Type::errorType;
+}
+
+Type *ConditionalExpr::CheckType() {
+    cond->Check();
+    trueExpr->Check();
+    falseExpr->Check();
+
+    Type *cType = cond->GetType();
+    Type *tType = trueExpr->GetType(), *fType = falseExpr->GetType();
+    if (tType->IsError() || fType->IsError())
+        return Type::errorType;
+    // a bvec picks each component of vector arms separately
+    if (IsBoolVector(cType)) {
+        if (!tType->IsVector() || tType->GetVectorSize() != cType->GetVectorSize())
+            ReportError::TestNotBoolean(cond);
+    }
+    else if (!cType->IsError() && !cType->IsBool())
+        ReportError::TestNotBoolean(cond);
+    if (!tType->IsEquivalentTo(fType)) {
+        ostringstream s;
+        s << "Incompatible types in conditional expression: " << tType << ", " << fType;
+        ReportError::Formatted(GetLocation(), "%s", s.str().c_str());
+        return Type::errorType;
+    }
+    return tType;
+}
+
+Type *ArrayAccess::CheckType() {
+    base->Check();
+    subscript->Check();
+
+    Type *bType = base->GetType(), *sType = subscript->GetType();
+    if (bType->IsError() || sType->IsError())
+        return Type::errorType;
+
+    if (!sType->IsEquivalentTo(Type::intType) && !sType->IsEquivalentTo(Type::uintType)) {
+        ReportError::Formatted(subscript->GetLocation(), "Array subscript must be an integer");
+        return Type::errorType;
+    }
+
+    ArrayType *arrType = dynamic_cast<ArrayType*>(bType);
+    if (arrType)
+        return arrType->GetElemType();
+    if (bType->IsVector())
+        return bType->GetScalarType();
+    if (bType->IsMatrix())
+        return Type::GetVectorType(Type::floatType, bType->GetVectorSize());
+
+    VarExpr *var = dynamic_cast<VarExpr*>(base);
+    if (var)
+        ReportError::NotAnArray(var->GetIdentifier());
+    else
+        ReportError::Formatted(base->GetLocation(), "%s is not an array.", base->GetPrintNameForNode());
+    return Type::errorType;
+}
+
+enum SwizzleStatus { SwizzleOk, SwizzleInvalid, SwizzleOutOfBound, SwizzleOversized };
+
+// decodes a swizzle of a vector of the given size into the component each
+// position selects; comps receives at most four of them
+static SwizzleStatus DecodeSwizzle(const char *name, int size, int *comps, int *len) {
+    *len = strlen(name);
+    for (int i = 0; i < *len; i++)
+        if (strchr("xyzw", name[i]) == NULL)
+            return SwizzleInvalid;
+    for (int i = 0; i < *len; i++)
+        if (strchr("xyzw", name[i]) - "xyzw" >= size)
+            return SwizzleOutOfBound;
+    if (*len > 4)
+        return SwizzleOversized;
+    for (int i = 0; i < *len; i++)
+        comps[i] = strchr("xyzw", name[i]) - "xyzw";
+    return SwizzleOk;
+}
+
+bool FieldAccess::RepeatsComponent() const {
+    for (int i = 0; i < swizzleLen; i++)
+        for (int j = 0; j < i; j++)
+            if (swizzle[i] == swizzle[j])
+                return true;
+    return false;
+}
+
+Type *FieldAccess::CheckType() {
+    base->Check();
+
+    Type *bType = base->GetType();
+    if (bType->IsError())
+        return Type::errorType;
+    if (!bType->IsVector()) {
+        ReportError::InaccessibleSwizzle(field, base);
+        return Type::errorType;
+    }
+
+    switch (DecodeSwizzle(field->GetName(), bType->GetVectorSize(), swizzle, &swizzleLen)) {
+      case SwizzleInvalid:
+        ReportError::InvalidSwizzle(field, base);
+        return Type::errorType;
+      case SwizzleOutOfBound:
+        ReportError::SwizzleOutOfBound(field, base);
+        return Type::errorType;
+      case SwizzleOversized:
+        ReportError::OversizedVector(field, base);
+        return Type::errorType;
+      default:
+        return Type::GetVectorType(bType->GetScalarType(), swizzleLen);
+    }
+}
+
+Type *Call::CheckType() {
+    if (field == NULL || actuals == NULL)
+        return Type::errorType;
+
+    bool argError = false;
+    Signature args;
+    for (int i = 0; i < actuals->NumElements(); i++) {
+        actuals->Nth(i)->Check();
+        args.push_back(actuals->Nth(i)->GetType());
+        argError = argError || args.back()->IsError();
+    }
+
+    Symbol *sym = symtab->find(field->GetName());
+    if (sym == NULL) {
+        ReportError::IdentifierNotDeclared(field, LookingForFunction);
+        return Type::errorType;
+    }
+    if (sym->kind != E_FunctionDecl || sym->overloads == NULL) {
+        ReportError::NotAFunction(field);
+        return Type::errorType;
+    }
+
+    OverloadSet *overloads = sym->overloads;
+    FnDecl *only = overloads->size() == 1 ? overloads->any() : NULL;
+    if (argError)
+        return only ? only->GetType() : Type::errorType;
+
+    bool ambiguous;
+    decl = overloads->resolve(args, &ambiguous);
+    if (decl != NULL)
+        return decl->GetType();
+
+    if (ambiguous) {
+        ReportError::Formatted(field->GetLocation(),
+            "Ambiguous call to overloaded function '%s'", field->GetName());
+        return Type::errorType;
+    }
+    if (only == NULL) {
+        ReportError::Formatted(field->GetLocation(),
+            "No matching overload for function '%s'", field->GetName());
+        return Type::errorType;
+    }
+
+    // a single candidate gets the precise arity/type diagnostics
+    List<VarDecl*> *formals = only->GetFormals();
+    int expected = formals->NumElements(), given = actuals->NumElements();
+    if (given > expected)
+        ReportError::ExtraFormals(field, expected, given);
+    else if (given < expected)
+        ReportError::LessFormals(field, expected, given);
+    else {
+        for (int i = 0; i < given; i++) {
+            Type *expType = formals->Nth(i)->GetType();
+            if (!args[i]->IsConvertibleTo(expType)) {
+                ReportError::FormalsTypeMismatch(field, i+1, expType, args[i]);
+                break;
+            }
+        }
+    }
+    return only->GetType();
+}
+
+// number of scalar components an argument contributes to a constructor
+static int ComponentCount(Type *t) {
+    if (t->IsMatrix())
+        return t->GetVectorSize() * t->GetVectorSize();
+    return t->GetVectorSize();
+}
+
+Type *ConstructorExpr::CheckType() {
+    bool argError = false;
+    for (int i = 0; i < args->NumElements(); i++) {
+        args->Nth(i)->Check();
+        argError = argError || args->Nth(i)->GetType()->IsError();
+    }
+    ctorType->Check();
+    if (argError)
+        return Type::errorType;
+
+    int given = args->NumElements();
+    bool valid = given > 0;
+    ArrayType *arrType = dynamic_cast<ArrayType*>(ctorType);
+    if (arrType) {
+        valid = valid && given == arrType->GetElemCount();
+        for (int i = 0; valid && i < given; i++)
+            valid = args->Nth(i)->GetType()->IsEquivalentTo(arrType->GetElemType());
+    }
+    else if (given == 1) {
+        // one scalar converts, fills a vector or a matrix diagonal; one
+        // vector or matrix converts componentwise or gives up its first
+        Type *t = args->Nth(0)->GetType();
+        int n = ComponentCount(t);
+        valid = n == 1 || t->IsEquivalentTo(ctorType) ||
+                (!ctorType->IsMatrix() && !t->IsMatrix() && n >= ComponentCount(ctorType));
+    }
+    else {
+        // several arguments are consumed in order, each must contribute
+        int needed = ComponentCount(ctorType), supplied = 0;
+        for (int i = 0; valid && i < given; i++) {
+            Type *t = args->Nth(i)->GetType();
+            valid = supplied < needed && !t->IsMatrix() && ComponentCount(t) > 0;
+            supplied += ComponentCount(t);
+        }
+        valid = valid && (ctorType->IsMatrix() ? supplied == needed : supplied >= needed);
+    }
+
+    if (!valid) {
+        ostringstream s;
+        s << "Invalid arguments to constructor of '" << ctorType << "'";
+        ReportError::Formatted(GetLocation(), "%s", s.str().c_str());
+        return Type::errorType;
+    }
+    return ctorType;
+}
+
+/* Constant folding
+ * ----------------
+ * EvalConst() computes constant expressions for const initializers,
+ * array sizes and case labels. It runs on checked trees only, so the
+ * operand types are known to combine.
+ */
+
+// the 32 bits of an int or uint component, v truncated toward zero and
+// wrapped the way the program's arithmetic wraps; values GLSL leaves
+// undefined (NaN, far out of range) give 0 rather than undefined C++
+static uint32_t IntBits(double v) {
+    int64_t whole = fabs(v) < 9223372036854775808.0 ? (int64_t)v : 0;
+    return (uint32_t)(whole & 0xffffffff);
+}
+
+// converts one component to the representation of the scalar type t
+static double ConvertComponent(double v, Type *t) {
+    if (t == Type::intType)  return (double)(int32_t)IntBits(v);
+    if (t == Type::uintType) return (double)IntBits(v);
+    if (t == Type::boolType) return v != 0 ? 1 : 0;
+    return (double)(float)v;
+}
+
+ConstValue *ConvertConst(ConstValue *v, Type *to) {
+    if (v == NULL || v->type->IsEquivalentTo(to))
+        return v;
+    ConstValue *c = new ConstValue(to);
+    for (int i = 0; i < v->comps.size(); i++)
+        c->comps.push_back(ConvertComponent(v->comps[i], to->GetScalarType()));
+    return c;
+}
+
+static ConstValue *MakeScalar(Type *t, double v) {
+    ConstValue *c = new ConstValue(t);
+    c->comps.push_back(ConvertComponent(v, t));
+    return c;
+}
+
+ConstValue *IntConstant::EvalConst() {
+    return MakeScalar(Type::intType, value);
+}
+
+ConstValue *FloatConstant::EvalConst() {
+    return MakeScalar(Type::floatType, value);
+}
+
+ConstValue *BoolConstant::EvalConst() {
+    return MakeScalar(Type::boolType, value);
+}
+
+ConstValue *VarExpr::EvalConst() {
+    return decl ? decl->GetConstValue() : NULL;
+}
+
+// int and uint fold in 32-bit wrapping arithmetic, as the program runs
+// them; a double would round products past 2^53
+static bool ApplyIntArithmetic(Operator *op, Type *scalar, double a, double b, double *out) {
+    bool isSigned = scalar == Type::intType;
+    uint32_t x = IntBits(a), y = IntBits(b), z;
+    if (op->IsOp("+") || op->IsOp("+="))
+        z = x + y;
+    else if (op->IsOp("-") || op->IsOp("-="))
+        z = x - y;
+    else if (op->IsOp("*") || op->IsOp("*="))
+        z = x * y;
+    else if (op->IsOp("/") || op->IsOp("/=")) {
+        // left for the program to trap at run time
+        if (y == 0 || (isSigned && (int32_t)x == INT32_MIN && (int32_t)y == -1))
+            return false;
+        z = isSigned ? (uint32_t)((int32_t)x / (int32_t)y) : x / y;
+    }
+    else
+        return false;
+    *out = isSigned ? (double)(int32_t)z : (double)z;
+    return true;
+}
+
+static bool ApplyArithmetic(Operator *op, Type *scalar, double a, double b, double *out) {
+    if (scalar != Type::floatType)
+        return ApplyIntArithmetic(op, scalar, a, b, out);
+    if (op->IsOp("+") || op->IsOp("+="))
+        *out = a + b;
+    else if (op->IsOp("-") || op->IsOp("-="))
+        *out = a - b;
+    else if (op->IsOp("*") || op->IsOp("*="))
+        *out = a * b;
+    else if (op->IsOp("/") || op->IsOp("/="))
+        *out = a / b;
+    else
+        return false;
+    *out = ConvertComponent(*out, scalar);
+    return true;
+}
+
+ConstValue *ArithmeticExpr::EvalConst() {
+    if (type == NULL || type->IsError())
+        return NULL;
+    ConstValue *r = right->EvalConst();
+    if (r == NULL)
+        return NULL;
+
+    Type *scalar = type->GetScalarType();
+    ConstValue *result = new ConstValue(type);
+    if (left == NULL) {
+        if (!op->IsOp("-") && !op->IsOp("+"))
+            return NULL;   // ++ and -- need a variable
+        for (int i = 0; i < r->comps.size(); i++)
+            result->comps.push_back(ConvertComponent(op->IsOp("-") ? -r->comps[i] : r->comps[i], scalar));
+        return result;
+    }
+
+    ConstValue *l = left->EvalConst();
+    if (l == NULL)
+        return NULL;
+    Type *lType = left->GetType(), *rType = right->GetType();
+
+    // linear algebra products, matrices stored column by column
+    if (op->IsOp("*") && (lType->IsMatrix() || rType->IsMatrix()) &&
+        !lType->GetScalarType()->IsEquivalentTo(lType) && !rType->GetScalarType()->IsEquivalentTo(rType)) {
+        int n = (lType->IsMatrix() ? lType : rType)->GetVectorSize();
+        int cols = rType->IsMatrix() ? n : 1;
+        for (int c = 0; c < cols; c++) {
+            for (int row = 0; row < n; row++) {
+                double sum = 0;
+                for (int k = 0; k < n; k++) {
+                    if (lType->IsMatrix())
+                        sum += l->comps[k*n + row] * r->comps[c*n + k];
+                    else   // vector * matrix: dot product with column `row`
+                        sum += l->comps[k] * r->comps[row*n + k];
+                }
+                result->comps.push_back(ConvertComponent(sum, scalar));
+            }
+        }
+        return result;
+    }
+
+    int n = max(l->comps.size(), r->comps.size());
+    for (int i = 0; i < n; i++) {
+        double a = l->comps[l->comps.size() == 1 ? 0 : i];
+        double b = r->comps[r->comps.size() == 1 ? 0 : i];
+        double v;
+        if (!ApplyArithmetic(op, scalar, a, b, &v))
+            return NULL;
+        result->comps.push_back(v);
+    }
+    return result;
+}
+
+ConstValue *RelationalExpr::EvalConst() {
+    ConstValue *l = left->EvalConst(), *r = right ? right->EvalConst() : NULL;
+    if (l == NULL || r == NULL || type == NULL || type->IsError())
+        return NULL;
+
+    double a = l->comps[0], b = r->comps[0];
+    bool v = op->IsOp("<") ? a < b : op->IsOp(">") ? a > b : op->IsOp("<=") ? a <= b : a >= b;
+    return MakeScalar(Type::boolType, v);
+}
+
+static bool SameValue(ConstValue *a, ConstValue *b) {
+    if (a->comps != b->comps || a->elems.size() != b->elems.size())
+        return false;
+    for (int i = 0; i < a->elems.size(); i++)
+        if (!SameValue(a->elems[i], b->elems[i]))
+            return false;
+    return true;
+}
+
+ConstValue *EqualityExpr::EvalConst() {
+    ConstValue *l = left->EvalConst(), *r = right->EvalConst();
+    if (l == NULL || r == NULL || type == NULL || type->IsError())
+        return NULL;
+    bool same = SameValue(l, r);
+    return MakeScalar(Type::boolType, op->IsOp("==") ? same : !same);
+}
+
+ConstValue *LogicalExpr::EvalConst() {
+    if (type == NULL || type->IsError())
+        return NULL;
+    ConstValue *r = right->EvalConst();
+    if (r == NULL)
+        return NULL;
+    ConstValue *l = left ? left->EvalConst() : NULL;
+    if (left != NULL && l == NULL)
+        return NULL;
+
+    ConstValue *result = new ConstValue(type);
+    for (size_t i = 0; i < r->comps.size(); i++) {
+        bool v = !r->comps[i];
+        if (op->IsOp("&&"))
+            v = l->comps[i] && r->comps[i];
+        else if (op->IsOp("||"))
+            v = l->comps[i] || r->comps[i];
+        result->comps.push_back(v);
+    }
+    return result;
+}
+
+ConstValue *ConditionalExpr::EvalConst() {
+    if (type == NULL || type->IsError())
+        return NULL;
+    ConstValue *c = cond->EvalConst();
+    ConstValue *t = trueExpr->EvalConst(), *f = falseExpr->EvalConst();
+    if (c == NULL || t == NULL || f == NULL)
+        return NULL;
+    if (c->comps.size() == 1)
+        return c->comps[0] ? t : f;
+
+    ConstValue *result = new ConstValue(type);
+    for (size_t i = 0; i < c->comps.size(); i++)
+        result->comps.push_back(c->comps[i] ? t->comps[i] : f->comps[i]);
+    return result;
+}
+
+ConstValue *ArrayAccess::EvalConst() {
+    if (type == NULL || type->IsError())
+        return NULL;
+    ConstValue *b = base->EvalConst(), *s = subscript->EvalConst();
+    if (b == NULL || s == NULL)
+        return NULL;
+
+    int i = (int)s->comps[0];
+    Type *bType = base->GetType();
+    if (dynamic_cast<ArrayType*>(bType))
+        return (i >= 0 && i < b->elems.size()) ? b->elems[i] : NULL;
+
+    int n = type->GetVectorSize();   // a column of a matrix, or 1 component
+    if (i < 0 || (i+1) * n > b->comps.size())
+        return NULL;
+    ConstValue *result = new ConstValue(type);
+    result->comps.assign(b->comps.begin() + i*n, b->comps.begin() + (i+1)*n);
+    return result;
+}
+
+ConstValue *FieldAccess::EvalConst() {
+    if (type == NULL || type->IsError())
+        return NULL;
+    ConstValue *b = base->EvalConst();
+    if (b == NULL)
+        return NULL;
+
+    ConstValue *result = new ConstValue(type);
+    for (int i = 0; i < swizzleLen; i++)
+        result->comps.push_back(b->comps[swizzle[i]]);
+    return result;
+}
+
+ConstValue *ConstructorExpr::EvalConst() {
+    if (type == NULL || type->IsError())
+        return NULL;
+
+    ConstValue *result = new ConstValue(type);
+    vector<double> flat;
+    for (int i = 0; i < args->NumElements(); i++) {
+        ConstValue *arg = args->Nth(i)->EvalConst();
+        if (arg == NULL)
+            return NULL;
+        if (dynamic_cast<ArrayType*>(type))
+            result->elems.push_back(arg);
+        else
+            flat.insert(flat.end(), arg->comps.begin(), arg->comps.end());
+    }
+    if (dynamic_cast<ArrayType*>(type))
+        return result;
+
+    Type *scalar = type->GetScalarType();
+    int needed = ComponentCount(type);
+    if (flat.size() == 1 && type->IsMatrix()) {
+        int n = type->GetVectorSize();
+        for (int i = 0; i < needed; i++)
+            result->comps.push_back(i % (n+1) == 0 ? ConvertComponent(flat[0], scalar) : 0);
+        return result;
+    }
+    for (int i = 0; i < needed; i++)
+        result->comps.push_back(ConvertComponent(flat[flat.size() == 1 ? 0 : i], scalar));
+    return result;
+}
+
+
+/* IR emission
+ * -----------
+ * Emit() appends the instructions computing the expression to the current
+ * basic block and returns the resulting value. Everything goes through
+ * irgen's builder, so operations on constants come back folded.
+ */
+
+llvm::Value *IntConstant::Emit() {
+    return llvm::ConstantInt::get(irgen->GetIntType(), value, true);
+}
+
+llvm::Value *FloatConstant::Emit() {
+    return llvm::ConstantFP::get(irgen->GetFloatType(), value);
+}
+
+llvm::Value *BoolConstant::Emit() {
+    return llvm::ConstantInt::get(irgen->GetBoolType(), value);
+}
+
+llvm::Value *VarExpr::EmitAddress() {
+    ConstValue *folded = decl->GetConstValue();
+    if (folded != NULL && !dynamic_cast<ArrayType*>(type))
+        return NULL;   // folded into its uses, there is no storage
+    if (irgen->IsLocal(decl))
+        return NULL;   // a register
+
+    Symbol *sym = symtab->find(id->GetName());
+    Assert(sym != NULL);
+    if (sym->value == NULL)
+        return decl->EmitShared();   // a global of the shared scope
+    return sym->value;
+}
+
+llvm::Value *VarExpr::Emit() {
+    ConstValue *folded = decl->GetConstValue();
+    if (folded != NULL && !dynamic_cast<ArrayType*>(type))
+        return irgen->GetConstant(folded);
+    if (irgen->IsLocal(decl))
+        return irgen->ReadLocal(decl, irgen->GetType(type));
+    return irgen->GetBuilder()->CreateLoad(irgen->GetType(type), EmitAddress(), id->GetName());
+}
+
+void VarExpr::EmitStore(llvm::Value *value) {
+    if (irgen->IsLocal(decl))
+        irgen->WriteLocal(decl, value);
+    else
+        irgen->GetBuilder()->CreateStore(value, EmitAddress());
+}
+
+// '+', '-', '*' or '/' for an arithmetic, compound assignment,
+// increment or decrement operator
+static char ArithmeticOp(Operator *op) {
+    if (op->IsOp("+") || op->IsOp("+=") || op->IsOp("++")) return '+';
+    if (op->IsOp("-") || op->IsOp("-=") || op->IsOp("--")) return '-';
+    if (op->IsOp("*") || op->IsOp("*=")) return '*';
+    return '/';
+}
+
+static llvm::Value *EmitBinary(char op, llvm::Value *l, llvm::Value *r, Type *scalar) {
+    typedef llvm::Instruction I;
+    bool isFloat = scalar == Type::floatType, isUint = scalar == Type::uintType;
+    I::BinaryOps opcode;
+    switch (op) {
+      case '+': opcode = isFloat ? I::FAdd : I::Add; break;
+      case '-': opcode = isFloat ? I::FSub : I::Sub; break;
+      case '*': opcode = isFloat ? I::FMul : I::Mul; break;
+      default:  opcode = isFloat ? I::FDiv : isUint ? I::UDiv : I::SDiv; break;
+    }
+    return Node::irgen->GetBuilder()->CreateBinOp(opcode, l, r);
+}
+
+// element i of an array, or stored vector i of a matrix
+static llvm::Value *Element(llvm::Value *a, int i) {
+    return Node::irgen->GetBuilder()->CreateExtractValue(a, i);
+}
+
+static llvm::Value *Component(llvm::Value *v, int i) {
+    return Node::irgen->GetBuilder()->CreateExtractElement(v, (uint64_t)i);
+}
+
+/* Matrix layout
+ * -------------
+ * A matN value is an array of N stored vectors: its columns, or its rows
+ * when IRGenerator::IsRowMajor(). Component-wise operations don't care
+ * which; indexing, constructors and products go through the helpers below.
+ */
+
+static llvm::Value *Insert(llvm::Value *v, llvm::Value *elem, int i) {
+    return Node::irgen->GetBuilder()->CreateInsertElement(v, elem, (uint64_t)i);
+}
+
+// component (row r, column c) of a matrix stored by rows or by columns
+static llvm::Value *MatrixElement(llvm::Value *m, bool rows, int r, int c) {
+    return rows ? Component(Element(m, r), c) : Component(Element(m, c), r);
+}
+
+// an array or matrix value copied to the stack, for indices only known
+// at run time
+static llvm::Value *Spill(llvm::Value *aggregate) {
+    llvm::Value *tmp = Node::irgen->CreateEntryAlloca(aggregate->getType());
+    Node::irgen->GetBuilder()->CreateStore(aggregate, tmp);
+    return tmp;
+}
+
+// address of element i of the array or matrix of type ty at addr
+static llvm::Value *ElementAddress(llvm::Type *ty, llvm::Value *addr, llvm::Value *i) {
+    IRGenerator *irgen = Node::irgen;
+    llvm::Value *indices[] = { llvm::ConstantInt::get(irgen->GetIntType(), 0), i };
+    return irgen->GetBuilder()->CreateInBoundsGEP(ty, addr, indices);
+}
+
+// column c of a matrix, c may be a runtime value
+static llvm::Value *MatrixColumn(llvm::Value *m, llvm::Value *c, int n, bool rows) {
+    IRGenerator::Builder *builder = Node::irgen->GetBuilder();
+    llvm::Type *colTy = llvm::FixedVectorType::get(Node::irgen->GetFloatType(), n);
+    if (!rows) {
+        if (llvm::ConstantInt *index = llvm::dyn_cast<llvm::ConstantInt>(c))
+            return builder->CreateExtractValue(m, index->getZExtValue());
+        return builder->CreateLoad(colTy, ElementAddress(m->getType(), Spill(m), c));
+    }
+    llvm::Value *col = llvm::UndefValue::get(colTy);
+    for (int r = 0; r < n; r++)
+        col = Insert(col, builder->CreateExtractElement(Element(m, r), c), r);
+    return col;
+}
+
+// m with column c replaced by col
+static llvm::Value *SetMatrixColumn(llvm::Value *m, llvm::Value *c, llvm::Value *col, int n, bool rows) {
+    IRGenerator::Builder *builder = Node::irgen->GetBuilder();
+    if (!rows) {
+        if (llvm::ConstantInt *index = llvm::dyn_cast<llvm::ConstantInt>(c))
+            return builder->CreateInsertValue(m, col, index->getZExtValue());
+        llvm::Value *tmp = Spill(m);
+        builder->CreateStore(col, ElementAddress(m->getType(), tmp, c));
+        return builder->CreateLoad(m->getType(), tmp);
+    }
+    for (int r = 0; r < n; r++) {
+        llvm::Value *row = builder->CreateInsertElement(Element(m, r), Component(col, r), c);
+        m = builder->CreateInsertValue(m, row, r);
+    }
+    return m;
+}
+
+// a matrix of the current layout from its columns
+static llvm::Value *MatrixFromColumns(std::vector<llvm::Value*> &cols, llvm::Type *ty) {
+    IRGenerator *irgen = Node::irgen;
+    int n = cols.size();
+    llvm::Value *m = llvm::UndefValue::get(ty);
+    for (int i = 0; i < n; i++) {
+        llvm::Value *v = cols[i];
+        if (irgen->IsRowMajor()) {
+            v = llvm::UndefValue::get(cols[0]->getType());
+            for (int c = 0; c < n; c++)
+                v = Insert(v, Component(cols[c], i), c);
+        }
+        m = irgen->GetBuilder()->CreateInsertValue(m, v, i);
+    }
+    return m;
+}
+
+/* Matrix kernels
+ * --------------
+ * Products are written in terms of the stored vectors of each operand and
+ * whether those are rows or columns, so a transpose() operand only flips
+ * that flag and is never materialized. Accumulations use llvm.fmuladd,
+ * which becomes an FMA on targets that have one.
+ */
+
+static llvm::Value *MulAdd(llvm::Value *a, llvm::Value *b, llvm::Value *c) {
+    IRGenerator *irgen = Node::irgen;
+    llvm::Module *module = irgen->GetOrCreateModule("glc.bc");
+    llvm::Function *f = llvm::Intrinsic::getDeclaration(module, llvm::Intrinsic::fmuladd, a->getType());
+    llvm::Value *args[] = { a, b, c };
+    return irgen->GetBuilder()->CreateCall(f, args);
+}
+
+static llvm::Value *HorizontalDot(llvm::Value *a, llvm::Value *b, int n) {
+    llvm::Value *p = EmitBinary('*', a, b, Type::floatType);
+    llvm::Value *sum = Component(p, 0);
+    for (int i = 1; i < n; i++)
+        sum = EmitBinary('+', sum, Component(p, i), Type::floatType);
+    return sum;
+}
+
+// m * v. By columns that is the columns weighted by v's components, one
+// broadcast and one FMA per column; by rows it is a dot product per row.
+static llvm::Value *MatVec(llvm::Value *m, bool rows, llvm::Value *v, int n) {
+    IRGenerator *irgen = Node::irgen;
+    if (!rows) {
+        llvm::Value *acc = EmitBinary('*', Element(m, 0), irgen->Splat(Component(v, 0), n), Type::floatType);
+        for (int c = 1; c < n; c++)
+            acc = MulAdd(Element(m, c), irgen->Splat(Component(v, c), n), acc);
+        return acc;
+    }
+    llvm::Value *result = llvm::UndefValue::get(v->getType());
+    for (int r = 0; r < n; r++)
+        result = Insert(result, HorizontalDot(Element(m, r), v, n), r);
+    return result;
+}
+
+// a * b, stored in the current layout. Result columns are computed two at
+// a time so each column of a feeds both accumulators while it is live.
+static llvm::Value *MatMat(llvm::Value *a, bool aRows, llvm::Value *b, bool bRows, int n) {
+    IRGenerator *irgen = Node::irgen;
+    llvm::Type *ty = a->getType();
+    // (ab) by rows is (b^T a^T) by columns
+    if (irgen->IsRowMajor()) {
+        irgen->SetRowMajor(false);
+        llvm::Value *t = MatMat(b, !bRows, a, !aRows, n);
+        irgen->SetRowMajor(true);
+        return t;
+    }
+
+    std::vector<llvm::Value*> cols(n);
+    if (aRows) {
+        for (int j = 0; j < n; j++) {
+            llvm::Value *index = llvm::ConstantInt::get(irgen->GetIntType(), j);
+            cols[j] = MatVec(a, true, MatrixColumn(b, index, n, bRows), n);
+        }
+    }
+    else {
+        const int block = 2;
+        for (int j0 = 0; j0 < n; j0 += block) {
+            for (int k = 0; k < n; k++) {
+                llvm::Value *ak = Element(a, k);
+                for (int j = j0; j < j0 + block && j < n; j++) {
+                    llvm::Value *bkj = irgen->Splat(MatrixElement(b, bRows, k, j), n);
+                    cols[j] = k ? MulAdd(ak, bkj, cols[j]) : EmitBinary('*', ak, bkj, Type::floatType);
+                }
+            }
+        }
+    }
+    llvm::Value *m = llvm::UndefValue::get(ty);
+    for (int j = 0; j < n; j++)
+        m = irgen->GetBuilder()->CreateInsertValue(m, cols[j], j);
+    return m;
+}
+
+// matrix * vector, vector * matrix or matrix * matrix; lRows and rRows
+// tell how each matrix operand is stored
+static llvm::Value *EmitMatrixProduct(llvm::Value *l, Type *lt, bool lRows,
+                                      llvm::Value *r, Type *rt, bool rRows) {
+    int n = lt->GetVectorSize();
+    if (lt->IsVector())
+        return MatVec(r, !rRows, l, n);    // v * m is m^T * v
+    if (rt->IsVector())
+        return MatVec(l, lRows, r, n);
+    return MatMat(l, lRows, r, rRows, n);
+}
+
+static bool IsLinearProduct(char op, Type *lt, Type *rt) {
+    return op == '*' && ((lt->IsMatrix() && !rt->GetScalarType()->IsEquivalentTo(rt)) ||
+                         (rt->IsMatrix() && !lt->GetScalarType()->IsEquivalentTo(lt)));
+}
+
+// "l op r" for + - * / on emitted operands. Vector operations are single
+// vector instructions, a scalar operand is splatted to the vector size and
+// matrices are handled column by column.
+static llvm::Value *EmitArithmetic(Operator *op, llvm::Value *l, Type *lt, llvm::Value *r, Type *rt) {
+    IRGenerator *irgen = Node::irgen;
+    char c = ArithmeticOp(op);
+    if (IsLinearProduct(c, lt, rt))
+        return EmitMatrixProduct(l, lt, irgen->IsRowMajor(), r, rt, irgen->IsRowMajor());
+
+    Type *result = ArithmeticExpr::ResultType(op, lt, rt);
+    int n = result->GetVectorSize();
+    if (result->IsMatrix()) {
+        Type *colType = Type::GetVectorType(Type::floatType, n);
+        llvm::Value *m = llvm::UndefValue::get(irgen->GetType(result));
+        for (int i = 0; i < n; i++) {
+            llvm::Value *lc = lt->IsMatrix() ? Element(l, i) : l;
+            llvm::Value *rc = rt->IsMatrix() ? Element(r, i) : r;
+            llvm::Value *col = EmitArithmetic(op, lc, lt->IsMatrix() ? colType : lt,
+                                              rc, rt->IsMatrix() ? colType : rt);
+            m = irgen->GetBuilder()->CreateInsertValue(m, col, i);
+        }
+        return m;
+    }
+    if (result->IsVector()) {
+        if (!lt->IsVector()) l = irgen->Splat(l, n);
+        if (!rt->IsVector()) r = irgen->Splat(r, n);
+    }
+    return EmitBinary(c, l, r, result->GetScalarType());
+}
+
+static llvm::Value *EmitNegate(llvm::Value *v, Type *t) {
+    IRGenerator *irgen = Node::irgen;
+    if (t->IsMatrix()) {
+        llvm::Value *m = llvm::UndefValue::get(v->getType());
+        Type *colType = Type::GetVectorType(Type::floatType, t->GetVectorSize());
+        for (int i = 0; i < t->GetVectorSize(); i++)
+            m = irgen->GetBuilder()->CreateInsertValue(m, EmitNegate(Element(v, i), colType), i);
+        return m;
+    }
+    if (t->GetScalarType() == Type::floatType)
+        return irgen->GetBuilder()->CreateFNeg(v);
+    return irgen->GetBuilder()->CreateNeg(v);
+}
+
+static llvm::Value *ScalarOne(Type *t) {
+    IRGenerator *irgen = Node::irgen;
+    if (t->GetScalarType() == Type::floatType)
+        return llvm::ConstantFP::get(irgen->GetFloatType(), 1.0);
+    return llvm::ConstantInt::get(irgen->GetIntType(), 1);
+}
+
+// the matrix under a call of the transpose() built-in, or NULL
+static Expr *TransposedMatrix(Expr *e) {
+    Call *call = dynamic_cast<Call*>(e);
+    if (call == NULL || call->GetDecl() == NULL || !call->GetDecl()->IsBuiltin() ||
+        strcmp(call->GetDecl()->GetIdentifier()->GetName(), "transpose") != 0)
+        return NULL;
+    return call->GetActuals()->Nth(0);
+}
+
+llvm::Value *ArithmeticExpr::Emit() {
+    if (left != NULL && IsLinearProduct(ArithmeticOp(op), left->GetType(), right->GetType())) {
+        // a transposed operand is the same stored vectors read the other way
+        bool rows = irgen->IsRowMajor();
+        Expr *lt = TransposedMatrix(left), *rt = TransposedMatrix(right);
+        llvm::Value *l = (lt ? lt : left)->Emit();
+        llvm::Value *r = (rt ? rt : right)->Emit();
+        return EmitMatrixProduct(l, left->GetType(), rows != (lt != NULL),
+                                 r, right->GetType(), rows != (rt != NULL));
+    }
+    if (left != NULL) {
+        llvm::Value *l = left->Emit();
+        llvm::Value *r = right->Emit();
+        return EmitArithmetic(op, l, left->GetType(), r, right->GetType());
+    }
+
+    if (op->IsOp("+"))
+        return right->Emit();
+    if (op->IsOp("-"))
+        return EmitNegate(right->Emit(), type);
+
+    // prefix ++ and -- store and yield the new value
+    right->Pin();
+    llvm::Value *v = right->Emit();
+    llvm::Value *result = EmitArithmetic(op, v, type, ScalarOne(type), type->GetScalarType());
+    right->EmitStore(result);
+    right->Unpin();
+    return result;
+}
+
+llvm::Value *RelationalExpr::Emit() {
+    llvm::Value *l = left->Emit();
+    llvm::Value *r = right->Emit();
+    Type *t = left->GetType();
+    int which = op->IsOp("<") ? 0 : op->IsOp(">") ? 1 : op->IsOp("<=") ? 2 : 3;
+
+    static const llvm::CmpInst::Predicate fpreds[] = {
+        llvm::CmpInst::FCMP_OLT, llvm::CmpInst::FCMP_OGT, llvm::CmpInst::FCMP_OLE, llvm::CmpInst::FCMP_OGE };
+    static const llvm::CmpInst::Predicate spreds[] = {
+        llvm::CmpInst::ICMP_SLT, llvm::CmpInst::ICMP_SGT, llvm::CmpInst::ICMP_SLE, llvm::CmpInst::ICMP_SGE };
+    static const llvm::CmpInst::Predicate upreds[] = {
+        llvm::CmpInst::ICMP_ULT, llvm::CmpInst::ICMP_UGT, llvm::CmpInst::ICMP_ULE, llvm::CmpInst::ICMP_UGE };
+
+    if (t == Type::floatType)
+        return irgen->GetBuilder()->CreateFCmp(fpreds[which], l, r);
+    return irgen->GetBuilder()->CreateICmp(t == Type::uintType ? upreds[which] : spreds[which], l, r);
+}
+
+// true if every component of l and r is equal
+static llvm::Value *EmitEquals(llvm::Value *l, llvm::Value *r, Type *t) {
+    IRGenerator *irgen = Node::irgen;
+    IRGenerator::Builder *builder = irgen->GetBuilder();
+    ArrayType *arr = dynamic_cast<ArrayType*>(t);
+    if (arr != NULL || t->IsMatrix()) {
+        int n = arr ? arr->GetElemCount() : t->GetVectorSize();
+        Type *elemType = arr ? arr->GetElemType() : Type::GetVectorType(Type::floatType, n);
+        llvm::Value *all = NULL;
+        for (int i = 0; i < n; i++) {
+            llvm::Value *e = EmitEquals(Element(l, i), Element(r, i), elemType);
+            all = all ? builder->CreateAnd(all, e) : e;
+        }
+        return all;
+    }
+
+    llvm::Value *eq;
+    if (t->GetScalarType() == Type::floatType)
+        eq = builder->CreateFCmpOEQ(l, r);
+    else
+        eq = builder->CreateICmpEQ(l, r);
+    if (!t->IsVector())
+        return eq;
+
+    // all lanes true: the <N x i1> mask as an iN is all ones
+    llvm::Type *maskTy = llvm::IntegerType::get(*irgen->GetContext(), t->GetVectorSize());
+    llvm::Value *mask = builder->CreateBitCast(eq, maskTy);
+    return builder->CreateICmpEQ(mask, llvm::Constant::getAllOnesValue(maskTy));
+}
+
+llvm::Value *EqualityExpr::Emit() {
+    llvm::Value *l = left->Emit();
+    llvm::Value *r = right->Emit();
+    llvm::Value *eq = EmitEquals(l, r, left->GetType());
+    if (op->IsOp("=="))
+        return eq;
+    return irgen->GetBuilder()->CreateNot(eq);
+}
+
+// the most work an operand of ?:, && or || may cost to be evaluated
+// whether or not it is needed, so the result is a select with no branch
+static const int SelectCostLimit = 8;
+
+llvm::Value *LogicalExpr::Emit() {
+    IRGenerator::Builder *builder = irgen->GetBuilder();
+    if (left == NULL) {
+        llvm::Value *v = right->Emit();
+        return builder->CreateNot(v);
+    }
+
+    // a || b is a ? true : b, a && b is a ? b : false; bvecs have no
+    // short circuit, and a cheap scalar right operand is evaluated anyway
+    bool isOr = op->IsOp("||");
+    int cost = right->SpeculationCost();
+    if (type->IsVector() || (cost != Unspeculatable && cost <= SelectCostLimit)) {
+        llvm::Value *l = left->Emit();
+        llvm::Value *r = right->Emit();
+        llvm::Type *ty = l->getType();
+        if (isOr)
+            return builder->CreateSelect(l, llvm::Constant::getAllOnesValue(ty), r);
+        return builder->CreateSelect(l, r, llvm::Constant::getNullValue(ty));
+    }
+
+    // otherwise the right operand is only evaluated when it decides the result
+    llvm::LLVMContext *context = irgen->GetContext();
+    llvm::Function *f = irgen->GetFunction();
+    llvm::Value *l = left->Emit();
+    llvm::BasicBlock *lhsEnd = irgen->GetBasicBlock();
+    llvm::BasicBlock *rhsBB = llvm::BasicBlock::Create(*context, isOr ? "or.rhs" : "and.rhs", f);
+    llvm::BasicBlock *endBB = llvm::BasicBlock::Create(*context, isOr ? "or.end" : "and.end", f);
+    if (isOr)
+        builder->CreateCondBr(l, endBB, rhsBB);
+    else
+        builder->CreateCondBr(l, rhsBB, endBB);
+    irgen->SealBlock(rhsBB);
+
+    irgen->SetBasicBlock(rhsBB);
+    llvm::Value *r = right->Emit();
+    llvm::BasicBlock *rhsEnd = irgen->GetBasicBlock();
+    builder->CreateBr(endBB);
+    irgen->SealBlock(endBB);
+
+    irgen->SetBasicBlock(endBB);
+    llvm::PHINode *phi = builder->CreatePHI(irgen->GetBoolType(), 2);
+    phi->addIncoming(llvm::ConstantInt::get(irgen->GetBoolType(), isOr), lhsEnd);
+    phi->addIncoming(r, rhsEnd);
+    return phi;
+}
+
+llvm::Value *ConditionalExpr::Emit() {
+    IRGenerator::Builder *builder = irgen->GetBuilder();
+
+    // a bvec condition selects per component, and cheap arms that can't
+    // be observed are both evaluated and selected between
+    int tCost = trueExpr->SpeculationCost(), fCost = falseExpr->SpeculationCost();
+    bool cheap = tCost != Unspeculatable && fCost != Unspeculatable && tCost + fCost <= SelectCostLimit;
+    if (cond->GetType()->IsVector() || cheap) {
+        llvm::Value *test = cond->Emit();
+        llvm::Value *t = trueExpr->Emit();
+        llvm::Value *e = falseExpr->Emit();
+        return builder->CreateSelect(test, t, e);
+    }
+
+    llvm::LLVMContext *context = irgen->GetContext();
+    llvm::Function *f = irgen->GetFunction();
+    llvm::BasicBlock *trueBB = llvm::BasicBlock::Create(*context, "cond.true", f);
+    llvm::BasicBlock *falseBB = llvm::BasicBlock::Create(*context, "cond.false", f);
+    llvm::BasicBlock *endBB = llvm::BasicBlock::Create(*context, "cond.end", f);
+    llvm::Value *test = cond->Emit();
+    builder->CreateCondBr(test, trueBB, falseBB);
+    irgen->SealBlock(trueBB);
+    irgen->SealBlock(falseBB);
+
+    irgen->SetBasicBlock(trueBB);
+    llvm::Value *t = trueExpr->Emit();
+    llvm::BasicBlock *trueEnd = irgen->GetBasicBlock();
+    builder->CreateBr(endBB);
+
+    irgen->SetBasicBlock(falseBB);
+    llvm::Value *e = falseExpr->Emit();
+    llvm::BasicBlock *falseEnd = irgen->GetBasicBlock();
+    builder->CreateBr(endBB);
+    irgen->SealBlock(endBB);
+
+    irgen->SetBasicBlock(endBB);
+    llvm::PHINode *phi = builder->CreatePHI(t->getType(), 2);
+    phi->addIncoming(t, trueEnd);
+    phi->addIncoming(e, falseEnd);
+    return phi;
+}
+
+llvm::Value *Expr::EmitAs(Type *t) {
+    llvm::Value *v = Emit();
+    if (type->IsEquivalentTo(t))
+        return v;
+    return irgen->Convert(v, type, t);
+}
+
+llvm::Value *AssignExpr::Emit() {
+    llvm::Value *value;
+    if (op->IsOp("=")) {
+        value = right->EmitAs(left->GetType());
+        left->EmitStore(value);
+        return value;
+    }
+    left->Pin();
+    llvm::Value *l = left->Emit();
+    llvm::Value *r = right->Emit();
+    value = EmitArithmetic(op, l, left->GetType(), r, right->GetType());
+    left->EmitStore(value);
+    left->Unpin();
+    return value;
+}
+
+llvm::Value *PostfixExpr::Emit() {
+    left->Pin();
+    llvm::Value *old = left->Emit();
+    left->EmitStore(EmitArithmetic(op, old, type, ScalarOne(type), type->GetScalarType()));
+    left->Unpin();
+    return old;
+}
+
+llvm::Value *ArrayAccess::EmitAddress() {
+    // a column of a matrix stored by rows isn't contiguous
+    Type *bType = base->GetType();
+    if (!dynamic_cast<ArrayType*>(bType) && !(bType->IsMatrix() && !irgen->IsRowMajor()))
+        return NULL;
+    llvm::Value *addr = base->EmitAddress();
+    if (addr == NULL)
+        return NULL;
+    return ElementAddress(irgen->GetType(bType), addr, EmitSubscript());
+}
+
+llvm::Value *ArrayAccess::Emit() {
+    if (llvm::Value *addr = EmitAddress())
+        return irgen->GetBuilder()->CreateLoad(irgen->GetType(type), addr);
+
+    llvm::Value *b = base->Emit();
+    llvm::Value *i = EmitSubscript();
+    IRGenerator::Builder *builder = irgen->GetBuilder();
+    if (base->GetType()->IsVector())
+        return builder->CreateExtractElement(b, i);
+    if (base->GetType()->IsMatrix() && irgen->IsRowMajor())
+        return MatrixColumn(b, i, base->GetType()->GetVectorSize(), true);
+
+    // an array or matrix that isn't in memory: a constant index extracts
+    // the element, any other index needs it spilled to the stack
+    if (llvm::ConstantInt *c = llvm::dyn_cast<llvm::ConstantInt>(i))
+        return builder->CreateExtractValue(b, c->getZExtValue());
+    return builder->CreateLoad(irgen->GetType(type), ElementAddress(b->getType(), Spill(b), i));
+}
+
+void ArrayAccess::EmitStore(llvm::Value *value) {
+    if (llvm::Value *addr = EmitAddress()) {
+        irgen->GetBuilder()->CreateStore(value, addr);
+        return;
+    }
+    // a vector component or a matrix column: insert it and store the
+    // whole value back
+    base->Pin();
+    llvm::Value *v = base->Emit();
+    llvm::Value *i = EmitSubscript();
+    if (base->GetType()->IsMatrix())
+        v = SetMatrixColumn(v, i, value, base->GetType()->GetVectorSize(), irgen->IsRowMajor());
+    else
+        v = irgen->GetBuilder()->CreateInsertElement(v, value, i);
+    base->EmitStore(v);
+    base->Unpin();
+}
+
+void ArrayAccess::Pin() {
+    if (pins++ > 0)
+        return;
+    base->Pin();
+    index = subscript->Emit();
+}
+
+void ArrayAccess::Unpin() {
+    if (--pins > 0)
+        return;
+    index = NULL;
+    base->Unpin();
+}
+
+Expr *FieldAccess::Collapse(std::vector<int> &mask) {
+    mask.assign(swizzle, swizzle + swizzleLen);
+    Expr *vec = base;
+    while (FieldAccess *inner = dynamic_cast<FieldAccess*>(vec)) {
+        for (size_t i = 0; i < mask.size(); i++)
+            mask[i] = inner->swizzle[mask[i]];
+        vec = inner->base;
+    }
+    return vec;
+}
+
+llvm::Value *FieldAccess::Emit() {
+    std::vector<int> mask;
+    Expr *vec = Collapse(mask);
+    llvm::Value *v = vec->Emit();
+    if (mask.size() == 1)
+        return Component(v, mask[0]);
+
+    bool identity = (int)mask.size() == vec->GetType()->GetVectorSize();
+    for (size_t i = 0; identity && i < mask.size(); i++)
+        identity = mask[i] == (int)i;
+    if (identity)
+        return v;
+    return irgen->GetBuilder()->CreateShuffleVector(v, mask);
+}
+
+// a write mask such as v.xz = w blends w into v with one shuffle: lane i
+// of the result is lane i of v unless the swizzle writes it
+void FieldAccess::EmitStore(llvm::Value *value) {
+    std::vector<int> mask;
+    Expr *vec = Collapse(mask);
+    vec->Pin();
+    llvm::Value *dest = vec->Emit();
+    IRGenerator::Builder *builder = irgen->GetBuilder();
+    int size = vec->GetType()->GetVectorSize();
+    if (mask.size() == 1) {
+        vec->EmitStore(builder->CreateInsertElement(dest, value, (uint64_t)mask[0]));
+        vec->Unpin();
+        return;
+    }
+
+    // both shuffle operands must have the size of the destination
+    llvm::Value *src = value;
+    if ((int)mask.size() != size) {
+        std::vector<int> widen(size, -1);
+        for (size_t j = 0; j < mask.size(); j++)
+            widen[j] = j;
+        src = builder->CreateShuffleVector(value, widen);
+    }
+    std::vector<int> blend(size);
+    for (int i = 0; i < size; i++)
+        blend[i] = i;
+    for (size_t j = 0; j < mask.size(); j++)
+        blend[mask[j]] = size + j;
+    vec->EmitStore(builder->CreateShuffleVector(dest, src, blend));
+    vec->Unpin();
+}
+
+llvm::Value *Call::Emit() {
+    List<VarDecl*> *formals = decl->GetFormals();
+    std::vector<llvm::Value*> args;
+    for (int i = 0; i < actuals->NumElements(); i++) {
+        Expr *actual = actuals->Nth(i);
+        Type *formalType = formals->Nth(i)->GetType();
+        args.push_back(actual->EmitAs(formalType));
+    }
+    if (decl->IsBuiltin())
+        return EmitBuiltin(decl, args);
+
+    llvm::Function *f = irgen->GetOrDeclareFunction(decl);
+    return irgen->GetBuilder()->CreateCall(f, args);
+}
+
+// appends the components of v, converted to scalar, to comps
+static void EmitComponents(llvm::Value *v, Type *t, Type *scalar, std::vector<llvm::Value*> &comps) {
+    IRGenerator *irgen = Node::irgen;
+    if (t->IsMatrix()) {
+        int n = t->GetVectorSize();
+        for (int c = 0; c < n; c++) {
+            llvm::Value *index = llvm::ConstantInt::get(irgen->GetIntType(), c);
+            EmitComponents(MatrixColumn(v, index, n, irgen->IsRowMajor()),
+                           Type::GetVectorType(Type::floatType, n), scalar, comps);
+        }
+        return;
+    }
+    if (!t->IsVector()) {
+        comps.push_back(irgen->Convert(v, t, scalar));
+        return;
+    }
+    for (int i = 0; i < t->GetVectorSize(); i++)
+        comps.push_back(irgen->Convert(Component(v, i), t->GetScalarType(), scalar));
+}
+
+// a vector of type t built from its first components in comps
+static llvm::Value *BuildVector(Type *t, std::vector<llvm::Value*> &comps, int first) {
+    IRGenerator *irgen = Node::irgen;
+    llvm::Value *v = llvm::UndefValue::get(irgen->GetType(t));
+    for (int i = 0; i < t->GetVectorSize(); i++)
+        v = irgen->GetBuilder()->CreateInsertElement(v, comps[first + i], (uint64_t)i);
+    return v;
+}
+
+llvm::Value *ConstructorExpr::Emit() {
+    if (ConstValue *folded = EvalConst())
+        return irgen->GetConstant(folded);
+
+    std::vector<llvm::Value*> values;
+    for (int i = 0; i < args->NumElements(); i++)
+        values.push_back(args->Nth(i)->Emit());
+    IRGenerator::Builder *builder = irgen->GetBuilder();
+
+    if (dynamic_cast<ArrayType*>(type)) {
+        llvm::Value *a = llvm::UndefValue::get(irgen->GetType(type));
+        for (size_t i = 0; i < values.size(); i++)
+            a = builder->CreateInsertValue(a, values[i], i);
+        return a;
+    }
+
+    Type *scalar = type->GetScalarType();
+    int size = type->GetVectorSize();
+    if (values.size() == 1) {
+        Type *argType = args->Nth(0)->GetType();
+        llvm::Value *v = values[0];
+        if (argType->IsEquivalentTo(type))
+            return v;
+        if (argType->IsVector() && argType->GetVectorSize() == size && type->IsVector())
+            return irgen->Convert(v, argType, type);
+        if (ComponentCount(argType) == 1) {
+            v = irgen->Convert(v, argType, scalar);
+            if (type->IsVector())
+                return irgen->Splat(v, size);
+            if (!type->IsMatrix())
+                return v;
+
+            // a scalar sets the diagonal of a matrix, the rest is zero
+            llvm::Value *m = llvm::UndefValue::get(irgen->GetType(type));
+            llvm::Value *zero = llvm::Constant::getNullValue(irgen->GetType(Type::GetVectorType(scalar, size)));
+            for (int c = 0; c < size; c++) {
+                llvm::Value *col = builder->CreateInsertElement(zero, v, (uint64_t)c);
+                m = builder->CreateInsertValue(m, col, c);
+            }
+            return m;
+        }
+    }
+
+    // otherwise components are consumed in order, extra ones are dropped
+    std::vector<llvm::Value*> comps;
+    for (size_t i = 0; i < values.size(); i++)
+        EmitComponents(values[i], args->Nth(i)->GetType(), scalar, comps);
+    if (type->IsVector())
+        return BuildVector(type, comps, 0);
+    if (!type->IsMatrix())
+        return comps[0];
+
+    std::vector<llvm::Value*> cols;
+    Type *colType = Type::GetVectorType(scalar, size);
+    for (int c = 0; c < size; c++)
+        cols.push_back(BuildVector(colType, comps, c * size));
+    return MatrixFromColumns(cols, irgen->GetType(type));
+}
+
+
+/* Speculation
+ * -----------
+ * ?: and && || evaluate an operand only when it decides the result. When
+ * the operand is cheap and can't be observed running, evaluating it
+ * anyway and picking the result with a select is faster than a branch and
+ * leaves the code straight-line for the vectorizers.
+ */
+
+// sum of two costs, Unspeculatable if either is
+static int AddCost(int a, int b) {
+    if (a == Expr::Unspeculatable || b == Expr::Unspeculatable)
+        return Expr::Unspeculatable;
+    return a + b;
+}
+
+int VarExpr::SpeculationCost() {
+    // a register or a constant is free, anything else is one load
+    if (irgen->IsLocal(decl) || (decl->GetConstValue() && !dynamic_cast<ArrayType*>(type)))
+        return 0;
+    return 1;
+}
+
+int ArithmeticExpr::SpeculationCost() {
+    if (left == NULL) {
+        if (op->IsOp("++") || op->IsOp("--"))
+            return Unspeculatable;
+        return AddCost(right->SpeculationCost(), 1);
+    }
+
+    // an integer division traps or is undefined on a zero or -1 divisor
+    Type *scalar = type->GetScalarType();
+    if (ArithmeticOp(op) == '/' && scalar != Type::floatType) {
+        ConstValue *divisor = right->EvalConst();
+        if (divisor == NULL)
+            return Unspeculatable;
+        for (size_t i = 0; i < divisor->comps.size(); i++)
+            if (divisor->comps[i] == 0 || (scalar == Type::intType && divisor->comps[i] == -1))
+                return Unspeculatable;
+    }
+
+    int n = type->GetVectorSize();
+    int work = 1;
+    if (IsLinearProduct(ArithmeticOp(op), left->GetType(), right->GetType()))
+        work = n * n;
+    else if (type->IsMatrix())
+        work = n;
+    return AddCost(AddCost(left->SpeculationCost(), right->SpeculationCost()), work);
+}
+
+int RelationalExpr::SpeculationCost() {
+    return AddCost(AddCost(left->SpeculationCost(), right->SpeculationCost()), 1);
+}
+
+int EqualityExpr::SpeculationCost() {
+    return AddCost(AddCost(left->SpeculationCost(), right->SpeculationCost()), 1);
+}
+
+int LogicalExpr::SpeculationCost() {
+    if (left == NULL)
+        return AddCost(right->SpeculationCost(), 1);
+    return AddCost(AddCost(left->SpeculationCost(), right->SpeculationCost()), 1);
+}
+
+int ConditionalExpr::SpeculationCost() {
+    int arms = AddCost(trueExpr->SpeculationCost(), falseExpr->SpeculationCost());
+    return AddCost(AddCost(cond->SpeculationCost(), arms), 1);
+}
+
+int ArrayAccess::SpeculationCost() {
+    // a runtime index into an array or matrix may be out of bounds, into a
+    // vector it only gives an undefined value
+    if (!base->GetType()->IsVector() && subscript->EvalConst() == NULL)
+        return Unspeculatable;
+    return AddCost(AddCost(base->SpeculationCost(), subscript->SpeculationCost()), 1);
+}
+
+int FieldAccess::SpeculationCost() {
+    if (base == NULL)
+        return Unspeculatable;
+    return AddCost(base->SpeculationCost(), 1);
+}
+
+int Call::SpeculationCost() {
+    // built-ins are pure, user functions are not looked into
+    static const int BuiltinCost = 4;
+    if (decl == NULL || !decl->IsBuiltin())
+        return Unspeculatable;
+    int cost = BuiltinCost;
+    for (int i = 0; i < actuals->NumElements(); i++)
+        cost = AddCost(cost, actuals->Nth(i)->SpeculationCost());
+    return cost;
+}
+
+int ConstructorExpr::SpeculationCost() {
+    int cost = 1;
+    for (int i = 0; i < args->NumElements(); i++)
+        cost = AddCost(cost, args->Nth(i)->SpeculationCost());
+    return cost;
+}
@@ -17,14 +17,65 @@
 #include "ast_stmt.h"
 #include "list.h"
 #include "ast_type.h"
+#include <vector>
 
 void yyerror(const char *msg);
 
+class VarDecl;
+
+/* The value of a constant expression, computed at compile time. Scalars,
+ * vectors and matrices keep their components in comps (matrices column
+ * by column, ints and bools stored exactly); arrays keep one value per
+ * element in elems. */
+struct ConstValue {
+    Type *type;
+    std::vector<double> comps;
+    std::vector<ConstValue *> elems;
+
+    ConstValue(Type *t) : type(t) {}
+};
+
+// v as a value of type to, a type v's converts to implicitly
+ConstValue *ConvertConst(ConstValue *v, Type *to);
+
 class Expr : public Stmt 
 {
+  protected:
+    Type *type;   // resolved by Check(), NULL until then
+
+    // subclasses check their children and return their own type,
+    // Check() calls this exactly once and caches the answer
+    virtual Type *CheckType() = 0;
+
   public:
-    Expr(yyltype loc) : Stmt(loc) {}
-    Expr() : Stmt() {}
+    Expr(yyltype loc) : Stmt(loc), type(NULL) {}
+    Expr() : Stmt(), type(NULL) {}
+
+    void Check() { if (type == NULL) type = CheckType(); }
+    Type *GetType() const { return type; }
+
+    // folds a checked expression made only of literals, const variables,
+    // constructors and operators; NULL if it isn't constant
+    virtual ConstValue *EvalConst() { return NULL; }
+
+    // the value converted to t, a type this one converts to implicitly
+    llvm::Value *EmitAs(Type *t);
+
+    // lvalues: the address of the storage the expression names, NULL when
+    // it isn't in memory, and a store of a new value into it
+    virtual llvm::Value *EmitAddress() { return NULL; }
+    virtual void EmitStore(llvm::Value *value) {}
+    // evaluates the subscripts an lvalue goes through, which its Emit,
+    // EmitAddress and EmitStore then reuse until Unpin(), so reading and
+    // writing it back (a[i++] += 1.0) picks one element; pins nest
+    virtual void Pin() {}
+    virtual void Unpin() {}
+
+    // rough instruction count of evaluating the expression even where
+    // control wouldn't reach it, or Unspeculatable if it writes, calls
+    // user code or may trap
+    static const int Unspeculatable = -1;
+    virtual int SpeculationCost() { return Unspeculatable; }
 
     friend std::ostream& operator<< (std::ostream& stream, Expr * expr) {
         return stream << expr->GetPrintNameForNode();
@@ -36,6 +87,7 @@ class ExprError : public Expr
   public:
     ExprError() : Expr() { yyerror(this->GetPrintNameForNode()); }
     const char *GetPrintNameForNode() { return "ExprError"; }
+    Type *CheckType() { return Type::errorType; }
 };
 
 /* This node type is used for those places where an expression is optional.
@@ -45,6 +97,7 @@ class EmptyExpr : public Expr
 {
   public:
     const char *GetPrintNameForNode() { return "Empty"; }
+    Type *CheckType() { return Type::voidType; }
 };
 
 class IntConstant : public Expr 
@@ -56,6 +109,10 @@ class IntConstant : public Expr
     IntConstant(yyltype loc, int val);
     const char *GetPrintNameForNode() { return "IntConstant"; }
     void PrintChildren(int indentLevel);
+    ConstValue *EvalConst();
+    llvm::Value *Emit();
+    int SpeculationCost() { return 0; }
+    Type *CheckType() { return Type::intType; }
 };
 
 class FloatConstant: public Expr 
@@ -67,6 +124,10 @@ class FloatConstant: public Expr
     FloatConstant(yyltype loc, double val);
     const char *GetPrintNameForNode() { return "FloatConstant"; }
     void PrintChildren(int indentLevel);
+    ConstValue *EvalConst();
+    llvm::Value *Emit();
+    int SpeculationCost() { return 0; }
+    Type *CheckType() { return Type::floatType; }
 };
 
 class BoolConstant : public Expr 
@@ -78,18 +139,30 @@ class BoolConstant : public Expr
     BoolConstant(yyltype loc, bool val);
     const char *GetPrintNameForNode() { return "BoolConstant"; }
     void PrintChildren(int indentLevel);
+    ConstValue *EvalConst();
+    llvm::Value *Emit();
+    int SpeculationCost() { return 0; }
+    Type *CheckType() { return Type::boolType; }
 };
 
 class VarExpr : public Expr
 {
   protected:
     Identifier *id;
+    VarDecl *decl;   // the declaration Check() found for id
 
   public:
     VarExpr(yyltype loc, Identifier *id);
     const char *GetPrintNameForNode() { return "VarExpr"; }
     void PrintChildren(int indentLevel);
     Identifier *GetIdentifier() {return id;}
+    VarDecl *GetDecl() {return decl;}
+    Type *CheckType();
+    ConstValue *EvalConst();
+    llvm::Value *Emit();
+    int SpeculationCost();
+    llvm::Value *EmitAddress();
+    void EmitStore(llvm::Value *value);
 };
 
 class Operator : public Node 
@@ -116,14 +189,26 @@ class CompoundExpr : public Expr
     CompoundExpr(Operator *op, Expr *rhs);             // for unary
     CompoundExpr(Expr *lhs, Operator *op);             // for unary
     void PrintChildren(int indentLevel);
+
+    // checks both operands, returns true if either one is already in error
+    // so the caller can propagate errorType without reporting again
+    bool CheckOperands();
 };
 
 class ArithmeticExpr : public CompoundExpr 
 {
   public:
+    // result type of "lhs op rhs" for + - * /, or errorType if the
+    // operands don't combine; shared with the compound assignments
+    static Type *ResultType(Operator *op, Type *lhs, Type *rhs);
+
     ArithmeticExpr(Expr *lhs, Operator *op, Expr *rhs) : CompoundExpr(lhs,op,rhs) {}
     ArithmeticExpr(Operator *op, Expr *rhs) : CompoundExpr(op,rhs) {}
     const char *GetPrintNameForNode() { return "ArithmeticExpr"; }
+    Type *CheckType();
+    ConstValue *EvalConst();
+    llvm::Value *Emit();
+    int SpeculationCost();
 };
 
 class RelationalExpr : public CompoundExpr 
@@ -131,6 +216,10 @@ class RelationalExpr : public CompoundExpr
   public:
     RelationalExpr(Expr *lhs, Operator *op, Expr *rhs) : CompoundExpr(lhs,op,rhs) {}
     const char *GetPrintNameForNode() { return "RelationalExpr"; }
+    Type *CheckType();
+    ConstValue *EvalConst();
+    llvm::Value *Emit();
+    int SpeculationCost();
 };
 
 class EqualityExpr : public CompoundExpr 
@@ -138,6 +227,10 @@ class EqualityExpr : public CompoundExpr
   public:
     EqualityExpr(Expr *lhs, Operator *op, Expr *rhs) : CompoundExpr(lhs,op,rhs) {}
     const char *GetPrintNameForNode() { return "EqualityExpr"; }
+    Type *CheckType();
+    ConstValue *EvalConst();
+    llvm::Value *Emit();
+    int SpeculationCost();
 };
 
 class LogicalExpr : public CompoundExpr 
@@ -146,6 +239,10 @@ class LogicalExpr : public CompoundExpr
     LogicalExpr(Expr *lhs, Operator *op, Expr *rhs) : CompoundExpr(lhs,op,rhs) {}
     LogicalExpr(Operator *op, Expr *rhs) : CompoundExpr(op,rhs) {}
     const char *GetPrintNameForNode() { return "LogicalExpr"; }
+    Type *CheckType();
+    ConstValue *EvalConst();
+    llvm::Value *Emit();
+    int SpeculationCost();
 };
 
 class AssignExpr : public CompoundExpr 
@@ -153,6 +250,8 @@ class AssignExpr : public CompoundExpr
   public:
     AssignExpr(Expr *lhs, Operator *op, Expr *rhs) : CompoundExpr(lhs,op,rhs) {}
     const char *GetPrintNameForNode() { return "AssignExpr"; }
+    Type *CheckType();
+    llvm::Value *Emit();
 };
 
 class PostfixExpr : public CompoundExpr
@@ -160,7 +259,8 @@ class PostfixExpr : public CompoundExpr
   public:
     PostfixExpr(Expr *lhs, Operator *op) : CompoundExpr(lhs,op) {}
     const char *GetPrintNameForNode() { return "PostfixExpr"; }
-
+    Type *CheckType();
+    llvm::Value *Emit();
 };
 
 class ConditionalExpr : public Expr
@@ -171,6 +271,10 @@ class ConditionalExpr : public Expr
     ConditionalExpr(Expr *c, Expr *t, Expr *f);
     void PrintChildren(int indentLevel);
     const char *GetPrintNameForNode() { return "ConditionalExpr"; }
+    Type *CheckType();
+    ConstValue *EvalConst();
+    llvm::Value *Emit();
+    int SpeculationCost();
 };
 
 class LValue : public Expr 
@@ -183,10 +287,23 @@ class ArrayAccess : public LValue
 {
   protected:
     Expr *base, *subscript;
+    llvm::Value *index;   // the subscript's value while pinned
+    int pins;
+
+    llvm::Value *EmitSubscript() { return index ? index : subscript->Emit(); }
     
   public:
     ArrayAccess(yyltype loc, Expr *base, Expr *subscript);
     const char *GetPrintNameForNode() { return "ArrayAccess"; }
+    Expr *GetBase() const { return base; }
+    Type *CheckType();
+    ConstValue *EvalConst();
+    llvm::Value *Emit();
+    int SpeculationCost();
+    llvm::Value *EmitAddress();
+    void EmitStore(llvm::Value *value);
+    void Pin();
+    void Unpin();
     void PrintChildren(int indentLevel);
 };
 
@@ -200,11 +317,29 @@ class FieldAccess : public LValue
   protected:
     Expr *base;	// will be NULL if no explicit base
     Identifier *field;
+    int swizzle[4];     // component selected by each position, set by Check()
+    int swizzleLen;
+
+    // the vector under a chain of swizzles, mask gets the components of
+    // it this one selects, so v.zyx.yx reads v with mask {1, 2}
+    Expr *Collapse(std::vector<int> &mask);
     
   public:
     FieldAccess(Expr *base, Identifier *field); //ok to pass NULL base
     const char *GetPrintNameForNode() { return "FieldAccess"; }
+    Expr *GetBase() const { return base; }
+    Identifier *GetField() const { return field; }
+    // whether the swizzle selects a component twice, so it can be read
+    // but not assigned (v.xx)
+    bool RepeatsComponent() const;
+    Type *CheckType();
+    ConstValue *EvalConst();
     void PrintChildren(int indentLevel);
+    llvm::Value *Emit();
+    int SpeculationCost();
+    void EmitStore(llvm::Value *value);
+    void Pin() { if (base) base->Pin(); }
+    void Unpin() { if (base) base->Unpin(); }
 };
 
 /* Like field access, call is used both for qualified base.field()
@@ -217,12 +352,37 @@ class Call : public Expr
     Expr *base;	// will be NULL if no explicit base
     Identifier *field;
     List<Expr*> *actuals;
+    FnDecl *decl;   // the overload picked by Check()
     
   public:
-    Call() : Expr(), base(NULL), field(NULL), actuals(NULL) {}
+    Call() : Expr(), base(NULL), field(NULL), actuals(NULL), decl(NULL) {}
     Call(yyltype loc, Expr *base, Identifier *field, List<Expr*> *args);
     const char *GetPrintNameForNode() { return "Call"; }
+    Type *CheckType();
+    FnDecl *GetDecl() const { return decl; }
+    List<Expr*> *GetActuals() const { return actuals; }
+    llvm::Value *Emit();
+    int SpeculationCost();
+    void PrintChildren(int indentLevel);
+};
+
+/* Constructors of the built-in types, vec3(1.0, 0.0, 0.0) or
+ * float[3](1.0, 2.0, 3.0), including the array constructors. */
+class ConstructorExpr : public Expr
+{
+  protected:
+    Type *ctorType;
+    List<Expr*> *args;
+
+  public:
+    ConstructorExpr(yyltype loc, Type *type, List<Expr*> *args);
+    const char *GetPrintNameForNode() { return "ConstructorExpr"; }
     void PrintChildren(int indentLevel);
+    Type *CheckType();
+    ConstValue *EvalConst();
+    llvm::Value *Emit();
+    int SpeculationCost();
+    List<Expr*> *GetArgs() const { return args; }
 };
 
 class ActualsError : public Call
@@ -2,15 +2,17 @@
  * -----------------
  * Implementation of statement node classes.
  */
+#include <stdint.h>
+#include <string.h>
+#include <set>
 #include "ast_stmt.h"
 #include "ast_type.h"
 #include "ast_decl.h"
 #include "ast_expr.h"
 #include "symtable.h"
+#include "builtins.h"
 
 #include "irgen.h"
-#include "llvm/Bitcode/ReaderWriter.h"
-#include "llvm/Support/raw_ostream.h"                                                   
 
 
 Program::Program(List<Decl*> *d) {
@@ -23,42 +25,11 @@ void Program::PrintChildren(int indentLevel) {
     printf("\n");
 }
 
-void Program::Emit() {
-    // TODO:
-    // This is just a reference for you to get started
-    //
-    // You can use this as a template and create Emit() function
-    // for individual node to fill in the module structure and instructions.
-    //
-    IRGenerator irgen;
-    llvm::Module *mod = irgen.GetOrCreateModule("Name_the_Module.bc");
-
-    // create a function signature
-    std::vector<llvm::Type *> argTypes;
-    llvm::Type *intTy = irgen.GetIntType();
-    argTypes.push_back(intTy);
-    llvm::ArrayRef<llvm::Type *> argArray(argTypes);
-    llvm::FunctionType *funcTy = llvm::FunctionType::get(intTy, argArray, false);
-
-    // llvm::Function *f = llvm::cast<llvm::Function>(mod->getOrInsertFunction("foo", intTy, intTy, (Type *)0));
-    llvm::Function *f = llvm::cast<llvm::Function>(mod->getOrInsertFunction("Name_the_function", funcTy));
-    llvm::Argument *arg = f->arg_begin();
-    arg->setName("x");
-
-    // insert a block into the runction
-    llvm::LLVMContext *context = irgen.GetContext();
-    llvm::BasicBlock *bb = llvm::BasicBlock::Create(*context, "entry", f);
-
-    // create a return instruction
-    llvm::Value *val = llvm::ConstantInt::get(intTy, 1);
-    llvm::Value *sum = llvm::BinaryOperator::CreateAdd(arg, val, "", bb);
-    llvm::ReturnInst::Create(*context, sum, bb);
-
-    // write the BC into standard output
-    llvm::WriteBitcodeToFile(mod, llvm::outs());
-
-    //uncomment the next line to generate the human readable/assembly file
-    //mod->dump();
+llvm::Value *Program::Emit() {
+    llvm::Module *mod = irgen->GetOrCreateModule("glc.bc");
+    for (int i = 0; i < decls->NumElements(); i++)
+        decls->Nth(i)->Emit();
+    return NULL;
 }
 
 StmtBlock::StmtBlock(List<VarDecl*> *d, List<Stmt*> *s) {
@@ -72,27 +43,22 @@ void StmtBlock::PrintChildren(int indentLevel) {
     stmts->PrintAll(indentLevel+1);
 }
 
-void StmtBlock::Emit() {
-    
-    //get the current scope
-    ScopedTable *currScope = symtab->currentScope();
-
-    for (int i=0; i < stmts->NumElements(); ++i) {
-        /* Returns a pointer to the terminator instruction that appears 
-          at the end of the BasicBlock. If there is no terminator instruction, 
-          or if the last instruction in the block is not a terminator, 
-          then a null pointer is returned.*/
-       // if(!IRGenerator::Inst.GetBasicBlock()->getTerminator())
-         //   break;
-        
-        stmts->Nth(i)->Emit();
+llvm::Value *StmtBlock::Emit() {
+    symtab->push();
+    for (int i = 0; i < decls->NumElements(); ++i) {
+        irgen->SetDebugLocation(decls->Nth(i)->GetLocation());
+        decls->Nth(i)->Emit();
     }
 
-    if(symtab->noReturnFlag){
-        //TODO
-        //what to do when there is return?? or no return??
-
+    for (int i = 0; i < stmts->NumElements(); ++i) {
+        // nothing after a return, break or continue is reachable
+        if (irgen->GetBasicBlock()->getTerminator())
+            break;
+        irgen->SetDebugLocation(stmts->Nth(i)->GetLocation());
+        stmts->Nth(i)->Emit();
     }
+    symtab->pop();
+    return NULL;
 }
 
 DeclStmt::DeclStmt(Decl *d) {
@@ -104,8 +70,8 @@ void DeclStmt::PrintChildren(int indentLevel) {
     decl->Print(indentLevel+1);
 }
 
-void DeclStmt::Emit(){
-    decl->Emit();
+llvm::Value *DeclStmt::Emit(){
+    return decl->Emit();
 }
 
 ConditionalStmt::ConditionalStmt(Expr *t, Stmt *b) { 
@@ -122,6 +88,21 @@ ForStmt::ForStmt(Expr *i, Expr *t, Expr *s, Stmt *b): LoopStmt(t, b) {
       (step=s)->SetParent(this);
 }
 
+bool LoopStmt::AddPragma(const char *text) {
+    int n, end = 0;
+    if (strcmp(text, "unroll") == 0)
+        unrollCount = FullUnroll;
+    else if (sscanf(text, "unroll(%d)%n", &n, &end) == 1 && text[end] == '\0' && n > 0)
+        unrollCount = n;
+    else if (strcmp(text, "vectorize") == 0)
+        vectorizeWidth = AnyWidth;
+    else if (sscanf(text, "vectorize(%d)%n", &n, &end) == 1 && text[end] == '\0' && n > 0)
+        vectorizeWidth = n;
+    else
+        return false;
+    return true;
+}
+
 void ForStmt::PrintChildren(int indentLevel) {
     init->Print(indentLevel+1, "(init) ");
     test->Print(indentLevel+1, "(test) ");
@@ -150,6 +131,7 @@ void IfStmt::PrintChildren(int indentLevel) {
 
 ReturnStmt::ReturnStmt(yyltype loc, Expr *e) : Stmt(loc) { 
     expr = e;
+    returnType = NULL;
     if (e != NULL) expr->SetParent(this);
 }
 
@@ -160,13 +142,17 @@ void ReturnStmt::PrintChildren(int indentLevel) {
 
 SwitchLabel::SwitchLabel(Expr *l, Stmt *s) {
     Assert(l != NULL && s != NULL);
+    value = 0;
+    location = l->GetLocation();   // errors about the label point at it
     (label=l)->SetParent(this);
     (stmt=s)->SetParent(this);
 }
 
 SwitchLabel::SwitchLabel(Stmt *s) {
     Assert(s != NULL);
+    value = 0;
     label = NULL;
+    location = s->GetLocation();
     (stmt=s)->SetParent(this);
 }
 
@@ -189,3 +175,305 @@ void SwitchStmt::PrintChildren(int indentLevel) {
     if (def) def->Print(indentLevel+1);
 }
 
+
+/* Semantic checks
+ * ---------------
+ * Statements check their children in order. Block scopes are pushed on
+ * the symbol table while their body is checked, and loops and switches
+ * are pushed on Node::stk so break/continue can tell where they are.
+ */
+
+void Program::Check() {
+    // a shared global scope already holds the built-ins
+    if (symtab->sharedScope() == NULL)
+        DeclareBuiltins(symtab);
+    for (int i = 0; i < decls->NumElements(); i++)
+        decls->Nth(i)->Check();
+}
+
+void StmtBlock::Check() {
+    symtab->push();
+    for (int i = 0; i < decls->NumElements(); i++)
+        decls->Nth(i)->Check();
+    for (int i = 0; i < stmts->NumElements(); i++)
+        stmts->Nth(i)->Check();
+    symtab->pop();
+}
+
+void DeclStmt::Check() {
+    decl->Check();
+}
+
+void ConditionalStmt::CheckTest() {
+    test->Check();
+    Type *t = test->GetType();
+    if (!t->IsError() && !t->IsBool())
+        ReportError::TestNotBoolean(test);
+}
+
+void ForStmt::Check() {
+    init->Check();
+    CheckTest();
+    if (step) step->Check();
+    stk->push(this);
+    body->Check();
+    stk->pop();
+}
+
+void WhileStmt::Check() {
+    CheckTest();
+    stk->push(this);
+    body->Check();
+    stk->pop();
+}
+
+void IfStmt::Check() {
+    CheckTest();
+    body->Check();
+    if (elseBody) elseBody->Check();
+}
+
+void BreakStmt::Check() {
+    if (!stk->insideLoop() && !stk->insideSwitch())
+        ReportError::BreakOutsideLoop(this);
+}
+
+void ContinueStmt::Check() {
+    if (!stk->insideLoop())
+        ReportError::ContinueOutsideLoop(this);
+}
+
+void ReturnStmt::Check() {
+    symtab->noReturnFlag = false;
+
+    Type *expected = returnType = symtab->returnType;
+    Type *given = Type::voidType;
+    if (expr) {
+        expr->Check();
+        given = expr->GetType();
+    }
+    if (expected && !given->IsError() && !given->IsConvertibleTo(expected))
+        ReportError::ReturnMismatch(this, given, expected);
+}
+
+void SwitchLabel::Check() {
+    // a label is a statement of the switch's body or labels one
+    Node *p = GetParent();
+    if (!dynamic_cast<SwitchStmt*>(p) && !dynamic_cast<SwitchLabel*>(p))
+        ReportError::Formatted(GetLocation(),
+            "Case and default labels must be directly inside a switch");
+    if (label) {
+        label->Check();
+        Type *t = label->GetType();
+        ConstValue *v = label->EvalConst();
+        bool isInt = t->IsEquivalentTo(Type::intType) || t->IsEquivalentTo(Type::uintType);
+        if (!t->IsError() && (v == NULL || !isInt))
+            ReportError::Formatted(label->GetLocation(),
+                "Case label must be a constant integer expression");
+        else if (v != NULL)
+            value = (int)(uint32_t)(int64_t)v->comps[0];   // uints above INT_MAX wrap
+    }
+    if (stmt)  stmt->Check();
+}
+
+void SwitchStmt::Check() {
+    expr->Check();
+    Type *t = expr->GetType();
+    if (!t->IsError() && !t->IsEquivalentTo(Type::intType) && !t->IsEquivalentTo(Type::uintType))
+        ReportError::Formatted(expr->GetLocation(), "Switch expression must have integer type");
+
+    stk->push(this);
+    for (int i = 0; i < cases->NumElements(); i++)
+        cases->Nth(i)->Check();
+    if (def) def->Check();
+    stk->pop();
+
+    if (!dynamic_cast<SwitchLabel*>(cases->Nth(0)))
+        ReportError::Formatted(cases->Nth(0)->GetLocation(),
+            "No statements are allowed in a switch before the first case label");
+
+    // each value, and the default, may label only one place
+    std::set<int> values;
+    bool hasDefault = false;
+    for (int i = 0; i <= cases->NumElements(); i++) {
+        Stmt *s = i < cases->NumElements() ? cases->Nth(i) : def;
+        for (SwitchLabel *l; (l = dynamic_cast<SwitchLabel*>(s)) != NULL; s = l->GetStmt()) {
+            if (l->IsDefault() ? hasDefault : !values.insert(l->GetValue()).second) {
+                if (l->IsDefault())
+                    ReportError::Formatted(l->GetLocation(), "Duplicate default label in switch");
+                else
+                    ReportError::Formatted(l->GetLocation(),
+                        "Duplicate case label %d in switch", l->GetValue());
+            }
+            hasDefault |= l->IsDefault();
+        }
+    }
+}
+
+
+/* IR emission
+ * -----------
+ * Statements append to the current basic block; control flow creates new
+ * blocks and leaves the current block at the point where execution joins.
+ * Each new block is sealed as soon as every branch into it exists.
+ */
+
+llvm::Value *IfStmt::Emit() {
+    llvm::LLVMContext *context = irgen->GetContext();
+    llvm::Function *f = irgen->GetFunction();
+    IRGenerator::Builder *builder = irgen->GetBuilder();
+    irgen->SetDebugLocation(test->GetLocation());
+    llvm::Value *cond = test->Emit();
+
+    llvm::BasicBlock *thenBB = llvm::BasicBlock::Create(*context, "then", f);
+    llvm::BasicBlock *elseBB = elseBody ? llvm::BasicBlock::Create(*context, "else", f) : NULL;
+    llvm::BasicBlock *footBB = llvm::BasicBlock::Create(*context, "footer", f);
+    builder->CreateCondBr(cond, thenBB, elseBB ? elseBB : footBB);
+    irgen->SealBlock(thenBB);
+    if (elseBB) irgen->SealBlock(elseBB);
+
+    irgen->SetBasicBlock(thenBB);
+    irgen->SetDebugLocation(body->GetLocation());
+    body->Emit();
+    if (!irgen->GetBasicBlock()->getTerminator())
+        builder->CreateBr(footBB);
+
+    if (elseBody) {
+        irgen->SetBasicBlock(elseBB);
+        irgen->SetDebugLocation(elseBody->GetLocation());
+        elseBody->Emit();
+        if (!irgen->GetBasicBlock()->getTerminator())
+            builder->CreateBr(footBB);
+    }
+    irgen->SealBlock(footBB);
+    irgen->SetBasicBlock(footBB);
+    return NULL;
+}
+
+void LoopStmt::EmitRotated(Expr *step) {
+    llvm::LLVMContext *context = irgen->GetContext();
+    llvm::Function *f = irgen->GetFunction();
+    IRGenerator::Builder *builder = irgen->GetBuilder();
+    llvm::BasicBlock *preheader = llvm::BasicBlock::Create(*context, "loop.ph", f);
+    llvm::BasicBlock *bodyBB = llvm::BasicBlock::Create(*context, "loop.body", f);
+    llvm::BasicBlock *latch = llvm::BasicBlock::Create(*context, "loop.latch", f);
+    llvm::BasicBlock *exitBB = llvm::BasicBlock::Create(*context, "loop.exit", f);
+
+    // a loop that runs zero times skips the preheader
+    irgen->SetDebugLocation(test->GetLocation());
+    llvm::Value *cond = test->Emit();
+    builder->CreateCondBr(cond, preheader, exitBB);
+    irgen->SealBlock(preheader);
+    irgen->SetBasicBlock(preheader);
+    builder->CreateBr(bodyBB);
+
+    // continue runs the latch, break leaves for the exit
+    irgen->SetBasicBlock(bodyBB);
+    irgen->continueBlockStack.push(latch);
+    irgen->breakBlockStack.push(exitBB);
+    irgen->SetDebugLocation(body->GetLocation());
+    body->Emit();
+    irgen->breakBlockStack.pop();
+    irgen->continueBlockStack.pop();
+    if (!irgen->GetBasicBlock()->getTerminator())
+        builder->CreateBr(latch);
+    irgen->SealBlock(latch);
+
+    irgen->SetBasicBlock(latch);
+    if (step) {
+        irgen->SetDebugLocation(step->GetLocation());
+        step->Emit();
+    }
+    irgen->SetDebugLocation(test->GetLocation());
+    cond = test->Emit();
+    llvm::BranchInst *backedge = builder->CreateCondBr(cond, bodyBB, exitBB);
+    if (llvm::MDNode *loopID = irgen->GetLoopMetadata(unrollCount, vectorizeWidth))
+        backedge->setMetadata(llvm::LLVMContext::MD_loop, loopID);
+    irgen->SealBlock(bodyBB);
+    irgen->SealBlock(exitBB);
+    irgen->SetBasicBlock(exitBB);
+}
+
+llvm::Value *ForStmt::Emit() {
+    irgen->SetDebugLocation(init->GetLocation());
+    init->Emit();
+    EmitRotated(step);
+    return NULL;
+}
+
+llvm::Value *WhileStmt::Emit() {
+    EmitRotated(NULL);
+    return NULL;
+}
+
+llvm::Value *ContinueStmt::Emit() {
+    irgen->GetBuilder()->CreateBr(irgen->continueBlockStack.top());
+    return NULL;
+}
+
+llvm::Value *BreakStmt::Emit() {
+    irgen->GetBuilder()->CreateBr(irgen->breakBlockStack.top());
+    return NULL;
+}
+
+llvm::Value *SwitchLabel::Emit() {
+    return stmt->Emit();
+}
+
+llvm::Value *SwitchStmt::Emit() {
+    // one switch instruction dispatches to a block per run of labels, so
+    // the backend is free to build a jump table or bit tests; each block
+    // falls through into the next unless it breaks
+    llvm::LLVMContext *context = irgen->GetContext();
+    llvm::Function *f = irgen->GetFunction();
+    IRGenerator::Builder *builder = irgen->GetBuilder();
+    irgen->SetDebugLocation(expr->GetLocation());
+    llvm::Value *v = expr->Emit();
+    llvm::BasicBlock *footBB = llvm::BasicBlock::Create(*context, "switch.end", f);
+    llvm::SwitchInst *sw = builder->CreateSwitch(v, footBB, cases->NumElements());
+
+    irgen->breakBlockStack.push(footBB);
+    for (int i = 0; i <= cases->NumElements(); i++) {
+        Stmt *s = i < cases->NumElements() ? cases->Nth(i) : def;
+        if (s == NULL)
+            continue;
+        if (dynamic_cast<SwitchLabel*>(s)) {
+            bool isDefault = false;
+            llvm::BasicBlock *caseBB = llvm::BasicBlock::Create(*context, "case", f, footBB);
+            for (SwitchLabel *l; (l = dynamic_cast<SwitchLabel*>(s)) != NULL; s = l->GetStmt()) {
+                if (l->IsDefault())
+                    isDefault = true;
+                else
+                    sw->addCase(builder->getInt32(l->GetValue()), caseBB);
+            }
+            if (isDefault)
+                sw->setDefaultDest(caseBB);
+            if (!irgen->GetBasicBlock()->getTerminator())
+                builder->CreateBr(caseBB);
+            irgen->SealBlock(caseBB);
+            irgen->SetBasicBlock(caseBB);
+        }
+        // whatever follows a break up to the next label can't be reached
+        if (!irgen->GetBasicBlock()->getTerminator()) {
+            irgen->SetDebugLocation(s->GetLocation());
+            s->Emit();
+        }
+    }
+    irgen->breakBlockStack.pop();
+
+    if (!irgen->GetBasicBlock()->getTerminator())
+        builder->CreateBr(footBB);
+    irgen->SealBlock(footBB);
+    irgen->SetBasicBlock(footBB);
+    return NULL;
+}
+
+llvm::Value *ReturnStmt::Emit() {
+    if (expr == NULL || expr->GetType()->IsEquivalentTo(Type::voidType))
+        irgen->GetBuilder()->CreateRetVoid();
+    else {
+        llvm::Value *value = expr->EmitAs(returnType);
+        irgen->GetBuilder()->CreateRet(value);
+    }
+    return NULL;
+}
@@ -20,6 +20,7 @@ class Decl;
 class VarDecl;
 class Expr;
 class IntConstant;
+class Type;
   
 void yyerror(const char *msg);
 
@@ -31,8 +32,10 @@ class Program : public Node
   public:
      Program(List<Decl*> *declList);
      const char *GetPrintNameForNode() { return "Program"; }
+     List<Decl*> *GetDecls() const { return decls; }
      void PrintChildren(int indentLevel);
-     virtual void Emit();
+     virtual llvm::Value *Emit();
+     void Check();
 };
 
 class Stmt : public Node
@@ -52,7 +55,8 @@ class StmtBlock : public Stmt
     StmtBlock(List<VarDecl*> *variableDeclarations, List<Stmt*> *statements);
     const char *GetPrintNameForNode() { return "StmtBlock"; }
     void PrintChildren(int indentLevel);
-    void Emit();
+    void Check();
+    llvm::Value *Emit();
 };
 
 class DeclStmt: public Stmt 
@@ -64,7 +68,8 @@ class DeclStmt: public Stmt
     DeclStmt(Decl *d);
     const char *GetPrintNameForNode() { return "DeclStmt"; }
     void PrintChildren(int indentLevel);
-    void Emit();
+    void Check();
+    llvm::Value *Emit();
 
 };
   
@@ -78,13 +83,31 @@ class ConditionalStmt : public Stmt
     ConditionalStmt() : Stmt(), test(NULL), body(NULL) {}
     ConditionalStmt(Expr *testExpr, Stmt *body);
 
+    // checks the test expression and reports it if it isn't a bool
+    void CheckTest();
+
 };
 
 class LoopStmt : public ConditionalStmt 
 {
+  protected:
+    // hints from #pragma unroll / #pragma vectorize, 0 when not given
+    int unrollCount;       // or FullUnroll
+    int vectorizeWidth;    // or AnyWidth
+
+    // emits the loop rotated: the test guards a preheader, the body is
+    // the header and a single latch runs step and the test again
+    void EmitRotated(Expr *step);
+
   public:
+    static const int FullUnroll = -1, AnyWidth = -1;
+
     LoopStmt(Expr *testExpr, Stmt *body)
-            : ConditionalStmt(testExpr, body) {}
+            : ConditionalStmt(testExpr, body), unrollCount(0), vectorizeWidth(0) {}
+
+    // takes the text of a "#pragma unroll", "unroll(N)", "vectorize" or
+    // "vectorize(N)" naming this loop, false if it is none of those
+    bool AddPragma(const char *text);
 };
 
 class ForStmt : public LoopStmt 
@@ -96,6 +119,8 @@ class ForStmt : public LoopStmt
     ForStmt(Expr *init, Expr *test, Expr *step, Stmt *body);
     const char *GetPrintNameForNode() { return "ForStmt"; }
     void PrintChildren(int indentLevel);
+    void Check();
+    llvm::Value *Emit();
 
 };
 
@@ -105,6 +130,8 @@ class WhileStmt : public LoopStmt
     WhileStmt(Expr *test, Stmt *body) : LoopStmt(test, body) {}
     const char *GetPrintNameForNode() { return "WhileStmt"; }
     void PrintChildren(int indentLevel);
+    void Check();
+    llvm::Value *Emit();
 
 };
 
@@ -118,6 +145,8 @@ class IfStmt : public ConditionalStmt
     IfStmt(Expr *test, Stmt *thenBody, Stmt *elseBody);
     const char *GetPrintNameForNode() { return "IfStmt"; }
     void PrintChildren(int indentLevel);
+    void Check();
+    llvm::Value *Emit();
 
 };
 
@@ -133,6 +162,8 @@ class BreakStmt : public Stmt
   public:
     BreakStmt(yyltype loc) : Stmt(loc) {}
     const char *GetPrintNameForNode() { return "BreakStmt"; }
+    void Check();
+    llvm::Value *Emit();
 
 };
 
@@ -141,6 +172,8 @@ class ContinueStmt : public Stmt
   public:
     ContinueStmt(yyltype loc) : Stmt(loc) {}
     const char *GetPrintNameForNode() { return "ContinueStmt"; }
+    void Check();
+    llvm::Value *Emit();
 
 };
 
@@ -148,11 +181,14 @@ class ReturnStmt : public Stmt
 {
   protected:
     Expr *expr;
+    Type *returnType;   // the function's, set by Check()
   
   public:
     ReturnStmt(yyltype loc, Expr *expr = NULL);
     const char *GetPrintNameForNode() { return "ReturnStmt"; }
     void PrintChildren(int indentLevel);
+    void Check();
+    llvm::Value *Emit();
 
 };
 
@@ -161,12 +197,20 @@ class SwitchLabel : public Stmt
   protected:
     Expr     *label;
     Stmt     *stmt;
+    int      value;    // folded label, set by Check()
 
   public:
-    SwitchLabel() { label = NULL; stmt = NULL; }
+    SwitchLabel() { label = NULL; stmt = NULL; value = 0; }
     SwitchLabel(Expr *label, Stmt *stmt);
     SwitchLabel(Stmt *stmt);
     void PrintChildren(int indentLevel);
+    Expr *GetLabel() const { return label; }
+    Stmt *GetStmt() const { return stmt; }
+    int GetValue() const { return value; }
+    bool IsDefault() const { return label == NULL; }
+    void Check();
+    // the labelled statement; the switch places the label itself
+    llvm::Value *Emit();
 
 };
 
@@ -197,6 +241,8 @@ class SwitchStmt : public Stmt
     SwitchStmt(Expr *expr, List<Stmt*> *cases, Default *def);
     virtual const char *GetPrintNameForNode() { return "SwitchStmt"; }
     void PrintChildren(int indentLevel);
+    void Check();
+    llvm::Value *Emit();
 
 };
 
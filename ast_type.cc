@@ -6,6 +6,8 @@
 #include <string.h>
 #include "ast_type.h"
 #include "ast_decl.h"
+#include "ast_expr.h"
+#include "errors.h"
  
 /* Class constants
  * ---------------
@@ -65,9 +67,7 @@ bool Type::IsNumeric() {
 }
 
 bool Type::IsVector() { 
-    return this->IsEquivalentTo(Type::vec2Type) || 
-           this->IsEquivalentTo(Type::vec3Type) ||  
-           this->IsEquivalentTo(Type::vec4Type);
+    return !this->IsMatrix() && this->GetVectorSize() > 1;
 }
 
 bool Type::IsMatrix() { 
@@ -79,6 +79,79 @@ bool Type::IsMatrix() {
 bool Type::IsError() { 
     return this->IsEquivalentTo(Type::errorType);
 }
+
+bool Type::IsBool() { 
+    return this->IsEquivalentTo(Type::boolType);
+}
+
+Type *Type::GetScalarType() {
+    if (this == vec2Type || this == vec3Type || this == vec4Type || IsMatrix())
+        return floatType;
+    if (this == ivec2Type || this == ivec3Type || this == ivec4Type)
+        return intType;
+    if (this == uvec2Type || this == uvec3Type || this == uvec4Type)
+        return uintType;
+    if (this == bvec2Type || this == bvec3Type || this == bvec4Type)
+        return boolType;
+    return this;
+}
+
+// number of components of a vector type, or of one column of a matrix
+// type; 1 for scalars and 0 for everything else
+int Type::GetVectorSize() {
+    if (this == vec2Type || this == ivec2Type || this == uvec2Type || this == bvec2Type ||
+        this == mat2Type)
+        return 2;
+    if (this == vec3Type || this == ivec3Type || this == uvec3Type || this == bvec3Type ||
+        this == mat3Type)
+        return 3;
+    if (this == vec4Type || this == ivec4Type || this == uvec4Type || this == bvec4Type ||
+        this == mat4Type)
+        return 4;
+    if (this == intType || this == uintType || this == floatType || this == boolType)
+        return 1;
+    return 0;
+}
+
+bool Type::IsConvertibleTo(Type *other) {
+    if (this == other || this == errorType)
+        return true;
+    std::vector<Type *> targets;
+    ImplicitConversions(targets);
+    for (int i = 0; i < targets.size(); i++)
+        if (targets[i] == other)
+            return true;
+    return false;
+}
+
+void Type::ImplicitConversions(std::vector<Type *> &out) {
+    int size = GetVectorSize();
+    Type *scalar = GetScalarType();
+    if (size == 0 || IsMatrix())
+        return;
+    if (scalar == intType) {
+        out.push_back(GetVectorType(uintType, size));
+        out.push_back(GetVectorType(floatType, size));
+    }
+    else if (scalar == uintType)
+        out.push_back(GetVectorType(floatType, size));
+}
+
+Type *Type::GetVectorType(Type *scalar, int size) {
+    static Type **vectors[][3] = {
+        { &vec2Type,  &vec3Type,  &vec4Type  },
+        { &ivec2Type, &ivec3Type, &ivec4Type },
+        { &uvec2Type, &uvec3Type, &uvec4Type },
+        { &bvec2Type, &bvec3Type, &bvec4Type },
+    };
+    if (size == 1) return scalar;
+    if (size < 2 || size > 4) return errorType;
+
+    int row = (scalar == floatType) ? 0 : (scalar == intType) ? 1 :
+              (scalar == uintType) ? 2 : (scalar == boolType) ? 3 : -1;
+    if (row < 0) return errorType;
+    return *vectors[row][size-2];
+}
 	
 NamedType::NamedType(Identifier *i) : Type(*i->GetLocation()) {
     Assert(i != NULL);
@@ -93,9 +166,46 @@ ArrayType::ArrayType(yyltype loc, Type *et, int ec) : Type(loc) {
     Assert(et != NULL);
     (elemType=et)->SetParent(this);
     elemCount=ec;
+    sizeExpr=NULL;
+}
+
+ArrayType::ArrayType(yyltype loc, Type *et, Expr *se) : Type(loc) {
+    Assert(et != NULL && se != NULL);
+    (elemType=et)->SetParent(this);
+    (sizeExpr=se)->SetParent(this);
+    elemCount=-1;
+}
+
+// the size is any constant integer expression, folded here once
+void ArrayType::Check() {
+    if (sizeExpr == NULL || elemCount >= 0)
+        return;
+
+    elemCount = 1;  // keeps later checks sane after an error
+    sizeExpr->Check();
+    Type *t = sizeExpr->GetType();
+    if (t->IsError())
+        return;
+
+    ConstValue *size = sizeExpr->EvalConst();
+    if (size == NULL || !(t->IsEquivalentTo(Type::intType) || t->IsEquivalentTo(Type::uintType))) {
+        ReportError::Formatted(sizeExpr->GetLocation(),
+            "Array size must be a constant integer expression");
+        return;
+    }
+    if (size->comps[0] <= 0) {
+        ReportError::Formatted(sizeExpr->GetLocation(), "Array size must be greater than zero");
+        return;
+    }
+    elemCount = (int)size->comps[0];
 }
 void ArrayType::PrintChildren(int indentLevel) {
     elemType->Print(indentLevel+1);
 }
 
+bool ArrayType::IsEquivalentTo(Type *other) {
+    ArrayType *arr = dynamic_cast<ArrayType*>(other);
+    return arr && elemCount == arr->elemCount && elemType->IsEquivalentTo(arr->elemType);
+}
+
 
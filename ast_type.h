@@ -15,6 +15,7 @@
 #include "ast.h"
 #include "list.h"
 #include <iostream>
+#include <vector>
 
 using namespace std;
 
@@ -56,11 +57,23 @@ class Type : public Node
     virtual void PrintToStream(ostream& out) { out << typeName; }
     friend ostream& operator<<(ostream& out, Type *t) { t->PrintToStream(out); return out; }
     virtual bool IsEquivalentTo(Type *other) { return (this == other); }
-    virtual bool IsConvertibleTo(Type *other) { return (this == other || this == errorType); }
+    // the one implicit conversion rule, for calls, initializers,
+    // assignments and returns alike
+    virtual bool IsConvertibleTo(Type *other);
+    // the types a value of this type converts to implicitly: int to uint
+    // and float, uint to float, vectors component by component
+    void ImplicitConversions(std::vector<Type *> &out);
     bool IsNumeric();
     bool IsVector();
     bool IsMatrix();
     bool IsError();
+    bool IsBool();
+
+    // component helpers for vector and matrix types: a vector's scalar
+    // type is the type of one component, a matrix's is float
+    Type *GetScalarType();
+    int GetVectorSize();
+    static Type *GetVectorType(Type *scalar, int size);
 };
 
 
@@ -77,19 +90,27 @@ class NamedType : public Type
     void PrintToStream(ostream& out) { out << id; }
 };
 
+class Expr;
+
 class ArrayType : public Type 
 {
   protected:
     Type *elemType;
-    int   elemCount;
+    int   elemCount;   // -1 until Check() has evaluated sizeExpr
+    Expr *sizeExpr;
 
   public:
     ArrayType(yyltype loc, Type *elemType, int elemCount);
+    ArrayType(yyltype loc, Type *elemType, Expr *sizeExpr);
+    void Check();
     
     const char *GetPrintNameForNode() { return "ArrayType"; }
     void PrintChildren(int indentLevel);
     void PrintToStream(ostream& out) { out << elemType << "[]"; }
+    bool IsEquivalentTo(Type *other);
+    bool IsConvertibleTo(Type *other) { return IsEquivalentTo(other); }
     Type *GetElemType() {return elemType;}
+    int GetElemCount() {return elemCount;}
 };
 
  
@@ -0,0 +1,369 @@
+/* File: builtins.cc
+ * -----------------
+ * Table of built-in function signatures. "genType" in the GLSL spec
+ * stands for float, vec2, vec3 and vec4, so those entries are expanded
+ * into one overload per size, as are the matN entries. Calls are lowered
+ * inline at the bottom of the file.
+ */
+
+#include <math.h>
+#include <string.h>
+#include "builtins.h"
+#include "ast_decl.h"
+#include "ast_type.h"
+#include "symtable.h"
+#include "irgen.h"
+#include "llvm/IR/Intrinsics.h"
+
+// argument/return kinds used by the table below
+enum BuiltinArg { A_None, A_Gen, A_Float, A_Vec3, A_Int, A_Mat };
+
+struct BuiltinSig {
+    const char *name;
+    BuiltinArg ret;
+    BuiltinArg args[3];
+};
+
+static const BuiltinSig builtinSigs[] = {
+    { "radians",     A_Gen,   { A_Gen } },
+    { "degrees",     A_Gen,   { A_Gen } },
+    { "sin",         A_Gen,   { A_Gen } },
+    { "cos",         A_Gen,   { A_Gen } },
+    { "tan",         A_Gen,   { A_Gen } },
+    { "asin",        A_Gen,   { A_Gen } },
+    { "acos",        A_Gen,   { A_Gen } },
+    { "atan",        A_Gen,   { A_Gen } },
+    { "atan",        A_Gen,   { A_Gen, A_Gen } },
+    { "pow",         A_Gen,   { A_Gen, A_Gen } },
+    { "exp",         A_Gen,   { A_Gen } },
+    { "log",         A_Gen,   { A_Gen } },
+    { "exp2",        A_Gen,   { A_Gen } },
+    { "log2",        A_Gen,   { A_Gen } },
+    { "sqrt",        A_Gen,   { A_Gen } },
+    { "inversesqrt", A_Gen,   { A_Gen } },
+    { "abs",         A_Gen,   { A_Gen } },
+    { "abs",         A_Int,   { A_Int } },
+    { "sign",        A_Gen,   { A_Gen } },
+    { "floor",       A_Gen,   { A_Gen } },
+    { "ceil",        A_Gen,   { A_Gen } },
+    { "fract",       A_Gen,   { A_Gen } },
+    { "mod",         A_Gen,   { A_Gen, A_Gen } },
+    { "mod",         A_Gen,   { A_Gen, A_Float } },
+    { "min",         A_Gen,   { A_Gen, A_Gen } },
+    { "min",         A_Gen,   { A_Gen, A_Float } },
+    { "min",         A_Int,   { A_Int, A_Int } },
+    { "max",         A_Gen,   { A_Gen, A_Gen } },
+    { "max",         A_Gen,   { A_Gen, A_Float } },
+    { "max",         A_Int,   { A_Int, A_Int } },
+    { "clamp",       A_Gen,   { A_Gen, A_Gen, A_Gen } },
+    { "clamp",       A_Gen,   { A_Gen, A_Float, A_Float } },
+    { "clamp",       A_Int,   { A_Int, A_Int, A_Int } },
+    { "mix",         A_Gen,   { A_Gen, A_Gen, A_Gen } },
+    { "mix",         A_Gen,   { A_Gen, A_Gen, A_Float } },
+    { "step",        A_Gen,   { A_Gen, A_Gen } },
+    { "step",        A_Gen,   { A_Float, A_Gen } },
+    { "smoothstep",  A_Gen,   { A_Gen, A_Gen, A_Gen } },
+    { "smoothstep",  A_Gen,   { A_Float, A_Float, A_Gen } },
+    { "length",      A_Float, { A_Gen } },
+    { "distance",    A_Float, { A_Gen, A_Gen } },
+    { "dot",         A_Float, { A_Gen, A_Gen } },
+    { "cross",       A_Vec3,  { A_Vec3, A_Vec3 } },
+    { "normalize",   A_Gen,   { A_Gen } },
+    { "faceforward", A_Gen,   { A_Gen, A_Gen, A_Gen } },
+    { "reflect",     A_Gen,   { A_Gen, A_Gen } },
+    { "refract",     A_Gen,   { A_Gen, A_Gen, A_Float } },
+    { "transpose",   A_Mat,   { A_Mat } },
+};
+
+static Type *argType(BuiltinArg arg, Type *gen) {
+    switch (arg) {
+      case A_Gen:
+      case A_Mat:   return gen;
+      case A_Float: return Type::floatType;
+      case A_Vec3:  return Type::vec3Type;
+      case A_Int:   return Type::intType;
+      default:      return NULL;
+    }
+}
+
+static bool usesMatType(const BuiltinSig &sig) {
+    return sig.ret == A_Mat || sig.args[0] == A_Mat;
+}
+
+static bool usesGenType(const BuiltinSig &sig) {
+    if (sig.ret == A_Gen) return true;
+    for (int i = 0; i < 3; i++)
+        if (sig.args[i] == A_Gen) return true;
+    return false;
+}
+
+static void declare(SymbolTable *symtab, const BuiltinSig &sig, Type *gen) {
+    static const char *formalNames[] = { "x", "y", "a" };
+    yyltype loc = yyltype();
+
+    List<VarDecl*> *formals = new List<VarDecl*>;
+    for (int i = 0; i < 3 && sig.args[i] != A_None; i++) {
+        Identifier *formal = new Identifier(loc, formalNames[i]);
+        formals->Append(new VarDecl(formal, argType(sig.args[i], gen)));
+    }
+    FnDecl *fn = new FnDecl(new Identifier(loc, sig.name), argType(sig.ret, gen), formals);
+    fn->SetBuiltin();
+
+    Symbol *prev = symtab->currentScope()->find(sig.name);
+    if (prev == NULL) {
+        Symbol sym(fn->GetIdentifier()->GetName(), fn, E_FunctionDecl);
+        sym.overloads = new OverloadSet();
+        sym.overloads->insert(fn);
+        symtab->insert(sym);
+    }
+    else
+        prev->overloads->insert(fn);
+}
+
+void DeclareBuiltins(SymbolTable *symtab) {
+    static Type **genTypes[] = { &Type::floatType, &Type::vec2Type, &Type::vec3Type, &Type::vec4Type };
+    static Type **matTypes[] = { &Type::mat2Type, &Type::mat3Type, &Type::mat4Type };
+    int numSigs = sizeof(builtinSigs) / sizeof(builtinSigs[0]);
+
+    for (int i = 0; i < numSigs; i++) {
+        if (usesMatType(builtinSigs[i])) {
+            for (int m = 0; m < 3; m++)
+                declare(symtab, builtinSigs[i], *matTypes[m]);
+            continue;
+        }
+        if (!usesGenType(builtinSigs[i])) {
+            declare(symtab, builtinSigs[i], NULL);
+            continue;
+        }
+        // at float, "genType, float" forms repeat the "genType, genType"
+        // overload; OverloadSet::insert keeps only the first of those
+        for (int g = 0; g < 4; g++)
+            declare(symtab, builtinSigs[i], *genTypes[g]);
+    }
+}
+
+
+/* Lowering
+ * --------
+ * Everything LLVM has an intrinsic for maps to it, so vector arguments
+ * stay vectors; the trigonometry LLVM lacks calls libm per component.
+ * The rest is spelled out with the formulas from the GLSL spec.
+ */
+
+static IRGenerator::Builder *Builder() {
+    return Node::irgen->GetBuilder();
+}
+
+static llvm::Value *Op(llvm::Instruction::BinaryOps op, llvm::Value *a, llvm::Value *b) {
+    return Builder()->CreateBinOp(op, a, b);
+}
+
+static llvm::Value *FCmp(llvm::CmpInst::Predicate pred, llvm::Value *a, llvm::Value *b) {
+    return Builder()->CreateFCmp(pred, a, b);
+}
+
+static llvm::Value *ICmp(llvm::CmpInst::Predicate pred, llvm::Value *a, llvm::Value *b) {
+    return Builder()->CreateICmp(pred, a, b);
+}
+
+static llvm::Value *Select(llvm::Value *cond, llvm::Value *a, llvm::Value *b) {
+    return Builder()->CreateSelect(cond, a, b);
+}
+
+// a float constant of ty, splatted if ty is a vector
+static llvm::Value *FConst(llvm::Type *ty, double v) {
+    return llvm::ConstantFP::get(ty, v);
+}
+
+// a scalar argument used with a genType one
+static llvm::Value *Widen(llvm::Value *v, llvm::Type *ty) {
+    llvm::FixedVectorType *vecTy = llvm::dyn_cast<llvm::FixedVectorType>(ty);
+    if (vecTy == NULL || v->getType()->isVectorTy())
+        return v;
+    return Node::irgen->Splat(v, vecTy->getNumElements());
+}
+
+static llvm::Value *CallIntrinsic(llvm::Intrinsic::ID id, std::vector<llvm::Value*> args) {
+    llvm::Module *module = Node::irgen->GetOrCreateModule("glc.bc");
+    llvm::Function *f = llvm::Intrinsic::getDeclaration(module, id, args[0]->getType());
+    return Builder()->CreateCall(f, args);
+}
+
+// float libm function applied to each component
+static llvm::Value *CallLibm(const char *name, std::vector<llvm::Value*> args) {
+    IRGenerator *irgen = Node::irgen;
+    llvm::Module *module = irgen->GetOrCreateModule("glc.bc");
+    std::vector<llvm::Type*> params(args.size(), irgen->GetFloatType());
+    llvm::FunctionCallee f = module->getOrInsertFunction(name,
+        llvm::FunctionType::get(irgen->GetFloatType(), params, false));
+
+    llvm::FixedVectorType *vecTy = llvm::dyn_cast<llvm::FixedVectorType>(args[0]->getType());
+    if (vecTy == NULL)
+        return Builder()->CreateCall(f, args);
+
+    llvm::Value *result = llvm::UndefValue::get(vecTy);
+    for (unsigned i = 0; i < vecTy->getNumElements(); i++) {
+        std::vector<llvm::Value*> comps;
+        for (size_t a = 0; a < args.size(); a++)
+            comps.push_back(Builder()->CreateExtractElement(args[a], i));
+        llvm::Value *c = Builder()->CreateCall(f, comps);
+        result = Builder()->CreateInsertElement(result, c, i);
+    }
+    return result;
+}
+
+static llvm::Value *Dot(llvm::Value *a, llvm::Value *b) {
+    llvm::Value *product = Op(llvm::Instruction::FMul, a, b);
+    llvm::FixedVectorType *vecTy = llvm::dyn_cast<llvm::FixedVectorType>(product->getType());
+    if (vecTy == NULL)
+        return product;
+
+    llvm::Value *sum = NULL;
+    for (unsigned i = 0; i < vecTy->getNumElements(); i++) {
+        llvm::Value *c = Builder()->CreateExtractElement(product, i);
+        sum = sum ? Op(llvm::Instruction::FAdd, sum, c) : c;
+    }
+    return sum;
+}
+
+static llvm::Value *Length(llvm::Value *v) {
+    return CallIntrinsic(llvm::Intrinsic::sqrt, { Dot(v, v) });
+}
+
+static llvm::Value *Shuffle(llvm::Value *v, int a, int b, int c) {
+    int mask[] = { a, b, c };
+    return Builder()->CreateShuffleVector(v, mask);
+}
+
+// the same matrix with its stored vectors read across, which is the
+// transpose whichever way matrices are stored
+static llvm::Value *Transpose(llvm::Value *m) {
+    llvm::ArrayType *ty = llvm::cast<llvm::ArrayType>(m->getType());
+    int n = ty->getNumElements();
+    std::vector<llvm::Value*> vectors;
+    for (int i = 0; i < n; i++)
+        vectors.push_back(Builder()->CreateExtractValue(m, i));
+    llvm::Value *t = llvm::UndefValue::get(ty);
+    for (int i = 0; i < n; i++) {
+        llvm::Value *v = llvm::UndefValue::get(ty->getElementType());
+        for (int j = 0; j < n; j++)
+            v = Builder()->CreateInsertElement(v, Builder()->CreateExtractElement(vectors[j], i), j);
+        t = Builder()->CreateInsertValue(t, v, i);
+    }
+    return t;
+}
+
+llvm::Value *EmitBuiltin(FnDecl *fn, std::vector<llvm::Value*> &args) {
+    const char *name = fn->GetIdentifier()->GetName();
+    llvm::Type *ty = args[0]->getType();
+    bool isInt = fn->GetType()->IsEquivalentTo(Type::intType);
+    typedef llvm::Instruction I;
+
+    // genType builtins taking a float for some argument use it for every component
+    llvm::Type *genTy = Node::irgen->GetType(fn->GetType());
+    if (genTy->isVectorTy() && strcmp(name, "length") && strcmp(name, "distance") && strcmp(name, "dot"))
+        for (size_t i = 0; i < args.size(); i++)
+            args[i] = Widen(args[i], genTy);
+
+    if (!strcmp(name, "radians"))  return Op(I::FMul, args[0], FConst(ty, M_PI / 180.0));
+    if (!strcmp(name, "degrees"))  return Op(I::FMul, args[0], FConst(ty, 180.0 / M_PI));
+    if (!strcmp(name, "sin"))      return CallIntrinsic(llvm::Intrinsic::sin, args);
+    if (!strcmp(name, "cos"))      return CallIntrinsic(llvm::Intrinsic::cos, args);
+    if (!strcmp(name, "tan"))      return CallLibm("tanf", args);
+    if (!strcmp(name, "asin"))     return CallLibm("asinf", args);
+    if (!strcmp(name, "acos"))     return CallLibm("acosf", args);
+    if (!strcmp(name, "atan"))     return CallLibm(args.size() == 2 ? "atan2f" : "atanf", args);
+    if (!strcmp(name, "pow"))      return CallIntrinsic(llvm::Intrinsic::pow, args);
+    if (!strcmp(name, "exp"))      return CallIntrinsic(llvm::Intrinsic::exp, args);
+    if (!strcmp(name, "log"))      return CallIntrinsic(llvm::Intrinsic::log, args);
+    if (!strcmp(name, "exp2"))     return CallIntrinsic(llvm::Intrinsic::exp2, args);
+    if (!strcmp(name, "log2"))     return CallIntrinsic(llvm::Intrinsic::log2, args);
+    if (!strcmp(name, "sqrt"))     return CallIntrinsic(llvm::Intrinsic::sqrt, args);
+    if (!strcmp(name, "inversesqrt"))
+        return Op(I::FDiv, FConst(ty, 1.0), CallIntrinsic(llvm::Intrinsic::sqrt, args));
+    if (!strcmp(name, "floor"))    return CallIntrinsic(llvm::Intrinsic::floor, args);
+    if (!strcmp(name, "ceil"))     return CallIntrinsic(llvm::Intrinsic::ceil, args);
+    if (!strcmp(name, "fract"))
+        return Op(I::FSub, args[0], CallIntrinsic(llvm::Intrinsic::floor, args));
+    if (!strcmp(name, "mod")) {
+        llvm::Value *q = CallIntrinsic(llvm::Intrinsic::floor, { Op(I::FDiv, args[0], args[1]) });
+        return Op(I::FSub, args[0], Op(I::FMul, args[1], q));
+    }
+
+    if (!strcmp(name, "abs")) {
+        if (!isInt)
+            return CallIntrinsic(llvm::Intrinsic::fabs, args);
+        llvm::Value *zero = llvm::ConstantInt::get(ty, 0);
+        llvm::Value *neg = ICmp(llvm::CmpInst::ICMP_SLT, args[0], zero);
+        return Select(neg, Op(I::Sub, zero, args[0]), args[0]);
+    }
+    if (!strcmp(name, "sign")) {
+        llvm::Value *pos = Select(FCmp(llvm::CmpInst::FCMP_OGT, args[0], FConst(ty, 0)), FConst(ty, 1), FConst(ty, 0));
+        return Select(FCmp(llvm::CmpInst::FCMP_OLT, args[0], FConst(ty, 0)), FConst(ty, -1), pos);
+    }
+    if (!strcmp(name, "min") || !strcmp(name, "max")) {
+        bool isMin = !strcmp(name, "min");
+        if (!isInt)
+            return CallIntrinsic(isMin ? llvm::Intrinsic::minnum : llvm::Intrinsic::maxnum, args);
+        llvm::Value *less = ICmp(llvm::CmpInst::ICMP_SLT, args[0], args[1]);
+        return isMin ? Select(less, args[0], args[1]) : Select(less, args[1], args[0]);
+    }
+    if (!strcmp(name, "clamp")) {
+        if (!isInt) {
+            llvm::Value *low = CallIntrinsic(llvm::Intrinsic::maxnum, { args[0], args[1] });
+            return CallIntrinsic(llvm::Intrinsic::minnum, { low, args[2] });
+        }
+        llvm::Value *below = ICmp(llvm::CmpInst::ICMP_SLT, args[0], args[1]);
+        llvm::Value *low = Select(below, args[1], args[0]);
+        llvm::Value *above = ICmp(llvm::CmpInst::ICMP_SGT, low, args[2]);
+        return Select(above, args[2], low);
+    }
+    if (!strcmp(name, "mix"))
+        return Op(I::FAdd, args[0], Op(I::FMul, Op(I::FSub, args[1], args[0]), args[2]));
+    if (!strcmp(name, "step"))
+        return Select(FCmp(llvm::CmpInst::FCMP_OLT, args[1], args[0]), FConst(ty, 0), FConst(ty, 1));
+    if (!strcmp(name, "smoothstep")) {
+        llvm::Value *t = Op(I::FDiv, Op(I::FSub, args[2], args[0]), Op(I::FSub, args[1], args[0]));
+        t = CallIntrinsic(llvm::Intrinsic::maxnum, { t, FConst(genTy, 0) });
+        t = CallIntrinsic(llvm::Intrinsic::minnum, { t, FConst(genTy, 1) });
+        llvm::Value *poly = Op(I::FSub, FConst(genTy, 3), Op(I::FMul, FConst(genTy, 2), t));
+        return Op(I::FMul, Op(I::FMul, t, t), poly);
+    }
+
+    if (!strcmp(name, "transpose")) return Transpose(args[0]);
+    if (!strcmp(name, "length"))   return Length(args[0]);
+    if (!strcmp(name, "distance")) return Length(Op(I::FSub, args[0], args[1]));
+    if (!strcmp(name, "dot"))      return Dot(args[0], args[1]);
+    if (!strcmp(name, "cross")) {
+        llvm::Value *a = Op(I::FMul, Shuffle(args[0], 1, 2, 0), Shuffle(args[1], 2, 0, 1));
+        llvm::Value *b = Op(I::FMul, Shuffle(args[0], 2, 0, 1), Shuffle(args[1], 1, 2, 0));
+        return Op(I::FSub, a, b);
+    }
+    if (!strcmp(name, "normalize"))
+        return Op(I::FDiv, args[0], Widen(Length(args[0]), ty));
+    if (!strcmp(name, "faceforward")) {
+        llvm::Value *facing = FCmp(llvm::CmpInst::FCMP_OLT, Dot(args[2], args[1]),
+                                   FConst(Node::irgen->GetFloatType(), 0));
+        return Select(facing, args[0], Builder()->CreateFNeg(args[0]));
+    }
+    if (!strcmp(name, "reflect")) {
+        llvm::Value *d = Op(I::FMul, FConst(Node::irgen->GetFloatType(), 2), Dot(args[1], args[0]));
+        return Op(I::FSub, args[0], Op(I::FMul, Widen(d, ty), args[1]));
+    }
+    if (!strcmp(name, "refract")) {
+        // k = 1 - eta^2 (1 - dot(N,I)^2); k < 0 ? 0 : eta I - (eta dot(N,I) + sqrt(k)) N
+        llvm::Type *floatTy = Node::irgen->GetFloatType();
+        llvm::Value *eta = args[2];
+        if (eta->getType()->isVectorTy())
+            eta = Builder()->CreateExtractElement(eta, (uint64_t)0);
+        llvm::Value *d = Dot(args[1], args[0]);
+        llvm::Value *k = Op(I::FSub, FConst(floatTy, 1),
+                            Op(I::FMul, Op(I::FMul, eta, eta), Op(I::FSub, FConst(floatTy, 1), Op(I::FMul, d, d))));
+        llvm::Value *s = Op(I::FAdd, Op(I::FMul, eta, d), CallIntrinsic(llvm::Intrinsic::sqrt, { k }));
+        llvm::Value *r = Op(I::FSub, Op(I::FMul, Widen(eta, ty), args[0]), Op(I::FMul, Widen(s, ty), args[1]));
+        return Select(FCmp(llvm::CmpInst::FCMP_OLT, k, FConst(floatTy, 0)), FConst(ty, 0), r);
+    }
+
+    Assert(0);   // every entry of builtinSigs is lowered above
+    return NULL;
+}
@@ -0,0 +1,27 @@
+/**
+ * File: builtins.h
+ * ----------------
+ * Declarations of the GLSL built-in functions (mix, dot, normalize...).
+ * Each overload is an FnDecl marked as built-in with no body, entered
+ * into the global scope so calls resolve through the same overload sets
+ * as user functions.
+ */
+
+#ifndef _H_builtins
+#define _H_builtins
+
+#include <vector>
+
+class SymbolTable;
+class FnDecl;
+namespace llvm {
+  class Value;
+}
+
+void DeclareBuiltins(SymbolTable *symtab);
+
+// emits a call of built-in fn on arguments already converted to the types
+// of its formals, as intrinsics, libm calls or inline arithmetic
+llvm::Value *EmitBuiltin(FnDecl *fn, std::vector<llvm::Value*> &args);
+
+#endif
@@ -4,12 +4,43 @@
  */
 
 #include "irgen.h"
+#include "ast_expr.h"
+#include "ast_decl.h"
+#include <algorithm>
+#include <sstream>
+#include <string.h>
+#include "llvm/ADT/PostOrderIterator.h"
+#include "llvm/Analysis/CFG.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/IR/CFG.h"
+#include "llvm/IR/DIBuilder.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/MC/MCSubtargetInfo.h"
+#include "llvm/MC/TargetRegistry.h"
+#include "llvm/Passes/PassBuilder.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Host.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Target/TargetMachine.h"
+#include "llvm/Transforms/InstCombine/InstCombine.h"
+#include "llvm/Transforms/Scalar/Scalarizer.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+#include "llvm/Transforms/Utils/Local.h"
 
 IRGenerator::IRGenerator() :
     context(NULL),
     module(NULL),
     currentFunc(NULL),
-    currentBB(NULL)
+    builder(NULL),
+    diBuilder(NULL),
+    diUnit(NULL),
+    rowMajor(false),
+    optLevel(0),
+    spmdWidth(0),
+    targetMachine(NULL),
+    targetTriple(llvm::sys::getProcessTriple()),
+    targetCPU("generic")
 {
 }
 
@@ -21,14 +52,50 @@ llvm::Module *IRGenerator::GetOrCreateModule(const char *moduleID)
    if ( module == NULL ) {
      context = new llvm::LLVMContext();
      module  = new llvm::Module(moduleID, *context);
-     module->setTargetTriple(TargetTriple);
-     module->setDataLayout(TargetLayout);
+     module->setTargetTriple(targetTriple);
+     if (llvm::TargetMachine *machine = GetTargetMachine())
+       module->setDataLayout(machine->createDataLayout());
+     builder = new Builder(*context, llvm::TargetFolder(module->getDataLayout()));
+     builder->setFastMathFlags(fastMath);
+     if (HasDebugInfo()) {
+       module->addModuleFlag(llvm::Module::Warning, "Debug Info Version", llvm::DEBUG_METADATA_VERSION);
+       module->addModuleFlag(llvm::Module::Warning, "Dwarf Version", 4);
+       llvm::SmallString<256> path(debugFile);
+       llvm::sys::fs::make_absolute(path);
+       diBuilder = new llvm::DIBuilder(*module);
+       llvm::DIFile *file = diBuilder->createFile(llvm::sys::path::filename(path),
+                                                  llvm::sys::path::parent_path(path));
+       diUnit = diBuilder->createCompileUnit(llvm::dwarf::DW_LANG_C, file, "glc", optLevel > 0, "", 0,
+                                             "", llvm::DICompileUnit::LineTablesOnly);
+     }
    }
    return module;
 }
 
+void IRGenerator::ReleaseModule(std::unique_ptr<llvm::Module> &mod,
+                                std::unique_ptr<llvm::LLVMContext> &ctx)
+{
+   FinishDebugInfo();
+   delete diBuilder;
+   diBuilder = NULL;
+   diUnit = NULL;
+   delete builder;
+   builder = NULL;
+   functions.clear();
+   mod.reset(module);
+   ctx.reset(context);
+   module = NULL;
+   context = NULL;
+}
+
 void IRGenerator::SetFunction(llvm::Function *func) {
+   // definitions don't outlive the function they were made in
    currentFunc = func;
+   currentDef.clear();
+   incompletePhis.clear();
+   sealedBlocks.clear();
+   if (builder != NULL)
+     builder->SetCurrentDebugLocation(llvm::DebugLoc());
 }
 
 llvm::Function *IRGenerator::GetFunction() const {
@@ -36,11 +103,20 @@ llvm::Function *IRGenerator::GetFunction() const {
 }
 
 void IRGenerator::SetBasicBlock(llvm::BasicBlock *bb) {
-   currentBB = bb;
+   if (bb != NULL)
+     builder->SetInsertPoint(bb);
+   else
+     builder->ClearInsertionPoint();
 }
 
 llvm::BasicBlock *IRGenerator::GetBasicBlock() const {
-   return currentBB;
+   return builder->GetInsertBlock();
+}
+
+void IRGenerator::SetFastMathFlags(llvm::FastMathFlags flags) {
+   fastMath = flags;
+   if (builder != NULL)
+     builder->setFastMathFlags(flags);
 }
 
 llvm::Type *IRGenerator::GetIntType() const {
@@ -58,7 +134,749 @@ llvm::Type *IRGenerator::GetFloatType() const {
    return ty;
 }
 
-const char *IRGenerator::TargetLayout = "e-p:64:64:64-i1:8:8-i8:8:8-i16:16:16-i32:32:32-i64:64:64-f32:32:32-f64:64:64-v64:64:64-v128:128:128-a0:0:64-s0:64:64-f80:128:128-n8:16:32:64-S128";
+llvm::Type *IRGenerator::GetType(Type *astTy) {
+   if (ArrayType *arr = dynamic_cast<ArrayType*>(astTy)) {
+     llvm::Type *elem = GetType(arr->GetElemType());
+     if (elem == NULL) return NULL;
+     return llvm::ArrayType::get(elem, arr->GetElemCount());
+   }
+   if (astTy->IsMatrix()) {
+     int n = astTy->GetVectorSize();
+     return llvm::ArrayType::get(llvm::FixedVectorType::get(GetFloatType(), n), n);
+   }
+   if (astTy->IsVector())
+     return llvm::FixedVectorType::get(GetType(astTy->GetScalarType()), astTy->GetVectorSize());
+   if (astTy->IsEquivalentTo(Type::intType) || astTy->IsEquivalentTo(Type::uintType))
+     return GetIntType();
+   if (astTy->IsEquivalentTo(Type::floatType))
+     return GetFloatType();
+   if (astTy->IsEquivalentTo(Type::boolType))
+     return GetBoolType();
+   if (astTy->IsEquivalentTo(Type::voidType))
+     return llvm::Type::getVoidTy(*context);
+   return NULL;
+}
+
+// one scalar component of a folded value
+static llvm::Constant *GetScalarConstant(IRGenerator *irgen, Type *t, double v) {
+   if (t->IsEquivalentTo(Type::intType))
+     return llvm::ConstantInt::get(irgen->GetIntType(), (int64_t)v, true);
+   if (t->IsEquivalentTo(Type::uintType))
+     return llvm::ConstantInt::get(irgen->GetIntType(), (uint64_t)v, false);
+   if (t->IsEquivalentTo(Type::floatType))
+     return llvm::ConstantFP::get(irgen->GetFloatType(), v);
+   if (t->IsEquivalentTo(Type::boolType))
+     return llvm::ConstantInt::get(irgen->GetBoolType(), v != 0);
+   return NULL;
+}
+
+llvm::Constant *IRGenerator::GetConstant(ConstValue *value) {
+   Type *t = value->type;
+   if (ArrayType *arr = dynamic_cast<ArrayType*>(t)) {
+     llvm::ArrayType *ty = llvm::cast_or_null<llvm::ArrayType>(GetType(arr));
+     if (ty == NULL) return NULL;
+     std::vector<llvm::Constant*> elems;
+     for (size_t i = 0; i < value->elems.size(); i++) {
+       llvm::Constant *c = GetConstant(value->elems[i]);
+       if (c == NULL) return NULL;
+       elems.push_back(c);
+     }
+     return llvm::ConstantArray::get(ty, elems);
+   }
+
+   Type *scalar = t->GetScalarType();
+   int size = t->GetVectorSize();
+   if (size == 0)
+     return NULL;
+   if (!t->IsVector() && !t->IsMatrix())
+     return GetScalarConstant(this, t, value->comps[0]);
+
+   // folded matrix components are column by column, stored by rows they
+   // are read across
+   std::vector<llvm::Constant*> columns;
+   int numColumns = t->IsMatrix() ? size : 1;
+   bool transpose = t->IsMatrix() && rowMajor;
+   for (int c = 0; c < numColumns; c++) {
+     std::vector<llvm::Constant*> comps;
+     for (int i = 0; i < size; i++) {
+       int k = transpose ? i * size + c : c * size + i;
+       comps.push_back(GetScalarConstant(this, scalar, value->comps[k]));
+     }
+     columns.push_back(llvm::ConstantVector::get(comps));
+   }
+   if (!t->IsMatrix())
+     return columns[0];
+   return llvm::ConstantArray::get(llvm::cast<llvm::ArrayType>(GetType(t)), columns);
+}
 
-const char *IRGenerator::TargetTriple = "x86_64-redhat-linux-gnu";
+llvm::Function *IRGenerator::GetOrDeclareFunction(FnDecl *fn) {
+   // overloads share a name, so functions are told apart by signature
+   std::ostringstream key;
+   key << fn->GetIdentifier()->GetName();
+   List<VarDecl*> *formals = fn->GetFormals();
+   for (int i = 0; i < formals->NumElements(); i++)
+     key << (i ? "," : "(") << formals->Nth(i)->GetType();
+   key << ")";
+
+   llvm::Function *&f = functions[key.str()];
+   if (f == NULL) {
+     std::vector<llvm::Type*> argTypes;
+     for (int i = 0; i < formals->NumElements(); i++)
+       argTypes.push_back(GetType(formals->Nth(i)->GetType()));
+     llvm::FunctionType *fnTy = llvm::FunctionType::get(GetType(fn->GetType()), argTypes, false);
+     // a later overload of a name already in the module gets a numbered name
+     f = llvm::Function::Create(fnTy, llvm::Function::ExternalLinkage,
+                                fn->GetIdentifier()->GetName(), module);
+     for (int i = 0; i < formals->NumElements(); i++)
+       f->getArg(i)->setName(formals->Nth(i)->GetIdentifier()->GetName());
+     // the code generator and the vectorizers read the target from here
+     f->addFnAttr("target-cpu", targetCPU);
+     if (!targetFeatures.empty())
+       f->addFnAttr("target-features", targetFeatures);
+   }
+   return f;
+}
+
+llvm::Value *IRGenerator::Splat(llvm::Value *scalar, int n) {
+   if (llvm::Constant *c = llvm::dyn_cast<llvm::Constant>(scalar))
+     return llvm::ConstantVector::getSplat(llvm::ElementCount::getFixed(n), c);
+   return builder->CreateVectorSplat(n, scalar, "splat");
+}
+
+llvm::Value *IRGenerator::Convert(llvm::Value *v, Type *from, Type *to) {
+   Type *src = from->GetScalarType(), *dst = to->GetScalarType();
+   if (src == dst || (src == Type::intType && dst == Type::uintType) ||
+       (src == Type::uintType && dst == Type::intType))
+     return v;
+
+   llvm::Type *ty = GetType(Type::GetVectorType(dst, from->GetVectorSize()));
+   if (dst == Type::boolType) {
+     llvm::Constant *zero = llvm::Constant::getNullValue(v->getType());
+     if (src == Type::floatType)
+       return builder->CreateFCmpUNE(v, zero);
+     return builder->CreateICmpNE(v, zero);
+   }
+   llvm::Instruction::CastOps op;
+   if (dst == Type::floatType)
+     op = (src == Type::intType) ? llvm::Instruction::SIToFP : llvm::Instruction::UIToFP;
+   else if (src == Type::floatType)
+     op = (dst == Type::intType) ? llvm::Instruction::FPToSI : llvm::Instruction::FPToUI;
+   else
+     op = llvm::Instruction::ZExt;   // bool to int or uint
+   return builder->CreateCast(op, v, ty);
+}
+
+void IRGenerator::DeclareLocal(Decl *var) {
+   currentDef[var];
+}
+
+void IRGenerator::WriteLocal(Decl *var, llvm::Value *value) {
+   currentDef[var][GetBasicBlock()] = value;
+}
+
+llvm::Value *IRGenerator::ReadLocal(Decl *var, llvm::Type *ty) {
+   return ReadLocal(var, ty, GetBasicBlock());
+}
+
+// an empty phi at the top of bb, which may already hold code
+static llvm::PHINode *NewPhi(llvm::Type *ty, llvm::BasicBlock *bb) {
+   llvm::IRBuilder<> top(bb, bb->begin());
+   return top.CreatePHI(ty, 0);
+}
+
+llvm::Value *IRGenerator::ReadLocal(Decl *var, llvm::Type *ty, llvm::BasicBlock *bb) {
+   BlockDefs &defs = currentDef[var];
+   BlockDefs::iterator it = defs.find(bb);
+   if (it != defs.end() && it->second != NULL)
+     return it->second;
+
+   llvm::Value *value;
+   if (sealedBlocks.count(bb) == 0) {
+     // more predecessors may come, the phi is completed by SealBlock()
+     llvm::PHINode *phi = NewPhi(ty, bb);
+     incompletePhis[bb].push_back(std::make_pair(var, phi));
+     value = phi;
+   }
+   else if (llvm::pred_empty(bb))
+     value = llvm::UndefValue::get(ty);    // read before any write
+   else if (llvm::BasicBlock *pred = bb->getSinglePredecessor())
+     value = ReadLocal(var, ty, pred);
+   else {
+     // the phi is recorded first so a cycle back to this block ends at it
+     llvm::PHINode *phi = NewPhi(ty, bb);
+     currentDef[var][bb] = phi;
+     value = AddPhiOperands(var, phi);
+   }
+   currentDef[var][bb] = value;
+   return value;
+}
+
+llvm::Value *IRGenerator::AddPhiOperands(Decl *var, llvm::PHINode *phi) {
+   llvm::BasicBlock *bb = phi->getParent();
+   for (llvm::BasicBlock *pred : llvm::predecessors(bb))
+     phi->addIncoming(ReadLocal(var, phi->getType(), pred), pred);
+   return TryRemoveTrivialPhi(phi);
+}
+
+// a phi whose operands are all one value (or itself) is that value
+llvm::Value *IRGenerator::TryRemoveTrivialPhi(llvm::PHINode *phi) {
+   llvm::Value *same = NULL;
+   for (llvm::Value *op : phi->incoming_values()) {
+     if (op == same || op == phi)
+       continue;
+     if (same != NULL)
+       return phi;
+     same = op;
+   }
+   if (same == NULL)
+     same = llvm::UndefValue::get(phi->getType());   // unreachable or read before any write
+
+   // handles, since a user may itself be removed by an earlier one
+   std::vector<llvm::WeakVH> users;
+   for (llvm::User *user : phi->users())
+     if (llvm::isa<llvm::PHINode>(user) && user != phi)
+       users.push_back(user);
+   // currentDef holds value handles, so it follows the replacement too
+   phi->replaceAllUsesWith(same);
+   phi->eraseFromParent();
+
+   // removing this phi may have made the phis that used it trivial
+   for (size_t i = 0; i < users.size(); i++)
+     if (users[i] != NULL)
+       TryRemoveTrivialPhi(llvm::cast<llvm::PHINode>(users[i]));
+   return same;
+}
+
+void IRGenerator::SealBlock(llvm::BasicBlock *bb) {
+   std::vector<std::pair<Decl*, llvm::PHINode*> > phis;
+   phis.swap(incompletePhis[bb]);
+   incompletePhis.erase(bb);
+   sealedBlocks.insert(bb);
+   for (size_t i = 0; i < phis.size(); i++)
+     AddPhiOperands(phis[i].first, phis[i].second);
+}
+
+llvm::AllocaInst *IRGenerator::CreateEntryAlloca(llvm::Type *ty, const char *name) {
+   llvm::BasicBlock &entry = currentFunc->getEntryBlock();
+   llvm::IRBuilder<> top(&entry, entry.begin());
+   return top.CreateAlloca(ty, NULL, name);
+}
+
+void IRGenerator::SetTargetCPU(const char *cpu) {
+   if (strcmp(cpu, "native") != 0) {
+     targetCPU = cpu;
+     return;
+   }
+   targetCPU = llvm::sys::getHostCPUName().str();
+   // host features go first so explicit -mattr ones override them; they
+   // are sorted so the same host always gives the same attribute string
+   llvm::StringMap<bool> hostFeatures;
+   std::vector<std::string> list;
+   if (llvm::sys::getHostCPUFeatures(hostFeatures))
+     for (llvm::StringMap<bool>::iterator it = hostFeatures.begin(); it != hostFeatures.end(); ++it)
+       list.push_back((it->second ? "+" : "-") + it->first().str());
+   std::sort(list.begin(), list.end());
+   std::string features;
+   for (size_t i = 0; i < list.size(); i++)
+     features += (i ? "," : "") + list[i];
+   if (!targetFeatures.empty())
+     features += (features.empty() ? "" : ",") + targetFeatures;
+   targetFeatures = features;
+}
+
+void IRGenerator::AddTargetFeatures(const char *features) {
+   if (!targetFeatures.empty())
+     targetFeatures += ",";
+   targetFeatures += features;
+}
+
+llvm::TargetMachine *IRGenerator::GetTargetMachine() {
+   if (targetMachine == NULL) {
+     llvm::InitializeNativeTarget();
+     std::string error;
+     const llvm::Target *target = llvm::TargetRegistry::lookupTarget(targetTriple, error);
+     if (target == NULL)
+       return NULL;
+     llvm::MCSubtargetInfo *info = target->createMCSubtargetInfo(targetTriple, "", "");
+     bool known = info->isCPUStringValid(targetCPU);
+     delete info;
+     if (!known)
+       Failure("Unknown CPU %s for %s", targetCPU.c_str(), targetTriple.c_str());
+     targetMachine = target->createTargetMachine(targetTriple, targetCPU, targetFeatures,
+                                                 llvm::TargetOptions(), llvm::None, llvm::None,
+                                                 llvm::CodeGenOpt::Level(optLevel));
+   }
+   return targetMachine;
+}
+
+// marks the SPMD variants, the only functions scalarized for the loop
+// vectorizer; scalar code keeps its vector arithmetic
+static const char *const SPMDAttribute = "glc-spmd";
+
+// runs passes over the SPMD variants only
+struct SPMDOnlyPass : llvm::PassInfoMixin<SPMDOnlyPass> {
+   llvm::FunctionPassManager passes;
+
+   llvm::PreservedAnalyses run(llvm::Function &f, llvm::FunctionAnalysisManager &fam) {
+     if (!f.hasFnAttribute(SPMDAttribute))
+       return llvm::PreservedAnalyses::all();
+     return passes.run(f, fam);
+   }
+};
 
+void IRGenerator::Optimize() {
+   FinishDebugInfo();
+   if (optLevel == 0)
+     return;
+   static const llvm::OptimizationLevel levels[] = {
+     llvm::OptimizationLevel::O0, llvm::OptimizationLevel::O1,
+     llvm::OptimizationLevel::O2, llvm::OptimizationLevel::O3
+   };
+
+   // the standard per-module pipeline (inlining, SROA, InstCombine, GVN,
+   // LICM, ...); shaders are small and loop heavy, so vectorizing and
+   // unrolling start at -O2 rather than being left to the consumer
+   llvm::PipelineTuningOptions tuning;
+   tuning.LoopUnrolling = optLevel >= 2;
+   tuning.LoopInterleaving = optLevel >= 2;
+   tuning.LoopVectorization = optLevel >= 2;
+   tuning.SLPVectorization = optLevel >= 2;
+
+   llvm::LoopAnalysisManager lam;
+   llvm::FunctionAnalysisManager fam;
+   llvm::CGSCCAnalysisManager cgam;
+   llvm::ModuleAnalysisManager mam;
+   llvm::PassBuilder builder(GetTargetMachine(), tuning);
+   // the loop vectorizer only widens scalar code, so SPMD variants have
+   // their shader's vector arithmetic split into components first
+   if (spmdWidth > 0)
+     builder.registerVectorizerStartEPCallback(
+       [](llvm::FunctionPassManager &fpm, llvm::OptimizationLevel) {
+         SPMDOnlyPass spmd;
+         spmd.passes.addPass(llvm::ScalarizerPass());
+         spmd.passes.addPass(llvm::InstCombinePass());
+         fpm.addPass(std::move(spmd));
+       });
+   builder.registerModuleAnalyses(mam);
+   builder.registerCGSCCAnalyses(cgam);
+   builder.registerFunctionAnalyses(fam);
+   builder.registerLoopAnalyses(lam);
+   builder.crossRegisterProxies(lam, fam, cgam, mam);
+
+   llvm::ModulePassManager passes = builder.buildPerModuleDefaultPipeline(levels[optLevel]);
+   passes.run(*module, mam);
+}
+
+void IRGenerator::SetDebugLocation(yyltype *loc) {
+   if (diBuilder == NULL || currentFunc == NULL || loc == NULL)
+     return;
+   llvm::DISubprogram *sp = currentFunc->getSubprogram();
+   if (sp == NULL)
+     sp = CreateSubprogram(currentFunc, loc->first_line, false);
+   builder->SetCurrentDebugLocation(llvm::DILocation::get(*context, loc->first_line, loc->first_column, sp));
+}
+
+llvm::DISubprogram *IRGenerator::CreateSubprogram(llvm::Function *f, int line, bool artificial) {
+   llvm::DISubroutineType *ty = diBuilder->createSubroutineType(diBuilder->getOrCreateTypeArray(llvm::None));
+   llvm::DISubprogram::DISPFlags spFlags = llvm::DISubprogram::SPFlagDefinition;
+   if (optLevel > 0)
+     spFlags |= llvm::DISubprogram::SPFlagOptimized;
+   llvm::DISubprogram *sp = diBuilder->createFunction(
+     diUnit->getFile(), f->getName(), "", diUnit->getFile(), line, ty, line,
+     artificial ? llvm::DINode::FlagArtificial : llvm::DINode::FlagZero, spFlags);
+   diBuilder->finalizeSubprogram(sp);
+   f->setSubprogram(sp);
+   return sp;
+}
+
+// Wrappers are built without positions and copies of a function (its
+// .uniforms and .varying parts) keep the original's, which the verifier
+// and the DWARF writer both reject. Each function that has no subprogram
+// of its own gets one, positions from elsewhere are moved into it keeping
+// their line, and calls without one get line 0 so what is inlined through
+// them keeps its lines too. Optimize() and ReleaseModule() run it first.
+void IRGenerator::FinishDebugInfo() {
+   if (diBuilder == NULL)
+     return;
+   std::set<llvm::DISubprogram*> claimed;
+   for (llvm::Function &f : *module) {
+     if (f.isDeclaration())
+       continue;
+     llvm::DISubprogram *sp = f.getSubprogram();
+     if (sp == NULL || !claimed.insert(sp).second)
+       sp = CreateSubprogram(&f, sp ? sp->getLine() : 0, sp == NULL);
+     claimed.insert(sp);
+     for (llvm::BasicBlock &bb : f)
+       for (llvm::Instruction &inst : bb) {
+         const llvm::DebugLoc &loc = inst.getDebugLoc();
+         if (loc && loc->getInlinedAtScope()->getSubprogram() != sp)
+           inst.setDebugLoc(llvm::DILocation::get(*context, loc.getLine(), loc.getCol(), sp));
+         else if (!loc && llvm::isa<llvm::CallBase>(inst) && !llvm::isa<llvm::IntrinsicInst>(inst))
+           inst.setDebugLoc(llvm::DILocation::get(*context, 0, 0, sp));
+       }
+   }
+   diBuilder->finalize();
+}
+
+llvm::MDNode *IRGenerator::GetLoopMetadata(int unrollCount, int vectorizeWidth) {
+   llvm::Type *i32 = llvm::Type::getInt32Ty(*context);
+   std::vector<llvm::Metadata*> ops(1);   // the node refers to itself first
+   if (unrollCount < 0)
+     ops.push_back(llvm::MDNode::get(*context, llvm::MDString::get(*context, "llvm.loop.unroll.full")));
+   else if (unrollCount == 1)
+     ops.push_back(llvm::MDNode::get(*context, llvm::MDString::get(*context, "llvm.loop.unroll.disable")));
+   else if (unrollCount > 1) {
+     llvm::Metadata *count[] = { llvm::MDString::get(*context, "llvm.loop.unroll.count"),
+       llvm::ConstantAsMetadata::get(llvm::ConstantInt::get(i32, unrollCount)) };
+     ops.push_back(llvm::MDNode::get(*context, count));
+   }
+   if (vectorizeWidth != 0) {
+     llvm::Metadata *enable[] = { llvm::MDString::get(*context, "llvm.loop.vectorize.enable"),
+       llvm::ConstantAsMetadata::get(llvm::ConstantInt::getTrue(*context)) };
+     ops.push_back(llvm::MDNode::get(*context, enable));
+   }
+   if (vectorizeWidth > 0) {
+     llvm::Metadata *width[] = { llvm::MDString::get(*context, "llvm.loop.vectorize.width"),
+       llvm::ConstantAsMetadata::get(llvm::ConstantInt::get(i32, vectorizeWidth)) };
+     ops.push_back(llvm::MDNode::get(*context, width));
+   }
+   if (ops.size() == 1)
+     return NULL;
+
+   llvm::MDNode *loopID = llvm::MDNode::getDistinct(*context, ops);
+   loopID->replaceOperandWith(0, loopID);
+   return loopID;
+}
+
+// SoA element of component c of lane i, as the scalar (a float, i32 or i1)
+static llvm::Value *LoadLane(IRGenerator::Builder *builder, llvm::Type *scalar,
+                             llvm::Value *soa, int c, int width, llvm::Value *lane) {
+   llvm::Type *elemTy = scalar->isFloatTy() ? scalar : builder->getInt32Ty();
+   llvm::Value *index = builder->CreateAdd(lane, builder->getInt32(c * width));
+   llvm::Value *v = builder->CreateLoad(elemTy, builder->CreateGEP(elemTy, soa, index));
+   return scalar->isIntegerTy(1) ? builder->CreateICmpNE(v, builder->getInt32(0)) : v;
+}
+
+static void StoreLane(IRGenerator::Builder *builder, llvm::Value *v,
+                      llvm::Value *soa, int c, int width, llvm::Value *lane) {
+   if (v->getType()->isIntegerTy(1))
+     v = builder->CreateZExt(v, builder->getInt32Ty());
+   llvm::Value *index = builder->CreateAdd(lane, builder->getInt32(c * width));
+   builder->CreateStore(v, builder->CreateGEP(v->getType(), soa, index));
+}
+
+// component of lane b of element a of a stored value of type t, in the
+// order GLSL lists a matrix's components
+static int ComponentOf(Type *t, bool rowMajor, int a, int b) {
+   int n = t->GetVectorSize();
+   if (!t->IsMatrix())
+     return b;
+   return rowMajor ? b * n + a : a * n + b;
+}
+
+// whether f, or a function it calls, has a loop or a switch; the loop
+// vectorizer can't turn either into masked code, so forcing it to
+// vectorize lanes running them only fails, with a warning
+static bool HasLoopOrSwitch(llvm::Function *f, std::set<llvm::Function*> &seen) {
+   if (f->isDeclaration() || !seen.insert(f).second)
+     return false;
+   llvm::SmallVector<std::pair<const llvm::BasicBlock*, const llvm::BasicBlock*>, 4> backedges;
+   llvm::FindFunctionBackedges(*f, backedges);
+   if (!backedges.empty())
+     return true;
+   for (llvm::BasicBlock &bb : *f)
+     for (llvm::Instruction &inst : bb) {
+       if (llvm::isa<llvm::SwitchInst>(inst))
+         return true;
+       llvm::CallInst *call = llvm::dyn_cast<llvm::CallInst>(&inst);
+       if (call && call->getCalledFunction() && HasLoopOrSwitch(call->getCalledFunction(), seen))
+         return true;
+     }
+   return false;
+}
+
+void IRGenerator::EmitSPMDVariant(FnDecl *fn) {
+   // only scalars, vectors and matrices have an SoA form
+   List<VarDecl*> *formals = fn->GetFormals();
+   for (int i = 0; i < formals->NumElements(); i++)
+     if (formals->Nth(i)->GetType()->GetVectorSize() == 0)
+       return;
+   Type *retType = fn->GetType();
+   bool hasResult = !retType->IsEquivalentTo(Type::voidType);
+   if (hasResult && retType->GetVectorSize() == 0)
+     return;
+
+   llvm::Function *scalarFn = GetOrDeclareFunction(fn);
+   std::vector<llvm::Type*> argTypes;
+   for (int i = 0; i <= formals->NumElements(); i++) {
+     if (i == formals->NumElements() && !hasResult)
+       break;
+     Type *t = i < formals->NumElements() ? formals->Nth(i)->GetType() : retType;
+     llvm::Type *elemTy = t->GetScalarType() == Type::floatType ? GetFloatType() : GetIntType();
+     argTypes.push_back(elemTy->getPointerTo());
+   }
+   std::ostringstream name;
+   name << scalarFn->getName().str() << ".spmd" << spmdWidth;
+   llvm::FunctionType *fnTy = llvm::FunctionType::get(builder->getVoidTy(), argTypes, false);
+   llvm::Function *f = llvm::Function::Create(fnTy, llvm::Function::ExternalLinkage, name.str(), module);
+   f->addFnAttr(SPMDAttribute);
+   for (size_t i = 0; i < argTypes.size(); i++) {
+     f->addParamAttr(i, llvm::Attribute::NoAlias);
+     f->getArg(i)->setName(i < scalarFn->arg_size() ? scalarFn->getArg(i)->getName() : "result");
+   }
+   f->addFnAttr("target-cpu", targetCPU);
+   if (!targetFeatures.empty())
+     f->addFnAttr("target-features", targetFeatures);
+
+   llvm::BasicBlock *entry = llvm::BasicBlock::Create(*context, "entry", f);
+   llvm::BasicBlock *laneBB = llvm::BasicBlock::Create(*context, "lane", f);
+   llvm::BasicBlock *exitBB = llvm::BasicBlock::Create(*context, "exit", f);
+   builder->SetInsertPoint(entry);
+   builder->CreateBr(laneBB);
+
+   // one lane per iteration, inlined, with the loop vectorized N wide
+   builder->SetInsertPoint(laneBB);
+   llvm::PHINode *lane = builder->CreatePHI(GetIntType(), 2, "lane");
+   lane->addIncoming(builder->getInt32(0), entry);
+   std::vector<llvm::Value*> args;
+   for (int i = 0; i < formals->NumElements(); i++) {
+     Type *t = formals->Nth(i)->GetType();
+     llvm::Type *ty = GetType(t);
+     int n = t->GetVectorSize();
+     if (!t->IsVector() && !t->IsMatrix()) {
+       args.push_back(LoadLane(builder, ty, f->getArg(i), 0, spmdWidth, lane));
+       continue;
+     }
+     llvm::Value *value = llvm::UndefValue::get(ty);
+     llvm::Type *vecTy = t->IsMatrix() ? ty->getArrayElementType() : ty;
+     for (int a = 0; a < (t->IsMatrix() ? n : 1); a++) {
+       llvm::Value *vec = llvm::UndefValue::get(vecTy);
+       for (int b = 0; b < n; b++) {
+         int c = ComponentOf(t, rowMajor, a, b);
+         llvm::Value *comp = LoadLane(builder, vecTy->getScalarType(), f->getArg(i), c, spmdWidth, lane);
+         vec = builder->CreateInsertElement(vec, comp, b);
+       }
+       value = t->IsMatrix() ? builder->CreateInsertValue(value, vec, a) : vec;
+     }
+     args.push_back(value);
+   }
+   llvm::CallInst *call = builder->CreateCall(scalarFn, args);
+   call->addFnAttr(llvm::Attribute::AlwaysInline);
+
+   if (hasResult) {
+     llvm::Value *result = f->getArg(argTypes.size() - 1);
+     int n = retType->GetVectorSize();
+     for (int a = 0; a < (retType->IsMatrix() ? n : 1); a++) {
+       llvm::Value *vec = retType->IsMatrix() ? builder->CreateExtractValue(call, a) : call;
+       for (int b = 0; b < n; b++) {
+         llvm::Value *comp = vec->getType()->isVectorTy() ? builder->CreateExtractElement(vec, b) : vec;
+         StoreLane(builder, comp, result, ComponentOf(retType, rowMajor, a, b), spmdWidth, lane);
+       }
+     }
+   }
+
+   llvm::Value *next = builder->CreateAdd(lane, builder->getInt32(1));
+   lane->addIncoming(next, laneBB);
+   llvm::Value *done = builder->CreateICmpEQ(next, builder->getInt32(spmdWidth));
+   llvm::BranchInst *latch = builder->CreateCondBr(done, exitBB, laneBB);
+
+   builder->SetInsertPoint(exitBB);
+   builder->CreateRetVoid();
+   builder->ClearInsertionPoint();
+
+   // unrolled before the vectorizer ran the lanes would only be left to
+   // SLP; the vector loop that remains runs once and is unrolled away.
+   // Lanes with loops or switches are left to the optimizer as they are.
+   std::set<llvm::Function*> seen;
+   if (HasLoopOrSwitch(scalarFn, seen))
+     return;
+   llvm::MDNode *hints = GetLoopMetadata(1, spmdWidth);
+   std::vector<llvm::Metadata*> ops(hints->op_begin(), hints->op_end());
+   llvm::Metadata *full = llvm::MDNode::get(*context, llvm::MDString::get(*context, "llvm.loop.unroll.full"));
+   llvm::Metadata *followup[] = { llvm::MDString::get(*context, "llvm.loop.vectorize.followup_vectorized"),
+                                  llvm::MDNode::get(*context, full) };
+   ops.push_back(llvm::MDNode::get(*context, followup));
+   llvm::MDNode *loopID = llvm::MDNode::getDistinct(*context, ops);
+   loopID->replaceOperandWith(0, loopID);
+   latch->setMetadata(llvm::LLVMContext::MD_loop, loopID);
+}
+
+// A value is uniform if it is a constant, a load of a uniform or of a
+// constant global, or an instruction on uniform operands that can run
+// anywhere without side effects. Phis are taken as varying even when
+// their operands are not, they depend on the path taken.
+static bool IsUniformInst(llvm::Instruction *inst, const std::set<llvm::Value*> &uniform,
+                          const std::set<llvm::GlobalVariable*> &uniforms) {
+   if (llvm::isa<llvm::PHINode>(inst) || llvm::isa<llvm::AllocaInst>(inst) ||
+       inst->isTerminator() || inst->mayHaveSideEffects() ||
+       !llvm::isSafeToSpeculativelyExecute(inst))
+     return false;
+   if (llvm::LoadInst *load = llvm::dyn_cast<llvm::LoadInst>(inst)) {
+     llvm::GlobalVariable *gv = llvm::dyn_cast<llvm::GlobalVariable>(
+       llvm::getUnderlyingObject(load->getPointerOperand()));
+     if (gv == NULL || (!gv->isConstant() && uniforms.count(gv) == 0))
+       return false;
+   }
+   else if (inst->mayReadFromMemory())
+     return false;
+   for (unsigned i = 0; i < inst->getNumOperands(); i++) {
+     llvm::Value *op = inst->getOperand(i);
+     if (!llvm::isa<llvm::Constant>(op) && uniform.count(op) == 0)
+       return false;
+   }
+   return true;
+}
+
+// moving values around costs about what recomputing them would
+static bool IsCheap(llvm::Instruction *inst) {
+   return llvm::isa<llvm::LoadInst>(inst) || llvm::isa<llvm::CastInst>(inst) ||
+          llvm::isa<llvm::GetElementPtrInst>(inst) || llvm::isa<llvm::InsertElementInst>(inst) ||
+          llvm::isa<llvm::ExtractElementInst>(inst) || llvm::isa<llvm::ShuffleVectorInst>(inst) ||
+          llvm::isa<llvm::InsertValueInst>(inst) || llvm::isa<llvm::ExtractValueInst>(inst);
+}
+
+llvm::Function *IRGenerator::SplitUniformWork(llvm::Function *fn, uint64_t &blockSize,
+                                              uint64_t &blockAlign) {
+   // uniform work in the functions fn calls counts too; GLSL has no
+   // recursion, the bound only guards against a program that tries
+   for (int depth = 0; depth < 16; depth++) {
+     std::vector<llvm::CallInst*> calls;
+     for (llvm::BasicBlock &bb : *fn)
+       for (llvm::Instruction &inst : bb) {
+         llvm::CallInst *call = llvm::dyn_cast<llvm::CallInst>(&inst);
+         if (call && call->getCalledFunction() && !call->getCalledFunction()->isDeclaration())
+           calls.push_back(call);
+       }
+     if (calls.empty())
+       break;
+     for (size_t i = 0; i < calls.size(); i++) {
+       llvm::InlineFunctionInfo info;
+       llvm::InlineFunction(*calls[i], info);
+     }
+   }
+
+   // definitions come before uses in reverse post order, but for phis
+   std::vector<llvm::Instruction*> order;
+   std::set<llvm::Value*> uniform, work;
+   llvm::ReversePostOrderTraversal<llvm::Function*> rpo(fn);
+   for (llvm::BasicBlock *bb : rpo)
+     for (llvm::Instruction &inst : *bb) {
+       if (!IsUniformInst(&inst, uniform, uniforms))
+         continue;
+       uniform.insert(&inst);
+       order.push_back(&inst);
+       bool worth = !IsCheap(&inst);
+       for (unsigned i = 0; i < inst.getNumOperands() && !worth; i++)
+         worth = work.count(inst.getOperand(i)) != 0;
+       if (worth)
+         work.insert(&inst);
+     }
+
+   // the block holds the largest uniform values with a varying user
+   std::vector<llvm::Instruction*> hoisted;
+   std::vector<llvm::Type*> fields;
+   for (size_t i = 0; i < order.size(); i++) {
+     llvm::Instruction *inst = order[i];
+     if (work.count(inst) == 0)
+       continue;
+     for (llvm::User *user : inst->users())
+       if (uniform.count(user) == 0) {
+         hoisted.push_back(inst);
+         fields.push_back(inst->getType());
+         break;
+       }
+   }
+   if (hoisted.empty())
+     return NULL;
+   llvm::StructType *blockTy = llvm::StructType::get(*context, fields);
+   blockSize = module->getDataLayout().getTypeAllocSize(blockTy);
+   blockAlign = module->getDataLayout().getABITypeAlign(blockTy).value();
+   llvm::Type *bytePtr = llvm::Type::getInt8PtrTy(*context);
+   std::string name = fn->getName().str();
+
+   // <fn>.uniforms: the uniform instructions in order, straight line
+   llvm::FunctionType *initTy = llvm::FunctionType::get(builder->getVoidTy(), bytePtr, false);
+   llvm::Function *init = llvm::Function::Create(initTy, llvm::Function::ExternalLinkage,
+                                                 name + ".uniforms", module);
+   init->addParamAttr(0, llvm::Attribute::NoAlias);
+   init->addFnAttr(fn->getFnAttribute("target-cpu"));
+   if (fn->hasFnAttribute("target-features"))
+     init->addFnAttr(fn->getFnAttribute("target-features"));
+   llvm::IRBuilder<> initBuilder(llvm::BasicBlock::Create(*context, "entry", init));
+   llvm::ValueToValueMapTy initMap;
+   for (size_t i = 0; i < order.size(); i++) {
+     llvm::Instruction *copy = order[i]->clone();
+     initBuilder.Insert(copy, order[i]->getName());
+     initMap[order[i]] = copy;
+     llvm::RemapInstruction(copy, initMap, llvm::RF_NoModuleLevelChanges | llvm::RF_IgnoreMissingLocals);
+   }
+   llvm::Value *block = initBuilder.CreateBitCast(init->getArg(0), blockTy->getPointerTo());
+   for (size_t i = 0; i < hoisted.size(); i++)
+     initBuilder.CreateStore(initMap[hoisted[i]], initBuilder.CreateStructGEP(blockTy, block, i));
+   initBuilder.CreateRetVoid();
+
+   // <fn>.varying: a copy of fn loading the hoisted values on entry
+   std::vector<llvm::Type*> argTypes(fn->getFunctionType()->param_begin(),
+                                     fn->getFunctionType()->param_end());
+   argTypes.push_back(bytePtr);
+   llvm::FunctionType *varyingTy = llvm::FunctionType::get(fn->getReturnType(), argTypes, false);
+   llvm::Function *varying = llvm::Function::Create(varyingTy, llvm::Function::InternalLinkage,
+                                                    name + ".varying", module);
+   llvm::ValueToValueMapTy varyingMap;
+   for (unsigned i = 0; i < fn->arg_size(); i++) {
+     varying->getArg(i)->setName(fn->getArg(i)->getName());
+     varyingMap[fn->getArg(i)] = varying->getArg(i);
+   }
+   llvm::SmallVector<llvm::ReturnInst*, 4> returns;
+   llvm::CloneFunctionInto(varying, fn, varyingMap, llvm::CloneFunctionChangeType::LocalChangesOnly, returns);
+   llvm::Argument *blockArg = varying->getArg(fn->arg_size());
+   blockArg->setName("uniforms");
+   varying->addParamAttr(fn->arg_size(), llvm::Attribute::NoAlias);
+   varying->addParamAttr(fn->arg_size(), llvm::Attribute::ReadOnly);
+
+   llvm::IRBuilder<> entryBuilder(&*varying->getEntryBlock().getFirstInsertionPt());
+   block = entryBuilder.CreateBitCast(blockArg, blockTy->getPointerTo());
+   std::vector<llvm::Instruction*> replaced;
+   for (size_t i = 0; i < hoisted.size(); i++) {
+     llvm::Value *value = entryBuilder.CreateLoad(fields[i], entryBuilder.CreateStructGEP(blockTy, block, i),
+                                                  hoisted[i]->getName());
+     llvm::Instruction *copy = llvm::cast<llvm::Instruction>(varyingMap[hoisted[i]]);
+     copy->replaceAllUsesWith(value);
+     replaced.push_back(copy);
+   }
+   // the uniform work left without users goes, so it doesn't wait for -O
+   for (size_t i = 0; i < replaced.size(); i++)
+     llvm::RecursivelyDeleteTriviallyDeadInstructions(replaced[i]);
+   return varying;
+}
+
+static llvm::GlobalVariable *FindGlobalStore(llvm::Function *f, std::set<llvm::Function*> &seen) {
+   if (f->isDeclaration() || !seen.insert(f).second)
+     return NULL;
+   for (llvm::BasicBlock &bb : *f)
+     for (llvm::Instruction &inst : bb) {
+       llvm::Value *dest = NULL;
+       if (llvm::StoreInst *store = llvm::dyn_cast<llvm::StoreInst>(&inst))
+         dest = store->getPointerOperand();
+       else if (llvm::MemIntrinsic *mem = llvm::dyn_cast<llvm::MemIntrinsic>(&inst))
+         dest = mem->getRawDest();
+       else if (llvm::CallInst *call = llvm::dyn_cast<llvm::CallInst>(&inst)) {
+         llvm::GlobalVariable *gv = NULL;
+         if (call->getCalledFunction())
+           gv = FindGlobalStore(call->getCalledFunction(), seen);
+         if (gv != NULL)
+           return gv;
+       }
+       if (dest == NULL)
+         continue;
+       llvm::GlobalVariable *gv = llvm::dyn_cast<llvm::GlobalVariable>(llvm::getUnderlyingObject(dest));
+       if (gv != NULL)
+         return gv;
+     }
+   return NULL;
+}
+
+llvm::GlobalVariable *IRGenerator::FindGlobalStore(llvm::Function *fn) {
+   std::set<llvm::Function*> seen;
+   return ::FindGlobalStore(fn, seen);
+}
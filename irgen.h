@@ -16,31 +16,157 @@
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Instructions.h"
 #include "llvm/IR/Constants.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/ValueHandle.h"
+#include "llvm/Analysis/TargetFolder.h"
 
+#include <map>
+#include <memory>
+#include <set>
 #include <stack>
+#include <string>
+#include <vector>
 #include "ast_type.h"
 
+namespace llvm { class TargetMachine; class DIBuilder; class DICompileUnit; class DISubprogram; }
+
+struct ConstValue;
+class Decl;
+class FnDecl;
+
 class IRGenerator {
   public:
+    // all code is appended through one builder; it folds constant
+    // operands with the module's data layout instead of emitting them
+    typedef llvm::IRBuilder<llvm::TargetFolder> Builder;
+
     IRGenerator();
     ~IRGenerator();
     static IRGenerator Inst;
 
     llvm::Module   *GetOrCreateModule(const char *moduleID);
     llvm::LLVMContext *GetContext() const { return context; }
+    // hands the module and its context over, to a JIT for instance;
+    // nothing can be emitted afterwards
+    void ReleaseModule(std::unique_ptr<llvm::Module> &mod,
+                       std::unique_ptr<llvm::LLVMContext> &ctx);
 
     // Add your helper functions here
     llvm::Function *GetFunction() const;
     void      SetFunction(llvm::Function *func);
 
+    // the builder's insertion block, code is appended at its end
     llvm::BasicBlock *GetBasicBlock() const;
     void        SetBasicBlock(llvm::BasicBlock *bb);
+    Builder    *GetBuilder() const { return builder; }
+
+    // flags put on every floating point operation built from here on,
+    // none by default
+    void SetFastMathFlags(llvm::FastMathFlags flags);
 
     llvm::Type *GetIntType() const;
     llvm::Type *GetBoolType() const;
     llvm::Type *GetFloatType() const;
 
-	llvm::Type *ast_llvm(Type* astTy, llvm::LLVMContext *context);
+    // LLVM type of an AST type: vecN, ivecN, uvecN and bvecN are <N x T>
+    // vectors, matN is an array of N column (or row) vectors <N x float>
+    llvm::Type *GetType(Type *astTy);
+    // LLVM constant of a folded value, NULL if its type has none
+    llvm::Constant *GetConstant(ConstValue *value);
+
+    // the function emitted for fn, declared on first use; a prototype
+    // and its definition share one function
+    llvm::Function *GetOrDeclareFunction(FnDecl *fn);
+
+    // a vector of n copies of scalar, appended to the current block
+    llvm::Value *Splat(llvm::Value *scalar, int n);
+    // implicit or constructor conversion of a scalar or vector value
+    llvm::Value *Convert(llvm::Value *v, Type *from, Type *to);
+
+    // Locals other than arrays are kept in SSA registers: a store is a new
+    // definition in the current block and a load finds the reaching one,
+    // placing phis at joins (Braun et al., "Simple and Efficient
+    // Construction of Static Single Assignment Form"). A block is sealed
+    // once all its predecessors are known; until then reads in it get
+    // placeholder phis that are completed when it is sealed.
+    void DeclareLocal(Decl *var);
+    bool IsLocal(Decl *var) const { return currentDef.count(var) != 0; }
+    void WriteLocal(Decl *var, llvm::Value *value);
+    llvm::Value *ReadLocal(Decl *var, llvm::Type *ty);
+    void SealBlock(llvm::BasicBlock *bb);
+
+    // stack slot in the entry block of the current function, so it is
+    // allocated once per call however often its code runs
+    llvm::AllocaInst *CreateEntryAlloca(llvm::Type *ty, const char *name = "");
+
+    // -O level, 0 to 3. Optimize() runs the matching pass pipeline over
+    // the module; at 0 it does nothing, which keeps -O0 the fastest path.
+    // Each way of output runs it once, after adding its wrappers.
+    void SetOptLevel(int level) { optLevel = level; }
+    void Optimize();
+    // code is generated for the host triple. The CPU defaults to
+    // "generic"; "native" picks the host CPU and all its features.
+    // Features are a -mattr list such as "+avx2,-fma", later ones win.
+    void SetTargetCPU(const char *cpu);
+    void AddTargetFeatures(const char *features);
+    // machine for the selected target, NULL if LLVM wasn't built for it;
+    // it supplies the data layout and the passes' cost models
+    llvm::TargetMachine *GetTargetMachine();
+
+    // whether matrices are stored as rows rather than columns
+    bool IsRowMajor() const { return rowMajor; }
+    void SetRowMajor(bool rows) { rowMajor = rows; }
+
+    // llvm.loop node carrying unroll and vectorize hints, NULL if there
+    // are none: an unroll count (1 disables, -1 unrolls fully) and a
+    // vectorize width (-1 enables it at a width of LLVM's choosing)
+    llvm::MDNode *GetLoopMetadata(int unrollCount, int vectorizeWidth);
+
+    // Line tables: with a source file named (standard input has no name
+    // of its own) every function gets a subprogram and every instruction
+    // the line it came from, so debuggers, profilers and perf's jitdump
+    // can map machine code back to the shader. Off by default.
+    void SetDebugInfo(const char *file) { debugFile = file; }
+    bool HasDebugInfo() const { return !debugFile.empty(); }
+    // position of the code emitted from here on in the current function;
+    // NULL keeps the last one
+    void SetDebugLocation(yyltype *loc);
+
+    // SPMD width, 0 (off) or 4, 8 or 16. When on, each function defined
+    // also gets a variant <name>.spmd<N> running N invocations at once:
+    //   void f.spmd8(T0 *arg0, T1 *arg1, ..., R *result)
+    // Each pointer is an SoA array of N elements per component, component
+    // after component (matrices column by column), with floats as float
+    // and int, uint and bool as int32. Globals stay shared by all lanes.
+    // The variant loops over the lanes with the scalar function inlined
+    // and the loop forced to vectorize at width N, so from -O1 on the
+    // lanes run in SIMD registers and branches become masked selects.
+    // A function with loops or switches, or calling one that has them,
+    // can't be masked that way; its lanes run one after another.
+    void SetSPMDWidth(int width) { spmdWidth = width; }
+    int GetSPMDWidth() const { return spmdWidth; }
+    void EmitSPMDVariant(FnDecl *fn);
+
+    // Uniforms are set by the host and never assigned by shader code, so
+    // whatever a function computes from uniforms and constants alone is
+    // the same for every invocation run with one set of them.
+    void AddUniform(llvm::GlobalVariable *gv) { uniforms.insert(gv); }
+    // Splits that work off fn for callers running it many times over:
+    //   void <fn>.uniforms(i8 *block)
+    // computes it once into a block of blockSize bytes, and the function
+    // returned, <fn>.varying(args..., i8 *block), is fn with those values
+    // read from the block instead. The block's fields are accessed with
+    // their natural alignment, so it must start at a multiple of
+    // blockAlign bytes. NULL if fn has no such work worth hoisting (loads
+    // and conversions alone are not). Runs before Optimize(), so fn has
+    // the functions it calls inlined first.
+    llvm::Function *SplitUniformWork(llvm::Function *fn, uint64_t &blockSize,
+                                     uint64_t &blockAlign);
+    // a global fn or a function it calls assigns, NULL if there is none.
+    // Globals are private to an invocation in GLSL but one copy here, so
+    // a function that assigns one can't run on several threads at once.
+    llvm::GlobalVariable *FindGlobalStore(llvm::Function *fn);
+
     llvm::BasicBlock *branchTarget;
     stack<llvm::BasicBlock*> continueBlockStack;
     stack<llvm::BasicBlock*> breakBlockStack;
@@ -49,13 +175,38 @@ class IRGenerator {
   private:
     llvm::LLVMContext *context;
     llvm::Module      *module;
+    std::map<std::string, llvm::Function*> functions;
 
-    // track which function or basic block is active
+    // track which function is active, the builder tracks the block
     llvm::Function    *currentFunc;
-    llvm::BasicBlock  *currentBB;
+    Builder           *builder;
+    llvm::FastMathFlags fastMath;
+
+    // SSA construction state of the current function
+    typedef std::map<llvm::BasicBlock*, llvm::WeakTrackingVH> BlockDefs;
+    std::map<Decl*, BlockDefs> currentDef;
+    std::map<llvm::BasicBlock*, std::vector<std::pair<Decl*, llvm::PHINode*> > > incompletePhis;
+    std::set<llvm::BasicBlock*> sealedBlocks;
+
+    llvm::Value *ReadLocal(Decl *var, llvm::Type *ty, llvm::BasicBlock *bb);
+    llvm::Value *AddPhiOperands(Decl *var, llvm::PHINode *phi);
+    llvm::Value *TryRemoveTrivialPhi(llvm::PHINode *phi);
+
+    std::string debugFile;
+    llvm::DIBuilder *diBuilder;
+    llvm::DICompileUnit *diUnit;
+    llvm::DISubprogram *CreateSubprogram(llvm::Function *f, int line, bool artificial);
+    void FinishDebugInfo();
+
+    bool rowMajor;
+    int optLevel;
+    int spmdWidth;
+    llvm::TargetMachine *targetMachine;
+    std::set<llvm::GlobalVariable*> uniforms;
 
-    static const char *TargetTriple;
-    static const char *TargetLayout;
+    std::string targetTriple;
+    std::string targetCPU;
+    std::string targetFeatures;
 };
 
 #endif
@@ -1,14 +1,84 @@
 /* File: main.cc
  * -------------
- * This file defines the main() routine for the program and not much else.
- * You should not need to modify this file.
+ * The glc driver: main() reads the command line, configures the code
+ * generator and runner from its options, parses and checks the program
+ * (after the prelude, if there is one) and emits it, then hands it to
+ * the mode selected: bitcode on standard output by default, or --run,
+ * --dispatch, --batch, -c or -shared. The options are described above
+ * main().
  */
- 
+
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
 #include "utility.h"
 #include "errors.h"
 #include "parser.h"
+#include "symtable.h"
+#include "irgen.h"
+#include "runner.h"
+#include "native.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/Support/raw_ostream.h"
+
+
+/* Function: CheckPrelude()
+ * ------------------------
+ * Parses and checks a file of global declarations (uniforms, consts,
+ * function prototypes) shared by a bundle of shaders, then freezes its
+ * global scope. The returned scope is immutable and every later
+ * compilation layers its own symbol table on top of it without copying.
+ */
+static ScopedTable *CheckPrelude(const char *filename)
+{
+    FILE *in = fopen(filename, "r");
+    if (in == NULL)
+        Failure("Cannot open prelude file %s", filename);
+
+    ResetScanner(in);
+    yyparse();
+    fclose(in);
+    if (ReportError::NumErrors() != 0 || parsedProgram == NULL)
+        return NULL;
+
+    parsedProgram->Check();
+    if (ReportError::NumErrors() != 0)
+        return NULL;
+    return Node::symtab->freezeGlobals();
+}
+
+
+/* Function: FastMathFlags()
+ * -------------------------
+ * The flags named by a comma separated list of LLVM's fast-math flag
+ * names (nnan, ninf, nsz, arcp, contract, afn, reassoc); "fast" sets
+ * them all.
+ */
+static llvm::FastMathFlags FastMathFlags(const char *list)
+{
+    llvm::FastMathFlags flags;
+    std::string names(list);
+    size_t start = 0;
+    while (start <= names.size()) {
+        size_t end = names.find(',', start);
+        if (end == std::string::npos)
+            end = names.size();
+        std::string name = names.substr(start, end - start);
+        if (name == "fast") flags.setFast();
+        else if (name == "nnan") flags.setNoNaNs();
+        else if (name == "ninf") flags.setNoInfs();
+        else if (name == "nsz") flags.setNoSignedZeros();
+        else if (name == "arcp") flags.setAllowReciprocal();
+        else if (name == "contract") flags.setAllowContract(true);
+        else if (name == "afn") flags.setApproxFunc();
+        else if (name == "reassoc") flags.setAllowReassoc();
+        else Failure("Unknown fast-math flag %s", name.c_str());
+        start = end + 1;
+    }
+    return flags;
+}
 
 
 /* Function: main()
@@ -17,14 +87,187 @@
  * on any debugging flags requested by the user when invoking the program.
  * InitScanner() is used to set up the scanner.
  * InitParser() is used to set up the parser. The call to yyparse() will
- * attempt to parse a complete program from the input. 
+ * attempt to parse a complete program from the input.
+ *
+ * "-prelude <file>" names a file of shared global declarations that is
+ * checked first; the program on standard input is compiled on top of it.
+ * "-matrix-layout=row|column" picks how matrices are stored (column by
+ * default). "-O0" to "-O3" set the optimization level of the bitcode
+ * written (-O0 by default). "-march=<cpu>" or "-mcpu=<cpu>" picks the
+ * CPU to tune and vectorize for, "native" for the host's, and
+ * "-mattr=<+f,-f,...>" adds or removes features on top of it.
+ * "-ffast-math" puts every fast-math flag on floating point operations,
+ * "-ffast-math=<flag,...>" only the ones listed. "-spmd=4|8|16" adds
+ * to each function a variant running that many invocations at once on
+ * SoA arrays (see IRGenerator::SetSPMDWidth). "--run <file.dat>"
+ * JIT compiles the program and makes the calls of a test harness file,
+ * printing their results, instead of writing bitcode to standard output.
+ * "--dispatch <W>x<H> <entry>" JIT compiles it and runs entry over a W
+ * by H grid on every core, writing the raw results instead (see
+ * RunDispatch), in rows or, with "-framebuffer=tiles", in the 8x8 tiles
+ * it runs and keeps them in; "-globals <file.dat>" sets globals for it
+ * from the gin: lines of a harness file. "--batch <file.glcb>" calls a
+ * function on every row of a columnar binary file (see RunBatch),
+ * printing the results or, with "-o <file.glcb>", writing them to a file
+ * of the same format. "-c" writes a native object file instead of bitcode
+ * and "-shared" a shared library, exporting C entry points (see native.h).
+ * "-jit-cache=<dir>" keeps what --run, --dispatch and --batch compile in
+ * dir and reuses it when the same code is run again,
+ * "-jit-cache-size=<MB>" caps its size (256 by default). "-perf-map" lists
+ * the functions they compile in /tmp/perf-<pid>.map for Linux perf, and
+ * "-jitdump" writes them with their line tables to a jitdump file for
+ * "perf inject --jit" (see perfmap.h). "-g" adds line tables to what is
+ * compiled, naming the source <stdin> or, with "-g=<file>", file; -jitdump
+ * implies it. These come before the debug flags.
  */
 int main(int argc, char *argv[])
 {
-    ParseCommandLine(argc, argv);
-    InitScanner();
+    const char *prelude = NULL, *harness = NULL, *dispatch = NULL, *globals = NULL, *batch = NULL;
+    const char *output = NULL;
+    int gridWidth = 0, gridHeight = 0;
+    bool tiledOutput = false, object = false, shared = false;
+    bool perfMap = false, jitdump = false;
+    const char *jitCache = NULL;
+    unsigned long long jitCacheMB = 256;
+    std::vector<char *> args(argv, argv + argc);
+    while (args.size() > 1) {
+        if (args.size() > 2 && strcmp(args[1], "-prelude") == 0) {
+            prelude = args[2];
+            args.erase(args.begin() + 1, args.begin() + 3);
+        }
+        else if (args.size() > 2 && strcmp(args[1], "--run") == 0) {
+            harness = args[2];
+            args.erase(args.begin() + 1, args.begin() + 3);
+        }
+        else if (args.size() > 3 && strcmp(args[1], "--dispatch") == 0) {
+            char rest;
+            if (sscanf(args[2], "%dx%d%c", &gridWidth, &gridHeight, &rest) != 2 ||
+                gridWidth <= 0 || gridHeight <= 0)
+                Failure("Unknown grid size %s, expected <width>x<height>", args[2]);
+            dispatch = args[3];
+            args.erase(args.begin() + 1, args.begin() + 4);
+        }
+        else if (args.size() > 2 && strcmp(args[1], "--batch") == 0) {
+            batch = args[2];
+            args.erase(args.begin() + 1, args.begin() + 3);
+        }
+        else if (args.size() > 2 && strcmp(args[1], "-o") == 0) {
+            output = args[2];
+            args.erase(args.begin() + 1, args.begin() + 3);
+        }
+        else if (args.size() > 2 && strcmp(args[1], "-globals") == 0) {
+            globals = args[2];
+            args.erase(args.begin() + 1, args.begin() + 3);
+        }
+        else if (strcmp(args[1], "-c") == 0 || strcmp(args[1], "-shared") == 0) {
+            object = true;
+            shared = strcmp(args[1], "-shared") == 0;
+            args.erase(args.begin() + 1);
+        }
+        else if (strncmp(args[1], "-jit-cache=", 11) == 0) {
+            jitCache = args[1] + 11;
+            args.erase(args.begin() + 1);
+        }
+        else if (strncmp(args[1], "-jit-cache-size=", 16) == 0) {
+            char *end;
+            jitCacheMB = strtoull(args[1] + 16, &end, 10);
+            if (*end != '\0' || end == args[1] + 16)
+                Failure("Unknown cache size %s, expected megabytes", args[1] + 16);
+            args.erase(args.begin() + 1);
+        }
+        else if (strcmp(args[1], "-perf-map") == 0 || strcmp(args[1], "-jitdump") == 0) {
+            perfMap |= strcmp(args[1], "-perf-map") == 0;
+            jitdump |= strcmp(args[1], "-jitdump") == 0;
+            args.erase(args.begin() + 1);
+        }
+        else if (strcmp(args[1], "-g") == 0 || strncmp(args[1], "-g=", 3) == 0) {
+            Node::irgen->SetDebugInfo(args[1][2] ? args[1] + 3 : "<stdin>");
+            args.erase(args.begin() + 1);
+        }
+        else if (strncmp(args[1], "-framebuffer=", 13) == 0) {
+            const char *layout = args[1] + 13;
+            if (strcmp(layout, "rows") != 0 && strcmp(layout, "tiles") != 0)
+                Failure("Unknown framebuffer layout %s, expected rows or tiles", layout);
+            tiledOutput = strcmp(layout, "tiles") == 0;
+            args.erase(args.begin() + 1);
+        }
+        else if (strncmp(args[1], "-matrix-layout=", 15) == 0) {
+            const char *layout = args[1] + 15;
+            if (strcmp(layout, "row") != 0 && strcmp(layout, "column") != 0)
+                Failure("Unknown matrix layout %s, expected row or column", layout);
+            Node::irgen->SetRowMajor(strcmp(layout, "row") == 0);
+            args.erase(args.begin() + 1);
+        }
+        else if (strncmp(args[1], "-O", 2) == 0) {
+            const char *level = args[1] + 2;
+            if (strlen(level) != 1 || level[0] < '0' || level[0] > '3')
+                Failure("Unknown optimization level %s, expected -O0 to -O3", args[1]);
+            Node::irgen->SetOptLevel(level[0] - '0');
+            args.erase(args.begin() + 1);
+        }
+        else if (strncmp(args[1], "-march=", 7) == 0 || strncmp(args[1], "-mcpu=", 6) == 0) {
+            Node::irgen->SetTargetCPU(strchr(args[1], '=') + 1);
+            args.erase(args.begin() + 1);
+        }
+        else if (strncmp(args[1], "-mattr=", 7) == 0) {
+            Node::irgen->AddTargetFeatures(args[1] + 7);
+            args.erase(args.begin() + 1);
+        }
+        else if (strncmp(args[1], "-spmd=", 6) == 0) {
+            int width = atoi(args[1] + 6);
+            if (width != 4 && width != 8 && width != 16)
+                Failure("Unknown SPMD width %s, expected 4, 8 or 16", args[1] + 6);
+            Node::irgen->SetSPMDWidth(width);
+            args.erase(args.begin() + 1);
+        }
+        else if (strcmp(args[1], "-ffast-math") == 0 || strncmp(args[1], "-ffast-math=", 12) == 0) {
+            Node::irgen->SetFastMathFlags(FastMathFlags(args[1][11] ? args[1] + 12 : "fast"));
+            args.erase(args.begin() + 1);
+        }
+        else
+            break;
+    }
+    if (output && !batch)
+        Failure("-o only names the results file of --batch");
+    if (jitCache)
+        SetJITCache(jitCache, jitCacheMB << 20);
+    if (jitdump && !Node::irgen->HasDebugInfo())
+        Node::irgen->SetDebugInfo("<stdin>");
+    SetJITProfiling(perfMap, jitdump);
+    ParseCommandLine(args.size(), &args[0]);
     InitParser();
+
+    if (prelude) {
+        ScopedTable *shared = CheckPrelude(prelude);
+        if (shared == NULL)
+            return -1;
+        Node::symtab = new SymbolTable(shared);
+        parsedProgram = NULL;
+        ResetScanner(stdin);
+    }
+    else
+        InitScanner();
+
     yyparse();
-    return (ReportError::NumErrors() == 0? 0 : -1);
-}
+    if (ReportError::NumErrors() == 0 && parsedProgram != NULL)
+        parsedProgram->Check();
+    if (ReportError::NumErrors() != 0)
+        return -1;
+    if (parsedProgram == NULL)
+        return 0;
+    parsedProgram->Emit();
+    if (harness)
+        return RunHarness(harness);
+    if (dispatch)
+        return RunDispatch(gridWidth, gridHeight, dispatch, tiledOutput, globals);
+    if (batch)
+        return RunBatch(batch, output);
+    if (object)
+        return WriteNative(parsedProgram, shared);
 
+    // optimized here, so whatever loads the bitcode needn't
+    Node::irgen->Optimize();
+    // write the BC into standard output
+    llvm::WriteBitcodeToFile(*Node::irgen->GetOrCreateModule("glc.bc"), llvm::outs());
+    return 0;
+}
@@ -0,0 +1,168 @@
+/* File: native.cc
+ * ---------------
+ * Native object and shared library output. The C entry points are the
+ * slot wrappers "glc --run" calls, exported under stable names.
+ */
+
+#include <stdio.h>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "native.h"
+#include "runner.h"
+#include "utility.h"
+#include "ast_decl.h"
+#include "ast_stmt.h"
+#include "ast_type.h"
+#include "irgen.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/IR/LegacyPassManager.h"
+#include "llvm/MC/TargetRegistry.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Program.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Target/TargetMachine.h"
+
+// glc_<name>__<type>_<type>..., or glc_<name>__void
+static std::string EntryName(FnDecl *fn) {
+    std::ostringstream name;
+    name << "glc_" << fn->GetIdentifier() << "__";
+    List<VarDecl*> *formals = fn->GetFormals();
+    for (int i = 0; i < formals->NumElements(); i++)
+        name << (i ? "_" : "") << formals->Nth(i)->GetType();
+    if (formals->NumElements() == 0)
+        name << "void";
+    return name.str();
+}
+
+// "vec4 shade(vec2)"
+static std::string SignatureOf(FnDecl *fn) {
+    std::ostringstream sig;
+    sig << fn->GetType() << " " << fn->GetIdentifier() << "(";
+    List<VarDecl*> *formals = fn->GetFormals();
+    for (int i = 0; i < formals->NumElements(); i++)
+        sig << (i ? ", " : "") << formals->Nth(i)->GetType();
+    sig << ")";
+    return sig.str();
+}
+
+// only scalars, vectors and matrices have a slot form
+static bool HasSlotForm(FnDecl *fn) {
+    List<VarDecl*> *formals = fn->GetFormals();
+    for (int i = 0; i < formals->NumElements(); i++)
+        if (formals->Nth(i)->GetType()->GetVectorSize() == 0)
+            return false;
+    return fn->GetType()->IsEquivalentTo(Type::voidType) || fn->GetType()->GetVectorSize() > 0;
+}
+
+static void EmitEntryPoints(Program *program) {
+    llvm::Module *module = Node::irgen->GetOrCreateModule("glc.bc");
+    IRGenerator::Builder *builder = Node::irgen->GetBuilder();
+    llvm::Type *i32 = builder->getInt32Ty();
+    llvm::Type *bytePtr = builder->getInt8PtrTy();
+    llvm::Type *callTy = llvm::FunctionType::get(builder->getVoidTy(),
+        std::vector<llvm::Type*>(2, i32->getPointerTo()), false)->getPointerTo();
+    llvm::StructType *entryTy = llvm::StructType::create(*Node::irgen->GetContext(),
+        std::vector<llvm::Type*>({ bytePtr, bytePtr, callTy, i32, i32 }), "glc_entry");
+
+    std::vector<llvm::Constant*> entries;
+    List<Decl*> *decls = program->GetDecls();
+    for (int i = 0; i < decls->NumElements(); i++) {
+        FnDecl *fn = dynamic_cast<FnDecl*>(decls->Nth(i));
+        if (fn == NULL || fn->GetBody() == NULL || !HasSlotForm(fn))
+            continue;
+        llvm::Function *wrapper = module->getFunction(EmitCallWrapper(fn));
+        llvm::GlobalAlias *entry = llvm::GlobalAlias::create(EntryName(fn), wrapper);
+
+        int argSlots = 0;
+        List<VarDecl*> *formals = fn->GetFormals();
+        for (int j = 0; j < formals->NumElements(); j++)
+            argSlots += NumComponents(formals->Nth(j)->GetType());
+        int resultSlots = fn->GetType()->IsEquivalentTo(Type::voidType) ? 0 : NumComponents(fn->GetType());
+        std::ostringstream name;
+        name << fn->GetIdentifier();
+        llvm::Constant *fields[] = {
+            builder->CreateGlobalStringPtr(name.str(), "", 0, module),
+            builder->CreateGlobalStringPtr(SignatureOf(fn), "", 0, module),
+            entry, builder->getInt32(argSlots), builder->getInt32(resultSlots)
+        };
+        entries.push_back(llvm::ConstantStruct::get(entryTy, fields));
+    }
+
+    llvm::ArrayType *tableTy = llvm::ArrayType::get(entryTy, entries.size());
+    new llvm::GlobalVariable(*module, tableTy, true, llvm::GlobalValue::ExternalLinkage,
+                             llvm::ConstantArray::get(tableTy, entries), "glc_entries");
+    new llvm::GlobalVariable(*module, i32, true, llvm::GlobalValue::ExternalLinkage,
+                             builder->getInt32(entries.size()), "glc_num_entries");
+}
+
+// position independent, so the object can go into a shared library
+static void EmitObject(llvm::raw_pwrite_stream &out) {
+    llvm::TargetMachine *tm = Node::irgen->GetTargetMachine();
+    if (tm == NULL)
+        Failure("LLVM was built without a code generator for this host");
+    llvm::InitializeNativeTargetAsmPrinter();
+    std::unique_ptr<llvm::TargetMachine> pic(tm->getTarget().createTargetMachine(
+        tm->getTargetTriple().str(), tm->getTargetCPU(), tm->getTargetFeatureString(),
+        tm->Options, llvm::Reloc::PIC_, llvm::None, tm->getOptLevel()));
+
+    llvm::Module *module = Node::irgen->GetOrCreateModule("glc.bc");
+    llvm::legacy::PassManager passes;
+    if (pic->addPassesToEmitFile(passes, out, NULL, llvm::CGFT_ObjectFile))
+        Failure("Cannot emit object files for %s", tm->getTargetTriple().str().c_str());
+    passes.run(*module);
+}
+
+static std::string TempFile(const char *suffix) {
+    llvm::SmallString<128> path;
+    if (llvm::sys::fs::createTemporaryFile("glc", suffix, path))
+        Failure("Cannot create a temporary file");
+    return path.str().str();
+}
+
+int WriteNative(Program *program, bool shared) {
+    EmitEntryPoints(program);
+    // once, with the entry points there to have their callee inlined
+    Node::irgen->Optimize();
+
+    if (!shared) {
+        llvm::SmallVector<char, 0> object;
+        llvm::raw_svector_ostream out(object);
+        EmitObject(out);
+        fwrite(object.data(), 1, object.size(), stdout);
+        fflush(stdout);
+        return 0;
+    }
+
+    std::string objectPath = TempFile("o"), libraryPath = TempFile("so");
+    {
+        std::error_code error;
+        llvm::raw_fd_ostream out(objectPath, error);
+        if (error)
+            Failure("Cannot write %s: %s", objectPath.c_str(), error.message().c_str());
+        EmitObject(out);
+    }
+
+    // built-ins may call into libm
+    llvm::ErrorOr<std::string> cc = llvm::sys::findProgramByName("cc");
+    if (!cc)
+        Failure("Cannot find cc to link a shared library");
+    llvm::StringRef args[] = { *cc, "-shared", "-o", libraryPath, objectPath, "-lm" };
+    std::string error;
+    int status = llvm::sys::ExecuteAndWait(*cc, args, llvm::None, {}, 0, 0, &error);
+    llvm::sys::fs::remove(objectPath);
+    if (status != 0) {
+        llvm::sys::fs::remove(libraryPath);
+        Failure("Cannot link a shared library%s%s", error.empty() ? "" : ": ", error.c_str());
+    }
+
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer> > library = llvm::MemoryBuffer::getFile(libraryPath);
+    llvm::sys::fs::remove(libraryPath);
+    if (!library)
+        Failure("Cannot read %s", libraryPath.c_str());
+    fwrite((*library)->getBufferStart(), 1, (*library)->getBufferSize(), stdout);
+    fflush(stdout);
+    return 0;
+}
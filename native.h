@@ -0,0 +1,40 @@
+/**
+ * File: native.h
+ * --------------
+ * Ahead of time output, for "glc -c" and "glc -shared": the program as a
+ * native object file or shared library for the generator's target, so a
+ * host links or dlopens it and needs no LLVM at run time.
+ *
+ * Besides the program's own symbols, one C entry point is exported per
+ * function defined, under a name that only depends on its signature:
+ *
+ *     void glc_<name>__<type>_<type>...(const int32_t *args, int32_t *result)
+ *     void glc_<name>__void(const int32_t *args, int32_t *result)
+ *
+ * the second for a function without parameters. Arguments and result are
+ * passed as 32-bit slots, one per component, the way "glc --run" passes
+ * them. GLSL reserves identifiers containing "__", so these never clash
+ * with the program's own. They are also listed in a table, for hosts
+ * looking functions up by name:
+ *
+ *     struct glc_entry {
+ *         const char *name;        // "shade"
+ *         const char *signature;   // "vec4 shade(vec2)"
+ *         void (*call)(const int32_t *args, int32_t *result);
+ *         int32_t argSlots, resultSlots;
+ *     };
+ *     extern const struct glc_entry glc_entries[];
+ *     extern const int32_t glc_num_entries;
+ */
+
+#ifndef _H_native
+#define _H_native
+
+class Program;
+
+// writes the emitted module to standard output as a relocatable object,
+// or with shared as a shared library linked by the system's cc; returns
+// the exit status
+int WriteNative(Program *program, bool shared);
+
+#endif
@@ -0,0 +1,114 @@
+/* File: objcache.cc
+ * -----------------
+ * Implementation of the on-disk JIT object cache.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include "objcache.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/BinaryFormat/Magic.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/SHA1.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Target/TargetMachine.h"
+
+ObjectFileCache::ObjectFileCache(const std::string &d, uint64_t max, llvm::TargetMachine *tm) :
+    dir(d),
+    maxBytes(max)
+{
+    llvm::raw_string_ostream s(target);
+    s << tm->getTargetTriple().str() << "\n" << tm->getTargetCPU() << "\n"
+      << tm->getTargetFeatureString() << "\n" << (int)tm->getOptLevel() << "\n";
+    s.flush();
+    // a cache that can't be created just never hits
+    llvm::sys::fs::create_directories(dir);
+}
+
+std::string ObjectFileCache::PathOf(const llvm::Module *module) {
+    std::string &key = keys[module];
+    if (key.empty()) {
+        llvm::SmallVector<char, 0> bitcode;
+        llvm::raw_svector_ostream out(bitcode);
+        out << target;
+        llvm::WriteBitcodeToFile(*module, out);
+        key = llvm::toHex(llvm::SHA1::hash(llvm::arrayRefFromStringRef(out.str())), true);
+    }
+    llvm::SmallString<256> path(dir);
+    llvm::sys::path::append(path, key + ".o");
+    return path.str().str();
+}
+
+std::unique_ptr<llvm::MemoryBuffer> ObjectFileCache::getObject(const llvm::Module *module) {
+    std::string path = PathOf(module);
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer> > object =
+        llvm::MemoryBuffer::getFile(path, false, false);
+    // anything but an object, say a file left by another tool, is a miss
+    if (!object || llvm::identify_magic((*object)->getBuffer()) == llvm::file_magic::unknown)
+        return NULL;
+    // most recently used from now
+    int fd;
+    if (!llvm::sys::fs::openFileForWrite(path, fd, llvm::sys::fs::CD_OpenExisting,
+                                         llvm::sys::fs::OF_Append)) {
+        llvm::sys::fs::setLastAccessAndModificationTime(fd, std::chrono::system_clock::now());
+        llvm::sys::Process::SafelyCloseFileDescriptor(fd);
+    }
+    return std::move(*object);
+}
+
+void ObjectFileCache::notifyObjectCompiled(const llvm::Module *module, llvm::MemoryBufferRef object) {
+    std::string path = PathOf(module);
+    int fd;
+    llvm::SmallString<256> temp;
+    if (llvm::sys::fs::createUniqueFile(path + ".%%%%%%.tmp", fd, temp))
+        return;
+    {
+        llvm::raw_fd_ostream out(fd, true);
+        out << object.getBuffer();
+        out.close();
+        if (out.has_error()) {
+            out.clear_error();
+            llvm::sys::fs::remove(temp);
+            return;
+        }
+    }
+    if (llvm::sys::fs::rename(temp, path))
+        llvm::sys::fs::remove(temp);
+    Evict();
+}
+
+void ObjectFileCache::Evict() {
+    struct Entry {
+        std::string path;
+        uint64_t size;
+        llvm::sys::TimePoint<> used;
+        bool operator<(const Entry &other) const { return used < other.used; }
+    };
+    std::vector<Entry> entries;
+    uint64_t total = 0;
+    std::error_code error;
+    for (llvm::sys::fs::directory_iterator it(dir, error), end; it != end && !error; it.increment(error)) {
+        if (llvm::sys::path::extension(it->path()) != ".o")
+            continue;
+        llvm::sys::fs::file_status status;
+        if (llvm::sys::fs::status(it->path(), status))
+            continue;
+        Entry e = { it->path(), status.getSize(), status.getLastModificationTime() };
+        entries.push_back(e);
+        total += e.size;
+    }
+
+    std::sort(entries.begin(), entries.end());
+    for (size_t i = 0; i < entries.size() && total > maxBytes; i++) {
+        // another run may have removed it first
+        if (!llvm::sys::fs::remove(entries[i].path))
+            total -= entries[i].size;
+    }
+}
@@ -0,0 +1,47 @@
+/**
+ * File: objcache.h
+ * ----------------
+ * An on-disk cache of the objects the JIT compiles, so running the same
+ * shader again skips the code generator. Objects are keyed by a hash of
+ * the module's bitcode (after optimization) together with the target
+ * triple, CPU, features and code generation level, so any change to the
+ * shader or the options compiles afresh.
+ *
+ * Each object is one file, <key>.o, in the cache directory. It is
+ * written to a unique temporary name and renamed into place, so
+ * concurrent runs sharing a directory never see half an object. A hit
+ * touches the file; after each store the least recently used objects are
+ * removed until the directory is under its size limit.
+ */
+
+#ifndef _H_objcache
+#define _H_objcache
+
+#include <stdint.h>
+#include <map>
+#include <string>
+#include "llvm/ExecutionEngine/ObjectCache.h"
+
+namespace llvm { class TargetMachine; }
+
+class ObjectFileCache : public llvm::ObjectCache {
+  public:
+    // objects for code generated by tm, kept in dir (created if need be)
+    // up to a total of maxBytes
+    ObjectFileCache(const std::string &dir, uint64_t maxBytes, llvm::TargetMachine *tm);
+
+    void notifyObjectCompiled(const llvm::Module *module, llvm::MemoryBufferRef object);
+    std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module *module);
+
+  private:
+    std::string dir;
+    uint64_t maxBytes;
+    std::string target;   // what besides the bitcode goes into a key
+    // keys are taken before code generation, which may change the module
+    std::map<const llvm::Module*, std::string> keys;
+
+    std::string PathOf(const llvm::Module *module);
+    void Evict();
+};
+
+#endif
@@ -35,4 +35,6 @@
 int yyparse();              // Defined in the generated y.tab.c file
 void InitParser();          // Defined in parser.y
 
+extern Program *parsedProgram; // set by yyparse() when parsing succeeds
+
 #endif
@@ -22,6 +22,8 @@
 
 void yyerror(const char *msg); // standard error-handling routine
 
+Program *parsedProgram = NULL; // result of the last successful yyparse()
+
 %}
 
 /* The section before the first %% is the Definitions section of the yacc
@@ -86,6 +88,7 @@ void yyerror(const char *msg); // standard error-handling routine
 %token   <floatConstant> T_FloatConstant
 %token   <boolConstant> T_BoolConstant
 %token   <identifier> T_FieldSelection
+%token   <identifier> T_Pragma
 
 %nonassoc LOWEST
 %nonassoc LOWER_THAN_ELSE
@@ -138,12 +141,13 @@ Program   :    DeclList            {
                                        * yacc to set up yylloc. You can remove 
                                        * it once you have other uses of @n*/
                                       Program *program = new Program($1);
-                                      // if no errors, advance to next phase
+                                      // if no errors, hand the tree to main() for
+                                      // checking and code generation
                                       if (ReportError::NumErrors() == 0) {
                                           if ( IsDebugOn("dumpAST") ) {
                                             program->Print(0);
                                           }
-                                          program->Emit();
+                                          parsedProgram = program;
                                       }
                                     }
           ;
@@ -214,16 +218,26 @@ SingleDecl    : TypeDecl T_Identifier
                             Identifier *id = new Identifier(yylloc, (const char *)$3); 
                             $$ = new VarDecl(id, $2, $1, $5);
                          }
-              | TypeDecl T_Identifier T_LeftBracket T_IntConstant T_RightBracket 
+              | TypeDecl T_Identifier T_LeftBracket Expression T_RightBracket 
                          { 
                             Identifier *id = new Identifier(@2, (const char *)$2);
                             $$ = new VarDecl(id, new ArrayType(@1, $1, $4));
                          }
-              | TypeQualify TypeDecl T_Identifier T_LeftBracket T_IntConstant T_RightBracket 
+              | TypeQualify TypeDecl T_Identifier T_LeftBracket Expression T_RightBracket 
                          { 
                             Identifier *id = new Identifier(@3, $3);
                             $$ = new VarDecl(id, new ArrayType(@2, $2, $5), $1);
                          }
+              | TypeDecl T_Identifier T_LeftBracket Expression T_RightBracket T_Equal Initializer
+                         { 
+                            Identifier *id = new Identifier(@2, (const char *)$2);
+                            $$ = new VarDecl(id, new ArrayType(@1, $1, $4), $7);
+                         }
+              | TypeQualify TypeDecl T_Identifier T_LeftBracket Expression T_RightBracket T_Equal Initializer
+                         { 
+                            Identifier *id = new Identifier(@3, $3);
+                            $$ = new VarDecl(id, new ArrayType(@2, $2, $5), $1, $8);
+                         }
 
               ;
 
@@ -272,6 +286,15 @@ SingleStatement   : T_Semicolon      { $$ = new EmptyExpr();  }
                   | JumpStmt         { $$ = $1; }
                   | WhileStmt        { $$ = $1; }
                   | ForStmt          { $$ = $1; }
+                  | T_Pragma Statement
+                                     {
+                                       // the only pragmas recognized are hints on loops
+                                       LoopStmt *loop = dynamic_cast<LoopStmt*>($2);
+                                       if (loop == NULL || !loop->AddPragma($1))
+                                         ReportError::Formatted(&@1,
+                                           "#pragma %s is not a hint on the loop following it", $1);
+                                       $$ = $2;
+                                     }
                   ;
 
 SelectionStmt     : T_If T_LeftParen Expression T_RightParen Statement T_Else Statement
@@ -319,6 +342,9 @@ PrimaryExpr        : T_Identifier    { Identifier *id = new Identifier(yylloc, (
 
 FunctionCallExpr     : FunctionCallHeaderWithParameters T_RightParen { $$ = $1; }
                      | FunctionCallHeaderNoParameters T_RightParen   { $$ = $1; }
+                     | TypeDecl T_LeftParen ArgumentList T_RightParen { $$ = new ConstructorExpr(@1, $1, $3); }
+                     | TypeDecl T_LeftBracket Expression T_RightBracket T_LeftParen ArgumentList T_RightParen
+                                       { $$ = new ConstructorExpr(@1, new ArrayType(@1, $1, $3), $6); }
                      ;
 
 FunctionCallHeaderNoParameters     : FunctionIdentifier T_LeftParen T_Void { $$ = new Call(@1, NULL, $1, new List<Expr*>); }
@@ -0,0 +1,53 @@
+/* File: perfmap.cc
+ * ----------------
+ * Implementation of the perf map writer.
+ */
+
+#include <unistd.h>
+#include "perfmap.h"
+#include "utility.h"
+#include "llvm/Object/SymbolSize.h"
+
+PerfMapListener::PerfMapListener() {
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/perf-%d.map", (int)getpid());
+    map = fopen(path, "a");
+    if (map == NULL)
+        Failure("Cannot open perf map %s", path);
+}
+
+PerfMapListener::~PerfMapListener() {
+    fclose(map);
+}
+
+void PerfMapListener::notifyObjectLoaded(ObjectKey key, const llvm::object::ObjectFile &obj,
+                                         const llvm::RuntimeDyld::LoadedObjectInfo &info) {
+    // the copy for debuggers has its sections at the addresses they were
+    // loaded to, so its symbols' addresses are the ones code runs at
+    llvm::object::OwningBinary<llvm::object::ObjectFile> loaded = info.getObjectForDebug(obj);
+    if (loaded.getBinary() == NULL)
+        return;
+
+    std::lock_guard<std::mutex> guard(lock);
+    std::vector<std::pair<llvm::object::SymbolRef, uint64_t> > sizes =
+        llvm::object::computeSymbolSizes(*loaded.getBinary());
+    for (size_t i = 0; i < sizes.size(); i++) {
+        llvm::object::SymbolRef sym = sizes[i].first;
+        llvm::Expected<llvm::object::SymbolRef::Type> type = sym.getType();
+        if (!type || *type != llvm::object::SymbolRef::ST_Function || sizes[i].second == 0) {
+            if (!type)
+                llvm::consumeError(type.takeError());
+            continue;
+        }
+        llvm::Expected<llvm::StringRef> name = sym.getName();
+        llvm::Expected<uint64_t> address = sym.getAddress();
+        if (!name || !address) {
+            llvm::consumeError(name.takeError());
+            llvm::consumeError(address.takeError());
+            continue;
+        }
+        fprintf(map, "%llx %llx %s\n", (unsigned long long)*address,
+                (unsigned long long)sizes[i].second, name->str().c_str());
+    }
+    fflush(map);
+}
@@ -0,0 +1,37 @@
+/**
+ * File: perfmap.h
+ * ---------------
+ * Tells Linux perf where JIT compiled shaders are. perf finds no symbols
+ * for code a process generates at run time; it looks them up instead in
+ * /tmp/perf-<pid>.map, one "<start> <size> <name>" line (hex address and
+ * size) per function, which "perf report" and "perf top" read on their
+ * own with no extra step.
+ *
+ * A map names functions only. For source lines, the JIT also registers
+ * LLVM's jitdump writer (see SetJITProfiling in runner.h), whose records
+ * carry the line tables of code emitted with IRGenerator::SetDebugInfo;
+ * "perf inject --jit" folds them into the profile.
+ */
+
+#ifndef _H_perfmap
+#define _H_perfmap
+
+#include <stdio.h>
+#include <mutex>
+#include "llvm/ExecutionEngine/JITEventListener.h"
+
+class PerfMapListener : public llvm::JITEventListener {
+  public:
+    // appends to the map of this process, creating it if need be
+    PerfMapListener();
+    ~PerfMapListener();
+
+    void notifyObjectLoaded(ObjectKey key, const llvm::object::ObjectFile &obj,
+                            const llvm::RuntimeDyld::LoadedObjectInfo &info);
+
+  private:
+    FILE *map;
+    std::mutex lock;   // objects may be loaded from several threads
+};
+
+#endif
@@ -0,0 +1,25 @@
+const int N = 3;
+
+float sum(float a[N]);
+
+float sum(float a[2])
+{
+  return a[0] + a[1];
+}
+
+float sum(float a[3])
+{
+  return a[0] + a[1] + a[2];
+}
+
+float total()
+{
+  float three[N];
+  float two[2];
+  three[0] = 1.0;
+  three[1] = 2.0;
+  three[2] = 3.0;
+  two[0] = 10.0;
+  two[1] = 20.0;
+  return sum(three) + sum(two) * 10.0;
+}
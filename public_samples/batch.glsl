@@ -0,0 +1,6 @@
+float gain;
+
+float weigh(float x, vec2 p)
+{
+  return x * gain + p.x - p.y;
+}
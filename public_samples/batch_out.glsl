@@ -0,0 +1,6 @@
+float gain;
+
+vec2 weigh(float x, vec2 p)
+{
+  return vec2(x * gain, p.x + p.y);
+}
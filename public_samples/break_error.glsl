@@ -0,0 +1,13 @@
+int f(int x)
+{
+  if (x > 0)
+    break;
+  continue;
+  switch (x) {
+    case 1:
+      continue;
+    default:
+      break;
+  }
+  return x;
+}
@@ -0,0 +1,67 @@
+#
+# File: call_shared.py
+#
+# Calls into a library written by "glc -shared", for the samples of
+# native output and SPMD variants (see native.h and
+# IRGenerator::SetSPMDWidth):
+#
+#   python call_shared.py <lib.so> [<fn>.spmd<N> <comps,...> <result comps>]...
+#
+# lists the library's glc_entries table, then calls each SPMD variant
+# named on N lanes at once. The variant's parameters are floats with the
+# given numbers of components; component c of parameter i is
+# i + c / 4 + lane / 2 in each lane. Each lane's result is printed next
+# to what the function's scalar entry returns for that lane's arguments.
+#
+import sys
+from ctypes import *
+
+class Entry(Structure):
+  _fields_ = [('name', c_char_p), ('signature', c_char_p), ('call', c_void_p),
+              ('argSlots', c_int32), ('resultSlots', c_int32)]
+
+Call = CFUNCTYPE(None, POINTER(c_float), POINTER(c_float))
+
+def listEntries(lib):
+  count = c_int32.in_dll(lib, 'glc_num_entries').value
+  entries = (Entry * count).in_dll(lib, 'glc_entries')
+  for e in entries:
+    print('%s: %s, %d -> %d slots' % (e.name.decode(), e.signature.decode(),
+                                      e.argSlots, e.resultSlots))
+  return entries
+
+def callSPMD(lib, entries, variant, comps, resultComps):
+  name, width = variant.split('.spmd')
+  width = int(width)
+  scalar = [e for e in entries if e.name.decode() == name][0]
+  args = []
+  for i in range(len(comps)):
+    soa = (c_float * (comps[i] * width))()
+    for c in range(comps[i]):
+      for lane in range(width):
+        soa[c * width + lane] = i + c / 4.0 + lane / 2.0
+    args.append(soa)
+  result = (c_float * (resultComps * width))()
+  lib[variant](*(args + [result]))
+  for lane in range(width):
+    slots = (c_float * max(scalar.argSlots, 1))()
+    k = 0
+    for i in range(len(comps)):
+      for c in range(comps[i]):
+        slots[k] = args[i][c * width + lane]
+        k += 1
+    expected = (c_float * resultComps)()
+    Call(scalar.call)(slots, expected)
+    got = [result[c * width + lane] for c in range(resultComps)]
+    print('%s lane %d: %s (scalar %s)' % (variant, lane, ' '.join('%g' % v for v in got),
+                                          ' '.join('%g' % v for v in expected)))
+
+def main():
+  lib = CDLL(sys.argv[1])
+  entries = listEntries(lib)
+  args = sys.argv[2:]
+  for i in range(0, len(args), 3):
+    comps = [int(n) for n in args[i + 1].split(',')]
+    callSPMD(lib, entries, args[i], comps, int(args[i + 2]))
+
+main()
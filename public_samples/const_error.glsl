@@ -0,0 +1,9 @@
+const int zero = 4 - 4;
+const int bad = 1 / zero;
+
+float sized(int n)
+{
+  float a[n];
+  float b[zero];
+  return 0.0;
+}
@@ -0,0 +1,32 @@
+const int big = 2147483647;
+const int wrapped = big + 1;
+const int n = 3 * 4 - 2;
+const float half = 1.0 / 2.0;
+const vec2 corner = vec2(n, half) * 2.0;
+
+int overflow()
+{
+  return wrapped;
+}
+
+int product()
+{
+  return n * (7 / 2);
+}
+
+float folded()
+{
+  return corner.x + corner.y + half;
+}
+
+int sized()
+{
+  float a[n / 2];
+  a[4] = 1.0;
+  return n / 2;
+}
+
+bool compare()
+{
+  return n > 9 && half < 1.0;
+}
@@ -0,0 +1,6 @@
+float bias;
+
+float shade(vec2 p)
+{
+  return p.x + p.y * 10.0 + bias;
+}
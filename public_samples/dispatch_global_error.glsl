@@ -0,0 +1,12 @@
+float sum;
+
+void add(float x)
+{
+  sum = sum + x;
+}
+
+float shade(vec2 p)
+{
+  add(p.x);
+  return sum;
+}
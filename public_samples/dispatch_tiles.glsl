@@ -0,0 +1,4 @@
+int cell(int x, int y)
+{
+  return x + y * 100;
+}
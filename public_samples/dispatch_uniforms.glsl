@@ -0,0 +1,12 @@
+uniform mat2 rot;
+uniform vec4 tint;
+uniform float scale;
+
+vec4 shade(vec2 p)
+{
+  // all but the last line only depends on uniforms, so it runs once
+  mat2 r = rot * scale;
+  vec4 base = tint * (tint.w * 2.0);
+  vec2 q = r * p;
+  return base + vec4(q, q.x + q.y, 1.0);
+}
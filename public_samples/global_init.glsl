@@ -0,0 +1,9 @@
+const float k = 2.0;
+float ok = k * 3.0;
+vec2 folded = vec2(1, k);
+int n = -7 / 2;
+
+float read()
+{
+  return ok + folded.x * 10.0 + folded.y * 100.0 + float(n) * 1000.0;
+}
@@ -0,0 +1,17 @@
+uniform float u;
+const float k = 2.0;
+float ok = k * 3.0;
+vec2 folded = vec2(1, k);
+float g = u * 2.0;
+
+vec3 f()
+{
+  return vec3(ok, folded);
+}
+
+vec3 h = f();
+
+float read()
+{
+  return ok + folded.y + g + h.x;
+}
@@ -0,0 +1,44 @@
+int sumSkipping(int n)
+{
+  int i;
+  int s = 0;
+  for (i = 0; i < n; i++) {
+    if (i == 3)
+      continue;
+    if (i == 8)
+      break;
+    s += i;
+  }
+  return s;
+}
+
+int countDown(int n)
+{
+  int steps = 0;
+  while (true) {
+    if (n <= 0)
+      break;
+    n = n - 2;
+    steps++;
+  }
+  return steps;
+}
+
+int nested(int n)
+{
+  int i;
+  int j;
+  int s = 0;
+  for (i = 0; i < n; i++) {
+    j = 0;
+    while (j < n) {
+      j++;
+      if (j > i)
+        break;
+      if (j == 2)
+        continue;
+      s += j;
+    }
+  }
+  return s;
+}
@@ -0,0 +1,49 @@
+int calls;
+
+int next()
+{
+  calls++;
+  return calls;
+}
+
+float compound(int i)
+{
+  float a[4];
+  a[0] = 1.0;
+  a[1] = 2.0;
+  a[2] = 3.0;
+  a[3] = 4.0;
+  a[i++] += 10.0;
+  return a[0] + a[1] * 10.0 + a[2] * 100.0 + float(i) * 1000.0;
+}
+
+int increments()
+{
+  int b[3];
+  b[0] = 0;
+  b[1] = 0;
+  b[2] = 0;
+  calls = 0;
+  b[next()]++;
+  ++b[next()];
+  return b[0] + b[1] * 10 + b[2] * 100 + calls * 1000;
+}
+
+vec2 column()
+{
+  mat2 m = mat2(1.0, 2.0, 3.0, 4.0);
+  calls = 0;
+  m[next() - 1]++;
+  m[next() - 1].y *= 2.0;
+  return vec2(m[0].x + m[0].y + m[1].x, m[1].y + float(calls) * 100.0);
+}
+
+vec3 component(int i)
+{
+  vec3 arr[2];
+  arr[0] = vec3(0.0, 0.0, 0.0);
+  arr[1] = vec3(0.0, 0.0, 0.0);
+  arr[i++].y = 5.0;
+  arr[i - 1].xz += vec2(1.0, 2.0);
+  return arr[0] + arr[1] * 10.0 + float(i) * 100.0;
+}
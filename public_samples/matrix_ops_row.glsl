@@ -0,0 +1,29 @@
+vec2 matvec(mat2 m, vec2 v)
+{
+  return m * v;
+}
+
+vec2 vecmat(vec2 v, mat2 m)
+{
+  return v * m;
+}
+
+mat2 matmat(mat2 a, mat2 b)
+{
+  return a * b;
+}
+
+mat3 flip(mat3 m)
+{
+  return transpose(m);
+}
+
+vec3 column(mat3 m)
+{
+  return m[1];
+}
+
+float element(mat3 m)
+{
+  return m[2][0] + transpose(m)[2][0] * 10.0;
+}
@@ -0,0 +1,15 @@
+uniform float scale;
+
+vec4 shade(vec2 p)
+{
+  return vec4(p * scale, 0.0, 1.0);
+}
+
+int count(int n)
+{
+  return n + 1;
+}
+
+void nothing()
+{
+}
@@ -0,0 +1,7 @@
+float f(vec2 v, mat3 m, bool b)
+{
+  vec3 r = m * v;
+  float x = v + 1;
+  int i = -b;
+  return x + b;
+}
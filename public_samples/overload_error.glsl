@@ -0,0 +1,21 @@
+float f(float a, int b)
+{
+  return a;
+}
+
+float f(int a, float b)
+{
+  return b;
+}
+
+float g(vec2 v)
+{
+  return v.x;
+}
+
+float caller()
+{
+  float x = f(1, 2);
+  float y = g(1.0);
+  return x + y + h(3);
+}
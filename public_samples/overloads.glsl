@@ -0,0 +1,34 @@
+float scale(float x)
+{
+  return x * 2.0;
+}
+
+vec2 scale(vec2 v)
+{
+  return v * 3.0;
+}
+
+int scale(int x)
+{
+  return x * 4;
+}
+
+float mix2(float a, float b)
+{
+  return a + b;
+}
+
+float pick(int i)
+{
+  return scale(float(i)) + mix2(i, 0.5);
+}
+
+vec2 pickv(vec2 v)
+{
+  return scale(v);
+}
+
+int picki(int i)
+{
+  return scale(i);
+}
@@ -0,0 +1,9 @@
+float half(float x)
+{
+  return x / 2.0;
+}
+
+float quarter(float x)
+{
+  return half(half(x));
+}
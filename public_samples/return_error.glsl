@@ -0,0 +1,14 @@
+float f(int x)
+{
+  return x == 1;
+}
+
+void g()
+{
+  return 1.0;
+}
+
+vec2 h()
+{
+  return;
+}
@@ -0,0 +1,33 @@
+int calls;
+
+bool touch(bool b)
+{
+  calls++;
+  return b;
+}
+
+int andSkips(bool a)
+{
+  calls = 0;
+  if (a && touch(true))
+    calls += 10;
+  return calls;
+}
+
+int orSkips(bool a)
+{
+  calls = 0;
+  bool r = a || touch(false);
+  if (r)
+    calls += 10;
+  return calls;
+}
+
+int chained()
+{
+  calls = 0;
+  bool r = touch(false) && touch(true) || touch(true) || touch(false);
+  if (r)
+    calls += 10;
+  return calls;
+}
@@ -0,0 +1,24 @@
+vec2 lerp2(vec2 a, vec2 b, float t)
+{
+  return a * (1.0 - t) + b * t;
+}
+
+// lanes take different branches, which become selects
+float ramp(float x)
+{
+  if (x > 1.0)
+    return x * 2.0;
+  return -x;
+}
+
+// a loop keeps the lanes one after another
+float sumTo(float n)
+{
+  float s = 0.0;
+  float i = 0.0;
+  while (i < n) {
+    s += i;
+    i += 1.0;
+  }
+  return s;
+}
@@ -0,0 +1,17 @@
+int classify(int x)
+{
+  int r = 0;
+  switch (x) {
+    case 0:
+      r = r + 1;
+    case 1:
+      r = r + 10;
+      break;
+    case 2:
+    case 3:
+      r = r + 100;
+    default:
+      r = r + 1000;
+  }
+  return r;
+}
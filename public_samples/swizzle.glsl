@@ -0,0 +1,31 @@
+vec4 shuffle(vec4 v)
+{
+  return v.wzyx;
+}
+
+vec3 write(vec3 v)
+{
+  vec3 r = v;
+  r.xz = v.zx;
+  r.y = r.y * 10.0;
+  return r;
+}
+
+vec4 chain(vec4 v)
+{
+  vec4 r = vec4(0.0, 0.0, 0.0, 0.0);
+  r.zw = v.xyz.yx;
+  r.x += v.w;
+  return r;
+}
+
+float dot3(vec3 a, vec3 b)
+{
+  vec3 p = a * b;
+  return p.x + p.y + p.z;
+}
+
+vec2 arith(vec2 a, vec2 b)
+{
+  return (a + b) * 2.0 - b / 2.0;
+}
@@ -0,0 +1,8 @@
+float f(vec2 v, float s)
+{
+  vec3 a = v.xyz;
+  float b = v.q;
+  float c = s.x;
+  vec4 d = vec4(v, v).xyzwx;
+  return b;
+}
@@ -0,0 +1,8 @@
+vec2 f(vec2 a)
+{
+  vec2 v = a;
+  v.xy = a.yx;
+  v.xx = vec2(1.0, 2.0);
+  v.yy++;
+  return v;
+}
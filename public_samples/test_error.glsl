@@ -0,0 +1,11 @@
+int f(int x)
+{
+  int r = 0;
+  if (x)
+    r = 1;
+  while (x + 1)
+    r++;
+  for (r = 0; 1.0; r++)
+    x--;
+  return r > 0 ? x : r;
+}
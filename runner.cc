@@ -0,0 +1,950 @@
+/* File: runner.cc
+ * ---------------
+ * In-process runner behind "glc --run". A harness file is a list of
+ * directives, one per line:
+ *
+ *     funct: <name>                        starts a call of <name>
+ *     param: <type>, <value>, ...          its next argument
+ *     gin: <global>, <type>, <value>, ...  a global set before the call
+ *
+ * Values are exchanged with the JIT compiled code as flat arrays of
+ * 32-bit slots, one per scalar component (matrices column by column, as
+ * GLSL writes them). Each function called gets a wrapper in the module
+ * that reads its arguments from slots and writes its result to slots,
+ * and each global set gets one that reads its value, so calls don't
+ * depend on the platform's calling convention for vectors and arrays.
+ *
+ * "glc --dispatch WxH entry" runs one function over a grid instead, see
+ * RunDispatch, and "glc --batch" over the rows of a columnar file, see
+ * RunBatch.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "runner.h"
+#include "utility.h"
+#include "ast_decl.h"
+#include "ast_type.h"
+#include "symtable.h"
+#include "irgen.h"
+#include "threadpool.h"
+#include "objcache.h"
+#include "perfmap.h"
+#include "llvm/ExecutionEngine/Orc/CompileUtils.h"
+#include "llvm/ExecutionEngine/Orc/ExecutionUtils.h"
+#include "llvm/ExecutionEngine/Orc/LLJIT.h"
+#include "llvm/ExecutionEngine/Orc/RTDyldObjectLinkingLayer.h"
+#include "llvm/ExecutionEngine/SectionMemoryManager.h"
+#include "llvm/MC/SubtargetFeature.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Target/TargetMachine.h"
+
+union Slot {
+    int32_t i;
+    uint32_t u;
+    float f;
+};
+
+// a param: or gin: line, its components still as written
+struct HarnessValue {
+    std::string global;
+    Type *type;
+    std::vector<std::string> comps;
+};
+
+struct HarnessCall {
+    std::string funct;
+    std::vector<HarnessValue> params, gins;
+    FnDecl *fn;
+};
+
+typedef void (*CallWrapper)(Slot *args, Slot *result);
+typedef void (*GlobalSetter)(Slot *value);
+
+static Type *TypeNamed(const std::string &name) {
+    Type *types[] = { Type::intType, Type::uintType, Type::floatType, Type::boolType,
+                      Type::vec2Type, Type::vec3Type, Type::vec4Type,
+                      Type::ivec2Type, Type::ivec3Type, Type::ivec4Type,
+                      Type::uvec2Type, Type::uvec3Type, Type::uvec4Type,
+                      Type::bvec2Type, Type::bvec3Type, Type::bvec4Type,
+                      Type::mat2Type, Type::mat3Type, Type::mat4Type };
+    for (size_t i = 0; i < sizeof(types) / sizeof(types[0]); i++) {
+        std::ostringstream s;
+        s << types[i];
+        if (s.str() == name)
+            return types[i];
+    }
+    return NULL;
+}
+
+int NumComponents(Type *t) {
+    int n = t->GetVectorSize();
+    return t->IsMatrix() ? n * n : n;
+}
+
+// the comma separated fields of a directive, spaces around them removed
+static std::vector<std::string> Fields(const char *text) {
+    std::vector<std::string> fields;
+    std::string s(text);
+    size_t start = 0;
+    while (start <= s.size()) {
+        size_t end = s.find(',', start);
+        if (end == std::string::npos)
+            end = s.size();
+        size_t first = s.find_first_not_of(" \t\r\n", start);
+        size_t last = s.find_last_not_of(" \t\r\n", end - 1);
+        fields.push_back(first < end && last != std::string::npos && last >= first ?
+                         s.substr(first, last - first + 1) : "");
+        start = end + 1;
+    }
+    return fields;
+}
+
+// with globalsOnly, only gin: lines are allowed, as one call of nothing
+static std::vector<HarnessCall> ReadHarness(const char *filename, bool globalsOnly = false) {
+    FILE *in = fopen(filename, "r");
+    if (in == NULL)
+        Failure("Cannot open harness file %s", filename);
+
+    std::vector<HarnessCall> calls;
+    if (globalsOnly) {
+        calls.push_back(HarnessCall());
+        calls.back().fn = NULL;
+    }
+    char line[1024];
+    for (int lineNum = 1; fgets(line, sizeof(line), in) != NULL; lineNum++) {
+        char *colon = strchr(line, ':');
+        std::vector<std::string> directive = Fields(line);
+        if (colon == NULL) {
+            if (directive.size() == 1 && directive[0].empty())
+                continue;   // blank line
+            Failure("%s:%d: expected funct:, param: or gin:", filename, lineNum);
+        }
+        *colon = '\0';
+        std::string name = Fields(line)[0];
+        std::vector<std::string> fields = Fields(colon + 1);
+
+        if (globalsOnly && name != "gin")
+            Failure("%s:%d: only gin: sets globals for a dispatch", filename, lineNum);
+        if (name == "funct") {
+            HarnessCall call;
+            call.funct = fields[0];
+            call.fn = NULL;
+            calls.push_back(call);
+            continue;
+        }
+        if (name != "param" && name != "gin")
+            Failure("%s:%d: unknown directive %s", filename, lineNum, name.c_str());
+        if (calls.empty())
+            Failure("%s:%d: %s: before any funct:", filename, lineNum, name.c_str());
+
+        HarnessValue value;
+        if (name == "gin") {
+            value.global = fields[0];
+            fields.erase(fields.begin());
+        }
+        value.type = fields.empty() ? NULL : TypeNamed(fields[0]);
+        if (value.type == NULL)
+            Failure("%s:%d: unknown type %s", filename, lineNum,
+                    fields.empty() ? "" : fields[0].c_str());
+        value.comps.assign(fields.begin() + 1, fields.end());
+        if ((int)value.comps.size() != NumComponents(value.type))
+            Failure("%s:%d: %d values given for a %s", filename, lineNum,
+                    (int)value.comps.size(), fields[0].c_str());
+        (name == "gin" ? calls.back().gins : calls.back().params).push_back(value);
+    }
+    fclose(in);
+    return calls;
+}
+
+static void AppendSlots(const HarnessValue &value, std::vector<Slot> &slots) {
+    Type *scalar = value.type->GetScalarType();
+    for (size_t i = 0; i < value.comps.size(); i++) {
+        const char *text = value.comps[i].c_str();
+        Slot s;
+        if (scalar == Type::floatType)
+            s.f = strtof(text, NULL);
+        else if (scalar == Type::uintType)
+            s.u = strtoul(text, NULL, 0);
+        else if (scalar == Type::boolType)
+            s.i = strcmp(text, "true") == 0 || (strcmp(text, "false") != 0 && atoi(text) != 0);
+        else
+            s.i = strtol(text, NULL, 0);
+        slots.push_back(s);
+    }
+}
+
+static void PrintResult(Type *t, const Slot *slots) {
+    Type *scalar = t->GetScalarType();
+    printf("Result:");
+    for (int i = 0; i < NumComponents(t); i++) {
+        if (scalar == Type::floatType)
+            printf(" %e", slots[i].f);
+        else if (scalar == Type::uintType)
+            printf(" %u", slots[i].u);
+        else
+            printf(" %d", slots[i].i);
+    }
+    printf("\n");
+}
+
+
+/* Wrappers
+ * --------
+ * Emitted into the module before it is handed to the JIT. Slot k of a
+ * matrix is column k/n, row k%n, whichever way the matrix is stored.
+ */
+
+// slot k of slots, or with a stride, slot k * stride: component k of
+// the value in row 0 of a column, to which the caller adds its row
+static llvm::Value *SlotAddress(llvm::Value *slots, int k, llvm::Value *stride) {
+    IRGenerator::Builder *builder = Node::irgen->GetBuilder();
+    llvm::Type *i32 = builder->getInt32Ty();
+    if (stride == NULL)
+        return builder->CreateConstGEP1_32(i32, slots, k);
+    return builder->CreateGEP(i32, slots, builder->CreateMul(builder->getInt64(k), stride));
+}
+
+static llvm::Value *LoadSlot(Type *scalar, llvm::Value *slots, int k, llvm::Value *stride = NULL) {
+    IRGenerator::Builder *builder = Node::irgen->GetBuilder();
+    llvm::Type *i32 = builder->getInt32Ty();
+    llvm::Value *v = builder->CreateLoad(i32, SlotAddress(slots, k, stride));
+    if (scalar == Type::floatType)
+        return builder->CreateBitCast(v, builder->getFloatTy());
+    if (scalar == Type::boolType)
+        return builder->CreateICmpNE(v, builder->getInt32(0));
+    return v;
+}
+
+static void StoreSlot(llvm::Value *v, llvm::Value *slots, int k, llvm::Value *stride = NULL) {
+    IRGenerator::Builder *builder = Node::irgen->GetBuilder();
+    llvm::Type *i32 = builder->getInt32Ty();
+    if (v->getType()->isFloatTy())
+        v = builder->CreateBitCast(v, i32);
+    else if (v->getType()->isIntegerTy(1))
+        v = builder->CreateZExt(v, i32);
+    builder->CreateStore(v, SlotAddress(slots, k, stride));
+}
+
+// slot of lane b of element a of a value of type t
+static int SlotOf(Type *t, int a, int b) {
+    int n = t->GetVectorSize();
+    if (!t->IsMatrix())
+        return b;
+    return Node::irgen->IsRowMajor() ? b * n + a : a * n + b;
+}
+
+static llvm::Value *LoadValue(Type *t, llvm::Value *slots, llvm::Value *stride = NULL) {
+    IRGenerator::Builder *builder = Node::irgen->GetBuilder();
+    llvm::Type *ty = Node::irgen->GetType(t);
+    Type *scalar = t->GetScalarType();
+    if (!t->IsVector() && !t->IsMatrix())
+        return LoadSlot(scalar, slots, 0, stride);
+
+    int n = t->GetVectorSize();
+    llvm::Value *value = llvm::UndefValue::get(ty);
+    for (int a = 0; a < (t->IsMatrix() ? n : 1); a++) {
+        llvm::Type *vecTy = t->IsMatrix() ? ty->getArrayElementType() : ty;
+        llvm::Value *vec = llvm::UndefValue::get(vecTy);
+        for (int b = 0; b < n; b++)
+            vec = builder->CreateInsertElement(vec, LoadSlot(scalar, slots, SlotOf(t, a, b), stride), b);
+        value = t->IsMatrix() ? builder->CreateInsertValue(value, vec, a) : vec;
+    }
+    return value;
+}
+
+static void StoreValue(Type *t, llvm::Value *value, llvm::Value *slots, llvm::Value *stride = NULL) {
+    IRGenerator::Builder *builder = Node::irgen->GetBuilder();
+    if (!t->IsVector() && !t->IsMatrix()) {
+        StoreSlot(value, slots, 0, stride);
+        return;
+    }
+    int n = t->GetVectorSize();
+    for (int a = 0; a < (t->IsMatrix() ? n : 1); a++) {
+        llvm::Value *vec = t->IsMatrix() ? builder->CreateExtractValue(value, a) : value;
+        for (int b = 0; b < n; b++)
+            StoreSlot(builder->CreateExtractElement(vec, b), slots, SlotOf(t, a, b), stride);
+    }
+}
+
+static llvm::Function *CreateWrapper(const std::string &name, int numArgs) {
+    llvm::Module *module = Node::irgen->GetOrCreateModule("glc.bc");
+    IRGenerator::Builder *builder = Node::irgen->GetBuilder();
+    std::vector<llvm::Type*> argTypes(numArgs, builder->getInt32Ty()->getPointerTo());
+    llvm::FunctionType *fnTy = llvm::FunctionType::get(builder->getVoidTy(), argTypes, false);
+    llvm::Function *f = llvm::Function::Create(fnTy, llvm::Function::ExternalLinkage, name, module);
+    Node::irgen->SetBasicBlock(llvm::BasicBlock::Create(*Node::irgen->GetContext(), "entry", f));
+    return f;
+}
+
+// void <fn>.run(i32 *args, i32 *result)
+std::string EmitCallWrapper(FnDecl *fn) {
+    llvm::Function *callee = Node::irgen->GetOrDeclareFunction(fn);
+    std::string name = callee->getName().str() + ".run";
+    llvm::Module *module = Node::irgen->GetOrCreateModule("glc.bc");
+    if (module->getFunction(name))
+        return name;
+
+    llvm::Function *f = CreateWrapper(name, 2);
+    IRGenerator::Builder *builder = Node::irgen->GetBuilder();
+    List<VarDecl*> *formals = fn->GetFormals();
+    std::vector<llvm::Value*> args;
+    int k = 0;
+    for (int i = 0; i < formals->NumElements(); i++) {
+        Type *t = formals->Nth(i)->GetType();
+        llvm::Value *slots = builder->CreateConstGEP1_32(builder->getInt32Ty(), f->getArg(0), k);
+        args.push_back(LoadValue(t, slots));
+        k += NumComponents(t);
+    }
+    llvm::Value *result = builder->CreateCall(callee, args);
+    if (!fn->GetType()->IsEquivalentTo(Type::voidType))
+        StoreValue(fn->GetType(), result, f->getArg(1));
+    builder->CreateRetVoid();
+    return name;
+}
+
+// void <global>.set(i32 *value)
+static std::string EmitGlobalSetter(const std::string &global) {
+    Symbol *sym = Node::symtab->find(global.c_str());
+    VarDecl *var = sym ? dynamic_cast<VarDecl*>(sym->decl) : NULL;
+    // one of the shared scope may not have been used by the program
+    llvm::GlobalVariable *gv = var ? llvm::dyn_cast_or_null<llvm::GlobalVariable>(var->EmitShared()) : NULL;
+    if (var == NULL || gv == NULL || gv->isConstant())
+        Failure("No global variable %s to set", global.c_str());
+
+    std::string name = gv->getName().str() + ".set";
+    llvm::Module *module = Node::irgen->GetOrCreateModule("glc.bc");
+    if (module->getFunction(name))
+        return name;
+
+    llvm::Function *f = CreateWrapper(name, 1);
+    IRGenerator::Builder *builder = Node::irgen->GetBuilder();
+    builder->CreateStore(LoadValue(var->GetType(), f->getArg(0)), gv);
+    builder->CreateRetVoid();
+    return name;
+}
+
+static FnDecl *FunctionToCall(const HarnessCall &call) {
+    Symbol *sym = Node::symtab->find(call.funct.c_str());
+    if (sym == NULL || sym->overloads == NULL)
+        Failure("No function %s to call", call.funct.c_str());
+    Signature sig;
+    for (size_t i = 0; i < call.params.size(); i++)
+        sig.push_back(call.params[i].type);
+    FnDecl *fn = sym->overloads->findExact(sig);
+    if (fn == NULL || fn->GetBody() == NULL)
+        Failure("No definition of %s for the params given", call.funct.c_str());
+    return fn;
+}
+
+
+static uint64_t Lookup(llvm::orc::LLJIT &jit, const std::string &name) {
+    llvm::Expected<llvm::JITEvaluatedSymbol> sym = jit.lookup(name);
+    if (!sym)
+        Failure("Cannot link %s: %s", name.c_str(), llvm::toString(sym.takeError()).c_str());
+    return sym->getAddress();
+}
+
+static std::string cacheDir;
+static uint64_t cacheLimit;
+// outlives every JIT that uses it
+static ObjectFileCache *cache = NULL;
+
+void SetJITCache(const char *dir, uint64_t maxBytes) {
+    cacheDir = dir;
+    cacheLimit = maxBytes;
+}
+
+// told of every object the JIT loads, and like the cache outlive it
+static std::vector<llvm::JITEventListener*> listeners;
+
+void SetJITProfiling(bool perfMap, bool jitdump) {
+    if (perfMap)
+        listeners.push_back(new PerfMapListener());
+    if (jitdump) {
+        llvm::JITEventListener *dump = llvm::JITEventListener::createPerfJITEventListener();
+        if (dump == NULL)
+            Failure("LLVM was built without jitdump support (LLVM_USE_PERF)");
+        listeners.push_back(dump);
+    }
+}
+
+// a JIT for the generator's target, taking over its module
+static std::unique_ptr<llvm::orc::LLJIT> CreateJIT() {
+    llvm::TargetMachine *tm = Node::irgen->GetTargetMachine();
+    if (tm == NULL)
+        Failure("LLVM was built without a code generator for this host");
+    llvm::InitializeNativeTargetAsmPrinter();
+
+    llvm::orc::JITTargetMachineBuilder machine(tm->getTargetTriple());
+    machine.setCPU(tm->getTargetCPU().str());
+    machine.getFeatures() = llvm::SubtargetFeatures(tm->getTargetFeatureString());
+    machine.setCodeGenOptLevel(tm->getOptLevel());
+    llvm::orc::LLJITBuilder builder;
+    builder.setJITTargetMachineBuilder(machine);
+    if (!cacheDir.empty()) {
+        if (cache == NULL)
+            cache = new ObjectFileCache(cacheDir, cacheLimit, tm);
+        builder.setCompileFunctionCreator([](llvm::orc::JITTargetMachineBuilder jtmb)
+                -> llvm::Expected<std::unique_ptr<llvm::orc::IRCompileLayer::IRCompiler> > {
+            return std::make_unique<llvm::orc::ConcurrentIRCompiler>(std::move(jtmb), cache);
+        });
+    }
+    if (!listeners.empty())
+        builder.setObjectLinkingLayerCreator([](llvm::orc::ExecutionSession &session, const llvm::Triple &)
+                -> llvm::Expected<std::unique_ptr<llvm::orc::ObjectLayer> > {
+            // the layer LLJIT would make, with the listeners on it
+            std::unique_ptr<llvm::orc::RTDyldObjectLinkingLayer> layer =
+                std::make_unique<llvm::orc::RTDyldObjectLinkingLayer>(session, [] {
+                    return std::make_unique<llvm::SectionMemoryManager>();
+                });
+            for (size_t i = 0; i < listeners.size(); i++)
+                layer->registerJITEventListener(*listeners[i]);
+            return std::move(layer);
+        });
+    llvm::Expected<std::unique_ptr<llvm::orc::LLJIT> > jit = builder.create();
+    if (!jit)
+        Failure("Cannot create JIT: %s", llvm::toString(jit.takeError()).c_str());
+
+    // built-ins may call into libm, which this process links
+    llvm::Expected<std::unique_ptr<llvm::orc::DynamicLibrarySearchGenerator> > process =
+        llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+            (*jit)->getDataLayout().getGlobalPrefix());
+    if (!process)
+        Failure("Cannot create JIT: %s", llvm::toString(process.takeError()).c_str());
+    (*jit)->getMainJITDylib().addGenerator(std::move(*process));
+
+    std::unique_ptr<llvm::Module> module;
+    std::unique_ptr<llvm::LLVMContext> context;
+    Node::irgen->ReleaseModule(module, context);
+    llvm::Error err = (*jit)->addIRModule(llvm::orc::ThreadSafeModule(std::move(module), std::move(context)));
+    if (err)
+        Failure("Cannot compile: %s", llvm::toString(std::move(err)).c_str());
+    return std::move(*jit);
+}
+
+int RunHarness(const char *datFile) {
+    std::vector<HarnessCall> calls = ReadHarness(datFile);
+
+    // every wrapper is emitted before the module goes to the JIT, so it
+    // is compiled once whatever the number of calls
+    std::vector<std::string> entries;
+    std::map<std::string, std::string> setters;
+    for (size_t i = 0; i < calls.size(); i++) {
+        calls[i].fn = FunctionToCall(calls[i]);
+        entries.push_back(EmitCallWrapper(calls[i].fn));
+        for (size_t j = 0; j < calls[i].gins.size(); j++) {
+            const std::string &global = calls[i].gins[j].global;
+            if (setters.count(global) == 0)
+                setters[global] = EmitGlobalSetter(global);
+        }
+    }
+
+    Node::irgen->Optimize();
+    std::unique_ptr<llvm::orc::LLJIT> jit = CreateJIT();
+    for (size_t i = 0; i < calls.size(); i++) {
+        HarnessCall &call = calls[i];
+        for (size_t j = 0; j < call.gins.size(); j++) {
+            std::vector<Slot> value;
+            AppendSlots(call.gins[j], value);
+            GlobalSetter set = (GlobalSetter)Lookup(*jit, setters[call.gins[j].global]);
+            set(value.data());
+        }
+
+        std::vector<Slot> args, result(16);
+        for (size_t j = 0; j < call.params.size(); j++)
+            AppendSlots(call.params[j], args);
+        CallWrapper entry = (CallWrapper)Lookup(*jit, entries[i]);
+        entry(args.data(), result.data());
+        if (!call.fn->GetType()->IsEquivalentTo(Type::voidType))
+            PrintResult(call.fn->GetType(), &result[0]);
+    }
+    fflush(stdout);
+    return 0;
+}
+
+
+/* Grid dispatch
+ * -------------
+ * The entry is called once per cell of the grid, the way a fragment
+ * shader runs once per pixel. A wrapper emitted into the module calls it
+ * along a span of one row, so at -O1 and up the entry is inlined into
+ * the loop and the loop can be vectorized across cells.
+ *
+ * Cells are run a tile of Tile x Tile at a time rather than row by row,
+ * so an entry reading the neighbourhood of its cell from a global array
+ * keeps finding it in cache. The framebuffer is kept in the same tiled
+ * layout, each tile's cells contiguous and tiles row after row, with the
+ * grid padded to whole tiles. Tiles are grouped into chunks of Chunk x
+ * Chunk, visited in Morton order so consecutive tiles stay neighbours in
+ * both directions, and the pool's workers render chunks into buffers of
+ * their own, copying each tile to the framebuffer when the chunk is done,
+ * so no two threads write near each other while the entry runs. Only
+ * when the framebuffer is written out is it converted to rows, unless
+ * the tiled layout is asked for.
+ */
+
+// how the entry is told which cell it is running for
+enum CellArgs {
+    CellVec2,     // vec2, the cell's center like gl_FragCoord.xy
+    CellFloats,   // float x, float y, the same
+    CellInts      // int x, int y
+};
+
+typedef void (*SpanWrapper)(int32_t x0, int32_t y, int32_t count, Slot *out, void *uniforms);
+typedef void (*UniformsWrapper)(void *uniforms);
+
+static FnDecl *DispatchEntry(const char *entry, CellArgs &cellArgs) {
+    Symbol *sym = Node::symtab->find(entry);
+    if (sym == NULL || sym->overloads == NULL)
+        Failure("No function %s to dispatch", entry);
+
+    Signature vec2, floats, ints;
+    vec2.push_back(Type::vec2Type);
+    floats.push_back(Type::floatType);
+    floats.push_back(Type::floatType);
+    ints.push_back(Type::intType);
+    ints.push_back(Type::intType);
+    const Signature *sigs[] = { &vec2, &floats, &ints };
+    for (int i = 0; i < 3; i++) {
+        FnDecl *fn = sym->overloads->findExact(*sigs[i]);
+        if (fn == NULL || fn->GetBody() == NULL)
+            continue;
+        if (fn->GetType()->GetVectorSize() == 0)
+            Failure("%s returns nothing to store per cell", entry);
+        cellArgs = (CellArgs)i;
+        return fn;
+    }
+    Failure("%s must take (vec2), (float, float) or (int, int) to be dispatched", entry);
+    return NULL;
+}
+
+// void <fn>.span(i32 x0, i32 y, i32 count, i32 *out, i8 *uniforms),
+// calling fn for cells x0 to x0+count-1 of row y, count > 0, results one
+// after another; with varying, calls that with the uniforms block instead
+static std::string EmitSpanWrapper(FnDecl *fn, CellArgs cellArgs, llvm::Function *varying) {
+    llvm::Function *callee = Node::irgen->GetOrDeclareFunction(fn);
+    llvm::Module *module = Node::irgen->GetOrCreateModule("glc.bc");
+    llvm::LLVMContext *context = Node::irgen->GetContext();
+    IRGenerator::Builder *builder = Node::irgen->GetBuilder();
+    llvm::Type *i32 = builder->getInt32Ty();
+    llvm::Type *argTypes[] = { i32, i32, i32, i32->getPointerTo(), builder->getInt8PtrTy() };
+    llvm::FunctionType *fnTy = llvm::FunctionType::get(builder->getVoidTy(), argTypes, false);
+    std::string name = callee->getName().str() + ".span";
+    llvm::Function *f = llvm::Function::Create(fnTy, llvm::Function::ExternalLinkage, name, module);
+    f->addParamAttr(3, llvm::Attribute::NoAlias);
+    f->addParamAttr(4, llvm::Attribute::NoAlias);
+    // tuned for the same CPU as the shader
+    if (callee->hasFnAttribute("target-cpu"))
+        f->addFnAttr(callee->getFnAttribute("target-cpu"));
+    if (callee->hasFnAttribute("target-features"))
+        f->addFnAttr(callee->getFnAttribute("target-features"));
+
+    llvm::BasicBlock *entry = llvm::BasicBlock::Create(*context, "entry", f);
+    llvm::BasicBlock *cell = llvm::BasicBlock::Create(*context, "cell", f);
+    llvm::BasicBlock *exit = llvm::BasicBlock::Create(*context, "exit", f);
+    Node::irgen->SetBasicBlock(entry);
+    builder->CreateBr(cell);
+
+    Node::irgen->SetBasicBlock(cell);
+    llvm::PHINode *i = builder->CreatePHI(i32, 2, "i");
+    i->addIncoming(builder->getInt32(0), entry);
+    llvm::Value *x = builder->CreateAdd(f->getArg(0), i);
+    llvm::Value *y = f->getArg(1);
+    std::vector<llvm::Value*> args;
+    if (cellArgs == CellInts) {
+        args.push_back(x);
+        args.push_back(y);
+    }
+    else {
+        llvm::Value *half = llvm::ConstantFP::get(builder->getFloatTy(), 0.5);
+        llvm::Value *fx = builder->CreateFAdd(builder->CreateSIToFP(x, builder->getFloatTy()), half);
+        llvm::Value *fy = builder->CreateFAdd(builder->CreateSIToFP(y, builder->getFloatTy()), half);
+        if (cellArgs == CellFloats) {
+            args.push_back(fx);
+            args.push_back(fy);
+        }
+        else {
+            llvm::Value *coord = llvm::UndefValue::get(Node::irgen->GetType(Type::vec2Type));
+            coord = builder->CreateInsertElement(coord, fx, (uint64_t)0);
+            args.push_back(builder->CreateInsertElement(coord, fy, 1));
+        }
+    }
+    if (varying != NULL) {
+        args.push_back(f->getArg(4));
+        callee = varying;
+    }
+    llvm::CallInst *call = builder->CreateCall(callee, args);
+    call->addFnAttr(llvm::Attribute::AlwaysInline);
+    Type *retType = fn->GetType();
+    llvm::Value *slots = builder->CreateGEP(i32, f->getArg(3),
+        builder->CreateMul(i, builder->getInt32(NumComponents(retType))));
+    StoreValue(retType, call, slots);
+
+    llvm::Value *next = builder->CreateAdd(i, builder->getInt32(1));
+    i->addIncoming(next, cell);
+    builder->CreateCondBr(builder->CreateICmpSLT(next, f->getArg(2)), cell, exit);
+    Node::irgen->SetBasicBlock(exit);
+    builder->CreateRetVoid();
+    return name;
+}
+
+// the pool runs fn on all its threads at once, sharing the globals
+static void RejectGlobalStores(FnDecl *fn) {
+    llvm::Function *f = Node::irgen->GetOrDeclareFunction(fn);
+    llvm::GlobalVariable *gv = Node::irgen->FindGlobalStore(f);
+    if (gv != NULL)
+        Failure("%s assigns global %s, which its invocations running at once would share",
+                fn->GetIdentifier()->GetName(), gv->getName().str().c_str());
+}
+
+static const int Tile = 8;    // cells across a tile
+static const int Chunk = 8;   // tiles across a chunk, a power of 2
+
+// tile t of a chunk's Morton order: x from the even bits, y the odd ones
+static void MortonTile(int t, int &tx, int &ty) {
+    tx = ty = 0;
+    for (int bit = 0; (1 << (2 * bit)) < Chunk * Chunk; bit++) {
+        tx |= ((t >> (2 * bit)) & 1) << bit;
+        ty |= ((t >> (2 * bit + 1)) & 1) << bit;
+    }
+}
+
+int RunDispatch(int width, int height, const char *entry, bool tiledOutput,
+                const char *globalsFile) {
+    CellArgs cellArgs;
+    FnDecl *fn = DispatchEntry(entry, cellArgs);
+    RejectGlobalStores(fn);
+    std::vector<HarnessValue> gins;
+    if (globalsFile)
+        gins = ReadHarness(globalsFile, true)[0].gins;
+    std::vector<std::string> setters;
+    for (size_t i = 0; i < gins.size(); i++)
+        setters.push_back(EmitGlobalSetter(gins[i].global));
+
+    // what only depends on uniforms is worked out once for the whole grid
+    uint64_t blockSize = 0, blockAlign = 1;
+    llvm::Function *scalar = Node::irgen->GetOrDeclareFunction(fn);
+    llvm::Function *varying = Node::irgen->SplitUniformWork(scalar, blockSize, blockAlign);
+    std::string init = scalar->getName().str() + ".uniforms";
+    std::string span = EmitSpanWrapper(fn, cellArgs, varying);
+    // once, with the entry's caller there to inline it into
+    Node::irgen->Optimize();
+    std::unique_ptr<llvm::orc::LLJIT> jit = CreateJIT();
+    SpanWrapper run = (SpanWrapper)Lookup(*jit, span);
+
+    for (size_t i = 0; i < gins.size(); i++) {
+        std::vector<Slot> value;
+        AppendSlots(gins[i], value);
+        GlobalSetter set = (GlobalSetter)Lookup(*jit, setters[i]);
+        set(value.data());
+    }
+    // vector fields are loaded with aligned moves
+    void *uniforms;
+    if (posix_memalign(&uniforms, std::max<uint64_t>(blockAlign, sizeof(void *)), blockSize + 1) != 0)
+        Failure("Out of memory for the uniforms of %s", entry);
+    if (varying != NULL)
+        ((UniformsWrapper)Lookup(*jit, init))(uniforms);
+
+    int comps = NumComponents(fn->GetType());
+    int tileSlots = Tile * Tile * comps;
+    int tilesX = (width + Tile - 1) / Tile, tilesY = (height + Tile - 1) / Tile;
+    std::vector<Slot> framebuffer((size_t)tilesX * tilesY * tileSlots);
+
+    ThreadPool pool;
+    std::vector<std::vector<Slot> > buffers(pool.NumWorkers(),
+        std::vector<Slot>((size_t)Chunk * Chunk * tileSlots));
+    for (int cy = 0; cy < tilesY; cy += Chunk) {
+        for (int cx = 0; cx < tilesX; cx += Chunk) {
+            pool.Submit([&, cx, cy](int worker) {
+                Slot *buffer = buffers[worker].data();
+                int done[Chunk * Chunk], numDone = 0;
+                for (int t = 0; t < Chunk * Chunk; t++) {
+                    int tx, ty;
+                    MortonTile(t, tx, ty);
+                    tx += cx;
+                    ty += cy;
+                    if (tx >= tilesX || ty >= tilesY)
+                        continue;
+                    // cells past the grid's edge stay zero
+                    Slot *tile = buffer + (size_t)numDone * tileSlots;
+                    memset(tile, 0, tileSlots * sizeof(Slot));
+                    int x0 = tx * Tile, count = std::min(Tile, width - x0);
+                    for (int r = 0; r < Tile && ty * Tile + r < height; r++)
+                        run(x0, ty * Tile + r, count, tile + r * Tile * comps, uniforms);
+                    done[numDone++] = ty * tilesX + tx;
+                }
+                for (int i = 0; i < numDone; i++)
+                    memcpy(&framebuffer[(size_t)done[i] * tileSlots],
+                           buffer + (size_t)i * tileSlots, tileSlots * sizeof(Slot));
+            });
+        }
+    }
+    pool.Wait();
+    free(uniforms);
+
+    if (tiledOutput) {
+        fwrite(framebuffer.data(), sizeof(Slot), framebuffer.size(), stdout);
+        fflush(stdout);
+        return 0;
+    }
+
+    // row after row, each cell's components in slot order
+    std::vector<Slot> row((size_t)width * comps);
+    for (int y = 0; y < height; y++) {
+        const Slot *tiles = &framebuffer[((size_t)(y / Tile) * tilesX * Tile * Tile + (y % Tile) * Tile) * comps];
+        for (int tx = 0; tx < tilesX; tx++) {
+            int count = std::min(Tile, width - tx * Tile);
+            memcpy(&row[(size_t)tx * Tile * comps], tiles + (size_t)tx * tileSlots,
+                   count * comps * sizeof(Slot));
+        }
+        fwrite(row.data(), sizeof(Slot), row.size(), stdout);
+    }
+    fflush(stdout);
+    return 0;
+}
+
+
+/* Batches
+ * -------
+ * A batch file (see runner.h) is mapped and its columns are read in place
+ * by a wrapper looping over a range of rows, which the pool's workers
+ * split between them. Results are kept in columns the same way.
+ */
+
+struct BatchHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t numColumns;
+    uint64_t rows;
+    uint32_t name;
+    uint32_t reserved;
+};
+
+struct BatchColumn {
+    uint32_t name;
+    uint32_t type;
+    uint64_t offset;
+};
+
+typedef void (*BatchWrapper)(int64_t begin, int64_t end, int64_t rows,
+                             const Slot *const *params, Slot *result);
+
+// rows per task, enough to keep the loop's setup cost out of sight
+static const int64_t BatchChunk = 16384;
+
+// the NUL terminated string at offset in the file
+static const char *BatchString(const char *file, size_t size, uint32_t offset, const char *filename) {
+    if (offset >= size || memchr(file + offset, '\0', size - offset) == NULL)
+        Failure("%s: string at %u is outside the file", filename, offset);
+    return file + offset;
+}
+
+// void <fn>.batch(i64 begin, i64 end, i64 rows, i32 **params, i32 *result),
+// calling fn for rows begin to end-1, begin < end, of parameter columns
+// of rows rows, writing a result column of as many
+static std::string EmitBatchWrapper(FnDecl *fn) {
+    llvm::Function *callee = Node::irgen->GetOrDeclareFunction(fn);
+    llvm::Module *module = Node::irgen->GetOrCreateModule("glc.bc");
+    llvm::LLVMContext *context = Node::irgen->GetContext();
+    IRGenerator::Builder *builder = Node::irgen->GetBuilder();
+    llvm::Type *i64 = builder->getInt64Ty();
+    llvm::Type *slots = builder->getInt32Ty()->getPointerTo();
+    llvm::Type *argTypes[] = { i64, i64, i64, slots->getPointerTo(), slots };
+    llvm::FunctionType *fnTy = llvm::FunctionType::get(builder->getVoidTy(), argTypes, false);
+    std::string name = callee->getName().str() + ".batch";
+    llvm::Function *f = llvm::Function::Create(fnTy, llvm::Function::ExternalLinkage, name, module);
+    f->addParamAttr(3, llvm::Attribute::ReadOnly);
+    f->addParamAttr(4, llvm::Attribute::NoAlias);
+    if (callee->hasFnAttribute("target-cpu"))
+        f->addFnAttr(callee->getFnAttribute("target-cpu"));
+    if (callee->hasFnAttribute("target-features"))
+        f->addFnAttr(callee->getFnAttribute("target-features"));
+
+    llvm::BasicBlock *entry = llvm::BasicBlock::Create(*context, "entry", f);
+    llvm::BasicBlock *row = llvm::BasicBlock::Create(*context, "row", f);
+    llvm::BasicBlock *exit = llvm::BasicBlock::Create(*context, "exit", f);
+    Node::irgen->SetBasicBlock(entry);
+    List<VarDecl*> *formals = fn->GetFormals();
+    std::vector<llvm::Value*> columns;
+    for (int i = 0; i < formals->NumElements(); i++)
+        columns.push_back(builder->CreateLoad(slots, builder->CreateConstGEP1_32(slots, f->getArg(3), i)));
+    builder->CreateBr(row);
+
+    Node::irgen->SetBasicBlock(row);
+    llvm::PHINode *i = builder->CreatePHI(i64, 2, "i");
+    i->addIncoming(f->getArg(0), entry);
+    llvm::Value *rows = f->getArg(2);
+    std::vector<llvm::Value*> args;
+    for (int k = 0; k < formals->NumElements(); k++) {
+        llvm::Value *base = builder->CreateGEP(builder->getInt32Ty(), columns[k], i);
+        args.push_back(LoadValue(formals->Nth(k)->GetType(), base, rows));
+    }
+    llvm::CallInst *call = builder->CreateCall(callee, args);
+    call->addFnAttr(llvm::Attribute::AlwaysInline);
+    if (!fn->GetType()->IsEquivalentTo(Type::voidType)) {
+        llvm::Value *base = builder->CreateGEP(builder->getInt32Ty(), f->getArg(4), i);
+        StoreValue(fn->GetType(), call, base, rows);
+    }
+
+    llvm::Value *next = builder->CreateAdd(i, builder->getInt64(1));
+    i->addIncoming(next, row);
+    builder->CreateCondBr(builder->CreateICmpSLT(next, f->getArg(1)), row, exit);
+    Node::irgen->SetBasicBlock(exit);
+    builder->CreateRetVoid();
+    return name;
+}
+
+// a batch file of rows rows of type t, for results: mapped writable,
+// header in place, data at the returned pointer; the mapping is size
+// bytes at *file
+static Slot *CreateBatchFile(const char *filename, const char *funct, Type *t, int64_t rows,
+                             char **file, size_t *size) {
+    std::ostringstream typeName;
+    typeName << t;
+    std::string strings = std::string(funct) + '\0' + typeName.str() + '\0' + '\0';
+    size_t stringsAt = sizeof(BatchHeader) + sizeof(BatchColumn);
+    size_t dataAt = (stringsAt + strings.size() + 63) / 64 * 64;
+    *size = dataAt + (size_t)rows * NumComponents(t) * sizeof(Slot);
+
+    int fd = open(filename, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0 || ftruncate(fd, *size) != 0)
+        Failure("Cannot create %s", filename);
+    *file = (char *)mmap(NULL, *size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (*file == MAP_FAILED)
+        Failure("Cannot map %s", filename);
+
+    BatchHeader *header = (BatchHeader *)*file;
+    memcpy(header->magic, "GLCBATCH", 8);
+    header->version = 1;
+    header->numColumns = 1;
+    header->rows = rows;
+    header->name = stringsAt;
+    header->reserved = 0;
+    BatchColumn *column = (BatchColumn *)(header + 1);
+    column->name = stringsAt + strings.size() - 1;
+    column->type = stringsAt + strlen(funct) + 1;
+    column->offset = dataAt;
+    memcpy(*file + stringsAt, strings.data(), strings.size());
+    return (Slot *)(*file + dataAt);
+}
+
+int RunBatch(const char *filename, const char *outFile) {
+    int fd = open(filename, O_RDONLY);
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0)
+        Failure("Cannot open batch file %s", filename);
+    // the output is truncated while the input is still mapped from it
+    struct stat outInfo;
+    if (outFile && stat(outFile, &outInfo) == 0
+        && outInfo.st_dev == info.st_dev && outInfo.st_ino == info.st_ino)
+        Failure("%s is the batch file being read, write the results elsewhere", outFile);
+    size_t size = info.st_size;
+    if (size < sizeof(BatchHeader))
+        Failure("%s is not a batch file", filename);
+    const char *file = (const char *)mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (file == MAP_FAILED)
+        Failure("Cannot map batch file %s", filename);
+
+    const BatchHeader *header = (const BatchHeader *)file;
+    if (memcmp(header->magic, "GLCBATCH", 8) != 0 || header->version != 1)
+        Failure("%s is not a batch file of version 1", filename);
+    if (sizeof(BatchHeader) + (uint64_t)header->numColumns * sizeof(BatchColumn) > size)
+        Failure("%s: columns run past the end of the file", filename);
+    const BatchColumn *columns = (const BatchColumn *)(header + 1);
+    int64_t rows = header->rows;
+
+    // parameters are the unnamed columns, in order, globals the named ones
+    Signature sig;
+    std::vector<const Slot*> params;
+    std::vector<std::pair<std::string, const Slot*> > globals;
+    for (uint32_t i = 0; i < header->numColumns; i++) {
+        const char *name = BatchString(file, size, columns[i].name, filename);
+        const char *typeName = BatchString(file, size, columns[i].type, filename);
+        Type *type = TypeNamed(typeName);
+        if (type == NULL)
+            Failure("%s: unknown type %s", filename, typeName);
+        uint64_t count = name[0] ? 1 : rows;
+        uint64_t offset = columns[i].offset;
+        if (offset % 64 != 0 || offset > size || (size - offset) / 4 / NumComponents(type) < count)
+            Failure("%s: column %u is misaligned or runs past the end of the file", filename, i);
+        const Slot *data = (const Slot *)(file + offset);
+        if (name[0])
+            globals.push_back(std::make_pair(std::string(name), data));
+        else {
+            sig.push_back(type);
+            params.push_back(data);
+        }
+    }
+
+    const char *funct = BatchString(file, size, header->name, filename);
+    Symbol *sym = Node::symtab->find(funct);
+    FnDecl *fn = sym && sym->overloads ? sym->overloads->findExact(sig) : NULL;
+    if (fn == NULL || fn->GetBody() == NULL)
+        Failure("No definition of %s for the parameter columns of %s", funct, filename);
+    RejectGlobalStores(fn);
+    std::vector<std::string> setters;
+    for (size_t i = 0; i < globals.size(); i++)
+        setters.push_back(EmitGlobalSetter(globals[i].first));
+    std::string batch = EmitBatchWrapper(fn);
+    // once, with the function's caller there to inline it into
+    Node::irgen->Optimize();
+    std::unique_ptr<llvm::orc::LLJIT> jit = CreateJIT();
+    BatchWrapper run = (BatchWrapper)Lookup(*jit, batch);
+    for (size_t i = 0; i < globals.size(); i++)
+        ((GlobalSetter)Lookup(*jit, setters[i]))((Slot *)globals[i].second);
+
+    // results go straight into the output file's column when there is one
+    Type *retType = fn->GetType();
+    bool hasResult = !retType->IsEquivalentTo(Type::voidType);
+    int comps = hasResult ? NumComponents(retType) : 0;
+    std::vector<Slot> results;
+    Slot *result = NULL;
+    char *out = NULL;
+    size_t outSize = 0;
+    if (outFile && hasResult)
+        result = CreateBatchFile(outFile, funct, retType, rows, &out, &outSize);
+    else if (outFile)
+        Failure("%s returns nothing to write to %s", funct, outFile);
+    else {
+        results.resize((size_t)rows * comps);
+        result = results.data();
+    }
+
+    ThreadPool pool;
+    for (int64_t begin = 0; begin < rows; begin += BatchChunk) {
+        int64_t end = std::min(rows, begin + BatchChunk);
+        pool.Submit([&, begin, end](int) {
+            run(begin, end, rows, params.data(), result);
+        });
+    }
+    pool.Wait();
+    munmap((void *)file, size);
+    if (out != NULL) {
+        munmap(out, outSize);
+        return 0;
+    }
+
+    // the text rendering, for reading results rather than processing them
+    std::vector<Slot> value(comps);
+    for (int64_t r = 0; hasResult && r < rows; r++) {
+        for (int c = 0; c < comps; c++)
+            value[c] = result[(size_t)c * rows + r];
+        PrintResult(retType, value.data());
+    }
+    fflush(stdout);
+    return 0;
+}
@@ -0,0 +1,81 @@
+/**
+ * File: runner.h
+ * --------------
+ * Runs the compiled program in process, for "glc --run": a harness
+ * (.dat) file names the function to call, its arguments and the values
+ * of globals, and the module is JIT compiled and called without writing
+ * out bitcode, or for "glc --dispatch", runs one function over every cell
+ * of a grid on all cores.
+ */
+
+#ifndef _H_runner
+#define _H_runner
+
+#include <stdint.h>
+#include <string>
+
+class FnDecl;
+class Type;
+
+// 32-bit slots a value of type t takes, one per scalar component
+int NumComponents(Type *t);
+// emits void <fn>.run(i32 *args, i32 *result), calling fn with its
+// arguments read from slots and writing its result to slots, matrices
+// column by column whatever their layout; returns its name
+std::string EmitCallWrapper(FnDecl *fn);
+
+// keeps the objects the JIT compiles in dir, up to maxBytes of them, and
+// reuses them instead of compiling the same module again (see objcache.h)
+void SetJITCache(const char *dir, uint64_t maxBytes);
+// makes what the JIT compiles visible to Linux perf: perfMap lists its
+// functions in /tmp/perf-<pid>.map (see perfmap.h), jitdump writes LLVM's
+// jit-<pid>.dump with their code and line tables for "perf inject --jit"
+void SetJITProfiling(bool perfMap, bool jitdump);
+
+// calls each function named in the harness file on the emitted module,
+// printing "Result: ..." for each call the way gli does, and returns the
+// exit status; the module is gone afterwards
+int RunHarness(const char *datFile);
+
+// calls entry once per cell of a width by height grid, on a pool of one
+// thread per core, and writes the results to standard output as raw 32-bit
+// components, row after row; entry takes (vec2), the cell's center, or
+// (float, float) or (int, int), and returns a scalar, vector or matrix,
+// and must not assign globals, which all its invocations would share.
+// globalsFile, if not NULL, holds gin: lines of a harness file setting
+// globals first. What entry computes from uniforms and constants alone is
+// computed once before the grid runs. With tiledOutput the framebuffer is
+// written as it is kept instead: 8x8 tiles of contiguous cells, tiles row
+// after row, the grid padded with zeros to whole tiles. Returns the exit
+// status; the module is gone afterwards.
+int RunDispatch(int width, int height, const char *entry, bool tiledOutput,
+                const char *globalsFile);
+
+// calls a function once per row of a batch file, on a pool of one thread
+// per core (so, as for RunDispatch, one that doesn't assign globals),
+// printing "Result: ..." for each row, or with outFile writing the results
+// to it as a batch file instead: one unnamed column of the function's
+// return type, under the function's name, written in place through a
+// mapping of the file. A batch file is mapped and read in place; all
+// numbers are little endian:
+//
+//      0  char[8]  "GLCBATCH"
+//      8  u32      version, 1
+//     12  u32      number of columns
+//     16  u64      number of rows
+//     24  u32      offset of the function's name
+//     28  u32      0
+//     32  columns, 16 bytes each:
+//            u32  offset of its name, "" for the next parameter
+//            u32  offset of its type name, "float", "vec3", "mat4", ...
+//            u64  offset of its data, a multiple of 64
+//
+// Names are NUL terminated strings anywhere in the file. Unnamed columns
+// are the function's parameters in order, one value per row; named ones
+// set the global of that name, with one value. A column's data holds
+// each component (matrices column by column) as an array of 32-bit ints,
+// uints, floats or bools (0 or 1), one after the other. Returns the exit
+// status; the module is gone afterwards.
+int RunBatch(const char *filename, const char *outFile);
+
+#endif
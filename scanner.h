@@ -18,6 +18,7 @@ extern char *yytext;      // Text of lexeme just scanned
 int yylex();              // Defined in the generated lex.yy.c file
 
 void InitScanner();                 // Defined in scanner.l user subroutines
+void ResetScanner(FILE *in);        // ditto, restarts scanning on a new file
 const char *GetLineNumbered(int n); // ditto
  
 #endif
@@ -0,0 +1,223 @@
+/* File: symtab_bench.cc
+ * ---------------------
+ * Microbenchmarks for the symbol table and the Type predicates. Each
+ * workload is run at a series of doubling sizes and reports nanoseconds
+ * per operation; the cost per operation of a workload that scales well
+ * stays flat or grows with log n, so a per-op time that keeps growing
+ * with n is flagged as superlinear. Insert workloads also report the
+ * heap bytes held per symbol.
+ *
+ * Usage: symtab_bench [scale]   (scale divides the sizes, default 1)
+ */
+
+#include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <vector>
+#include "utility.h"
+#include "scanner.h"    // for MaxIdentLen
+#include "symtable.h"
+#include "ast_type.h"
+
+using namespace std;
+
+static const int NumGlobals = 100000;
+static const int NumScopes = 10000;
+static const int NumSteps = 4;         // sizes n/8, n/4, n/2, n
+static const double SuperlinearGrowth = 3.0;
+
+static volatile size_t sink;           // keeps results from being optimized away
+
+static double Now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static size_t HeapInUse() {
+    return mallinfo2().uordblks;
+}
+
+// distinct identifiers of the given length; the varying part is at the
+// end so comparisons have to walk the whole common prefix. They share one
+// buffer, freed with the list, so a run leaves the heap as it found it.
+class NameList {
+    vector<char> pool;
+    vector<char *> names;
+
+  public:
+    NameList(int count, int length) : pool(count * (MaxIdentLen + 1)) {
+        for (int i = 0; i < count; i++) {
+            char *buf = &pool[i * (MaxIdentLen + 1)];
+            int n = snprintf(buf, MaxIdentLen + 1, "v%d", i);
+            if (length > n) {
+                memmove(buf + length - n, buf, n + 1);
+                memset(buf, 'x', length - n);
+            }
+            names.push_back(buf);
+        }
+    }
+    char *operator[](int i) { return names[i]; }
+};
+
+struct Result {
+    double nsPerOp;
+    double bytesPerSymbol;   // < 0 when not measured
+};
+
+typedef Result (*Workload)(int n);
+
+// n globals inserted into one scope, then each looked up once
+static Result GlobalInsert(int n, int length) {
+    NameList names(n, length);
+    size_t before = HeapInUse();
+    SymbolTable *table = new SymbolTable();
+    double start = Now();
+    for (int i = 0; i < n; i++) {
+        Symbol sym(names[i], NULL, E_VarDecl);
+        table->insert(sym);
+    }
+    Result r = { (Now() - start) / n, double(HeapInUse() - before) / n };
+    sink += table->currentScope()->size();
+    delete table;
+    return r;
+}
+
+static Result GlobalFind(int n, int length) {
+    NameList names(n, length);
+    SymbolTable *table = new SymbolTable();
+    for (int i = 0; i < n; i++) {
+        Symbol sym(names[i], NULL, E_VarDecl);
+        table->insert(sym);
+    }
+    double start = Now();
+    for (int i = 0; i < n; i++)
+        sink += (size_t)table->find(names[(i * 7919) % n]);
+    Result r = { (Now() - start) / n, -1 };
+    delete table;
+    return r;
+}
+
+static Result ShortGlobalInsert(int n) { return GlobalInsert(n, 6); }
+static Result ShortGlobalFind(int n)   { return GlobalFind(n, 6); }
+static Result LongGlobalInsert(int n)  { return GlobalInsert(n, MaxIdentLen); }
+static Result LongGlobalFind(int n)    { return GlobalFind(n, MaxIdentLen); }
+
+// n nested scopes each holding one local, then a global looked up from
+// the innermost scope, which has to miss in every scope on the way out
+static Result NestedFindGlobal(int n) {
+    NameList names(n + 1, 8);
+    SymbolTable *table = new SymbolTable();
+    Symbol global(names[n], NULL, E_VarDecl);
+    table->insert(global);
+    for (int i = 0; i < n; i++) {
+        table->push();
+        Symbol sym(names[i], NULL, E_VarDecl);
+        table->insert(sym);
+    }
+    int lookups = 1000;
+    double start = Now();
+    for (int i = 0; i < lookups; i++)
+        sink += (size_t)table->find(names[n]);
+    Result r = { (Now() - start) / lookups, -1 };
+    delete table;
+    return r;
+}
+
+// push and pop of n scopes, one declaration each
+static Result NestedPushPop(int n) {
+    NameList names(n, 8);
+    SymbolTable *table = new SymbolTable();
+    double start = Now();
+    for (int i = 0; i < n; i++) {
+        table->push();
+        Symbol sym(names[i], NULL, E_VarDecl);
+        table->insert(sym);
+    }
+    for (int i = 0; i < n; i++)
+        table->pop();
+    Result r = { (Now() - start) / n, -1 };
+    delete table;
+    return r;
+}
+
+// the same name declared in each of n nested scopes; the innermost
+// declaration should be found without looking any further
+static Result Shadowing(int n) {
+    NameList names(n, MaxIdentLen);
+    SymbolTable *table = new SymbolTable();
+    for (int i = 0; i < n; i++) {
+        table->push();
+        Symbol sym(names[0], NULL, E_VarDecl);
+        table->insert(sym);
+    }
+    int lookups = 100000;
+    double start = Now();
+    for (int i = 0; i < lookups; i++)
+        sink += (size_t)table->find(names[0]);
+    Result r = { (Now() - start) / lookups, -1 };
+    delete table;
+    return r;
+}
+
+// the predicates Check() calls on every expression, over all built-in types
+static Result TypePredicates(int n) {
+    Type *types[] = { Type::intType, Type::uintType, Type::floatType, Type::boolType,
+                      Type::voidType, Type::vec2Type, Type::vec3Type, Type::vec4Type,
+                      Type::mat2Type, Type::mat3Type, Type::mat4Type, Type::ivec2Type,
+                      Type::ivec3Type, Type::ivec4Type, Type::bvec2Type, Type::bvec3Type,
+                      Type::bvec4Type, Type::uvec2Type, Type::uvec3Type, Type::uvec4Type,
+                      Type::errorType };
+    int numTypes = sizeof(types) / sizeof(types[0]);
+    double start = Now();
+    for (int i = 0; i < n; i++) {
+        Type *a = types[i % numTypes], *b = types[(i / numTypes) % numTypes];
+        sink += a->IsNumeric() + a->IsVector() + a->IsMatrix() + a->IsBool()
+              + a->GetVectorSize() + a->IsEquivalentTo(b) + a->IsConvertibleTo(b);
+    }
+    Result r = { (Now() - start) / n, -1 };
+    return r;
+}
+
+static void Run(const char *name, Workload work, int size) {
+    printf("%-22s", name);
+    double first = 0, last = 0;
+    double bytes = -1;
+    for (int step = NumSteps - 1; step >= 0; step--) {
+        int n = size >> step;
+        if (n < 1) n = 1;
+        Result r = work(n);
+        printf(" %9.1f", r.nsPerOp);
+        if (first == 0) first = r.nsPerOp;
+        last = r.nsPerOp;
+        bytes = r.bytesPerSymbol;
+    }
+    if (bytes >= 0)
+        printf(" %9.1f", bytes);
+    else
+        printf(" %9s", "-");
+    printf("  %s\n", last > first * SuperlinearGrowth ? "SUPERLINEAR" : "ok");
+}
+
+int main(int argc, char *argv[]) {
+    int scale = argc > 1 ? atoi(argv[1]) : 1;
+    if (scale < 1)
+        Failure("Usage: %s [scale]", argv[0]);
+
+    printf("%-22s", "workload (ns/op)");
+    for (int step = NumSteps - 1; step >= 0; step--)
+        printf(" %8s%d", "n/", 1 << step);
+    printf(" %9s\n", "B/symbol");
+
+    Run("global insert", ShortGlobalInsert, NumGlobals / scale);
+    Run("global find", ShortGlobalFind, NumGlobals / scale);
+    Run("long-name insert", LongGlobalInsert, NumGlobals / scale);
+    Run("long-name find", LongGlobalFind, NumGlobals / scale);
+    Run("nested push/pop", NestedPushPop, NumScopes / scale);
+    Run("nested find global", NestedFindGlobal, NumScopes / scale);
+    Run("shadowed find", Shadowing, NumScopes / scale);
+    Run("type predicates", TypePredicates, 100 * NumGlobals / scale);
+    return 0;
+}
@@ -14,19 +14,19 @@
 #include "ast.h"
 #include "ast_type.h"
 #include "ast_decl.h"
+#include "ast_stmt.h"
 
 using namespace std;
 // needs a global scope, either here or befor checks
 // oonstructor
-ScopedTable::ScopedTable(){}
+ScopedTable::ScopedTable() : frozen(false) {}
 
-// destructor 
+// names belong to the identifiers that declared them, not to the scope
 ScopedTable::~ScopedTable() {  
-	for (map<const char *, Symbol>::iterator it = symbols.begin(); it != symbols.end(); ++it)
-		delete it->first;
 } 
 
 void ScopedTable::insert(Symbol &sym){
+	Assert(!frozen);
 
 	char* name = sym.name;
 	symbols.insert(std::pair<char*, Symbol>(name, sym));
@@ -34,6 +34,7 @@ void ScopedTable::insert(Symbol &sym){
 }
 
 void ScopedTable::remove(Symbol &sym){
+	Assert(!frozen);
 
 	char* name = sym.name;
 	symbols.erase(name);
@@ -57,9 +58,129 @@ Symbol* ScopedTable::find(const char *name) {
 	}
 }
 
+// hash of a parameter type list: the built-in types are singletons so
+// their address identifies them, arrays hash their element type and size
+static size_t hashType(Type *t) {
+	ArrayType *arr = dynamic_cast<ArrayType*>(t);
+	if (arr != NULL)
+		return hashType(arr->GetElemType()) * 31 + arr->GetElemCount() + 1;
+	return std::hash<Type*>()(t);
+}
+
+size_t OverloadSet::hash(const Signature &sig) {
+	size_t h = sig.size();
+	for (int i = 0; i < sig.size(); i++)
+		h ^= hashType(sig[i]) + 0x9e3779b9 + (h << 6) + (h >> 2);
+	return h;
+}
+
+Signature OverloadSet::signatureOf(FnDecl *fn) {
+	Signature sig;
+	List<VarDecl*> *formals = fn->GetFormals();
+	for (int i = 0; i < formals->NumElements(); i++)
+		sig.push_back(formals->Nth(i)->GetType());
+	return sig;
+}
+
+static bool sameSignature(const Signature &a, const Signature &b) {
+	if (a.size() != b.size())
+		return false;
+	for (int i = 0; i < a.size(); i++)
+		if (!a[i]->IsEquivalentTo(b[i]))
+			return false;
+	return true;
+}
+
+FnDecl *OverloadSet::insert(FnDecl *fn) {
+	Signature sig = signatureOf(fn);
+	// a definition may complete a prototype of the shared scope, it then
+	// goes in this set and hides the prototype
+	FnDecl *inherited = parent ? parent->findExact(sig) : NULL;
+	if (inherited != NULL && (inherited->GetBody() != NULL || inherited->IsBuiltin() || fn->GetBody() == NULL))
+		return inherited;
+
+	vector<FnDecl *> &bucket = table[hash(sig)];
+	for (int i = 0; i < bucket.size(); i++) {
+		if (!sameSignature(signatureOf(bucket[i]), sig))
+			continue;
+		// a definition completes an earlier prototype
+		if (bucket[i]->GetBody() == NULL && !bucket[i]->IsBuiltin() && fn->GetBody() != NULL) {
+			bucket[i] = fn;
+			return NULL;
+		}
+		return bucket[i];
+	}
+	bucket.push_back(fn);
+	count++;
+	return NULL;
+}
+
+FnDecl *OverloadSet::findExact(const Signature &sig) {
+	unordered_map<size_t, vector<FnDecl *> >::iterator it = table.find(hash(sig));
+	if (it != table.end())
+		for (int i = 0; i < it->second.size(); i++)
+			if (sameSignature(signatureOf(it->second[i]), sig))
+				return it->second[i];
+	return parent ? parent->findExact(sig) : NULL;
+}
+
+FnDecl *OverloadSet::any() {
+	for (unordered_map<size_t, vector<FnDecl *> >::iterator it = table.begin(); it != table.end(); ++it)
+		if (!it->second.empty())
+			return it->second.front();
+	return parent ? parent->any() : NULL;
+}
+
+// probes every signature that converts exactly `left` more arguments from
+// position i on, collecting the distinct matches
+static void probeConversions(OverloadSet *set, Signature &sig, const vector<vector<Type *> > &alts,
+                             int i, int left, vector<FnDecl *> &found) {
+	if (left == 0) {
+		FnDecl *fn = set->findExact(sig);
+		for (int k = 0; k < found.size(); k++)
+			if (found[k] == fn) return;
+		if (fn) found.push_back(fn);
+		return;
+	}
+	if (sig.size() - i < left)
+		return;
+	Type *orig = sig[i];
+	for (int k = 0; k < alts[i].size(); k++) {
+		sig[i] = alts[i][k];
+		probeConversions(set, sig, alts, i+1, left-1, found);
+	}
+	sig[i] = orig;
+	probeConversions(set, sig, alts, i+1, left, found);
+}
+
+FnDecl *OverloadSet::resolve(const Signature &args, bool *ambiguous) {
+	*ambiguous = false;
+	FnDecl *exact = findExact(args);
+	if (exact)
+		return exact;
+
+	vector<vector<Type *> > alts(args.size());
+	for (int i = 0; i < args.size(); i++)
+		args[i]->ImplicitConversions(alts[i]);
+
+	Signature sig = args;
+	for (int conversions = 1; conversions <= args.size(); conversions++) {
+		vector<FnDecl *> found;
+		probeConversions(this, sig, alts, 0, conversions, found);
+		if (found.size() == 1)
+			return found[0];
+		if (found.size() > 1) {
+			*ambiguous = true;
+			return NULL;
+		}
+	}
+	return NULL;
+}
+
 // constructor
 SymbolTable::SymbolTable(){
 
+	shared = NULL;
 	returnType = NULL;
 	noReturnFlag = false;
 	funcFlag = false;
@@ -78,11 +199,24 @@ SymbolTable::SymbolTable(){
 	
 }
 
+// layered constructor: the shared scope stays below the unit's own
+// global scope and is only ever read
+SymbolTable::SymbolTable(ScopedTable *sharedGlobals){
+
+	Assert(sharedGlobals == NULL || sharedGlobals->isFrozen());
+	shared = sharedGlobals;
+	returnType = NULL;
+	noReturnFlag = false;
+	funcFlag = false;
+	breakFlag = false;
+	this->push();
+}
+
 // destructor 
 SymbolTable::~SymbolTable() {  
 
 	while (!tables.empty()){
-		tables.pop_back();
+		pop();
 	}
 } 
 
@@ -96,8 +230,11 @@ void SymbolTable::push(){
 	
 }
 
+// a frozen scope is shared by later tables and outlives this one
 void SymbolTable::pop(){
 	if (!tables.empty()){
+		if (!tables.back()->isFrozen())
+			delete tables.back();
 		tables.pop_back();
 	}
 }
@@ -152,25 +289,30 @@ Symbol* SymbolTable::find(const char *name) {
 	// }
 	
 	//cout << "return NULL from SymbolTable - find"<<endl;
-	return NULL;
+	return findShared(name);
+}
+
+Symbol* SymbolTable::findShared(const char *name) {
+	return shared ? shared->find(name) : NULL;
+}
+
+ScopedTable* SymbolTable::freezeGlobals() {
+	Assert(shared == NULL);
+	ScopedTable *globals = tables.front();
+	globals->freeze();
+	return globals;
 }
 
 bool MyStack::insideLoop(){
-	if (!stmtStack.empty() ){//&& stmtStack.front() == <dynamic_cast>Type::){///&& stmtStack.top() == <dynamic_cast>){
-		//stmtStack.pop_back(); // remove top of the stack
-		
-		return true;
-	}
+	for (int i = stmtStack.size() - 1; i >= 0; i--)
+		if (dynamic_cast<LoopStmt*>(stmtStack[i]) != NULL)
+			return true;
 	return false;
 }
 
 bool MyStack::insideSwitch(){
-
-	if (!stmtStack.empty()){
-		//stmtStack.pop_back();
-		
-		return true;
-	}
-	
+	for (int i = stmtStack.size() - 1; i >= 0; i--)
+		if (dynamic_cast<SwitchStmt*>(stmtStack[i]) != NULL)
+			return true;
 	return false;
 }
@@ -15,6 +15,7 @@
 
 #include <map>
 #include <vector>
+#include <unordered_map>
 #include <iostream>
 #include <string.h>
 #include "errors.h"
@@ -26,7 +27,10 @@ namespace llvm {
 using namespace std;
 
 class Decl;
+class FnDecl;
 class Stmt;
+class Type;
+class OverloadSet;
 
 enum EntryKind {
   E_FunctionDecl,
@@ -38,13 +42,49 @@ struct Symbol {
   Decl *decl;
   EntryKind kind;
   llvm::Value *value;
+  OverloadSet *overloads;  // every signature of a function name, else NULL
 
-  Symbol() : name(NULL), decl(NULL), kind(E_VarDecl), value(NULL) {}
+  Symbol() : name(NULL), decl(NULL), kind(E_VarDecl), value(NULL), overloads(NULL) {}
   Symbol(char *n, Decl *d, EntryKind k, llvm::Value *v = NULL) :
         name(n),
         decl(d),
         kind(k),
-        value(v) {}
+        value(v),
+        overloads(NULL) {}
+};
+
+typedef vector<Type *> Signature;
+
+/*
+ * Overload set holds all functions declared under one name. They are
+ * indexed by a hash of their parameter types, so an exact match is one
+ * probe. Failing that, resolve() probes the signatures reachable from the
+ * arguments by implicit conversions, fewest conversions first, which is
+ * bounded by the argument count and not by the number of overloads.
+ *
+ * A set may extend the set of the same name in a shared global scope
+ * (see SymbolTable below); lookups fall through to it, inserts never
+ * touch it.
+ */
+class OverloadSet {
+  unordered_map<size_t, vector<FnDecl *> > table;
+  int count;
+  OverloadSet *parent;
+
+  public:
+    OverloadSet(OverloadSet *p = NULL) : count(0), parent(p) {}
+
+    static size_t hash(const Signature &sig);
+    static Signature signatureOf(FnDecl *fn);
+
+    // returns the already declared function with the same signature, or
+    // NULL after adding fn to the set
+    FnDecl *insert(FnDecl *fn);
+    FnDecl *findExact(const Signature &sig);
+    FnDecl *resolve(const Signature &args, bool *ambiguous);
+
+    int size() const { return count + (parent ? parent->size() : 0); }
+    FnDecl *any();
 };
 
 struct lessStr {
@@ -56,6 +96,7 @@ typedef map<const char *, Symbol, lessStr>::iterator SymbolIterator;
 
 class ScopedTable {
   map<const char *, Symbol, lessStr> symbols;
+  bool frozen;
 
   public:
     ScopedTable();
@@ -64,13 +105,28 @@ class ScopedTable {
     void insert(Symbol &sym); 
     void remove(Symbol &sym);
     Symbol *find(const char *name);
+
+    // a frozen scope is never modified again, so the symbol tables
+    // layered on it can't change what it declares
+    void freeze() { frozen = true; }
+    bool isFrozen() const { return frozen; }
+    int size() const { return symbols.size(); }
 };
    
+/*
+ * Symbol table may sit on top of a shared, frozen global scope built once
+ * for a bundle of translation units (uniforms, consts, prototypes and the
+ * built-ins). Its own scopes start with the unit's global scope; find()
+ * falls back to the shared scope last, and the shared scope is never
+ * copied or written.
+ */
 class SymbolTable {
+    ScopedTable *shared;
 
   public:
     vector<ScopedTable *> tables;  //changed it to public cant access from decl otherwise
     SymbolTable();
+    SymbolTable(ScopedTable *sharedGlobals);
     ~SymbolTable();
 
     void push();
@@ -79,9 +135,15 @@ class SymbolTable {
     void insert(Symbol &sym);
     void remove(Symbol &sym);
     Symbol *find(const char *name);
+    Symbol *findShared(const char *name);
 
     bool isGlobalScope() const { return (tables.size() == 1); }
     ScopedTable * currentScope(){ return tables.back(); }
+    ScopedTable * sharedScope() { return shared; }
+
+    // freezes this table's global scope for use as the shared scope of
+    // later symbol tables; only valid on a table without a shared scope
+    ScopedTable *freezeGlobals();
 
     Type *returnType;
     bool noReturnFlag, funcFlag, breakFlag;
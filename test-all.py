@@ -9,6 +9,12 @@ import os
 from subprocess import *
 
 TEST_DIRECTORY = 'public_samples'
+# objects compiled by one run are reused by the next, see objcache.h;
+# tests also keep the files they write in it
+JIT_CACHE = os.path.join(TEST_DIRECTORY, '.jit-cache')
+# the test run twice with a cache of its own, to check the second run
+# reuses what the first compiled
+CACHE_TEST = 'foo'
 
 
 def main(): 
@@ -19,6 +25,10 @@ def main():
   if (makeResult.wait() != 0): 
     print '\033[0;36m' + 'FATAL ERROR' + '\033[0;0m' + ': make failed to compile'
     return
+  if not (os.path.isdir(JIT_CACHE)):
+    os.makedirs(JIT_CACHE)
+  # perf's jitdump files too, rather than under ~/.debug
+  os.environ['JITDUMPDIR'] = os.path.abspath(JIT_CACHE)
 
   for _, _, files in os.walk(TEST_DIRECTORY):
     for file in files:
@@ -28,13 +38,18 @@ def main():
       testName = file.split('.')[0]
       refName = os.path.join(TEST_DIRECTORY, '%s.%s' % (testName, "out"))
       if not (checkFileExt(refName)): continue
-      datName = os.path.join(TEST_DIRECTORY, '%s.%s' % (testName, "dat"))
-      if not (checkFileExt(datName)): continue
+      flagsName = os.path.join(TEST_DIRECTORY, '%s.%s' % (testName, "flags"))
+      if (os.path.isfile(flagsName)):
+        flags = open(flagsName).read().strip()
+      else:
+        datName = os.path.join(TEST_DIRECTORY, '%s.%s' % (testName, "dat"))
+        if not (checkFileExt(datName)): continue
+        flags = '--run ' + datName
       # Run that test like you mean it
-      testResults += runTest(file, refName)
+      testResults += runTest(file, refName, flags, JIT_CACHE)
+  totalTests += 1
+  testResults += runCacheTest(CACHE_TEST)
   printTestResults(testResults, totalTests)
-  # Perform cleanup on binary files
-  Popen("rm -rf " + os.path.join(TEST_DIRECTORY, "*.bc"), shell = True)
 
 def checkFileExt(name):
   if not (os.path.isfile(name)):
@@ -43,20 +58,44 @@ def checkFileExt(name):
     return False
   return True
 
-def run(test, log):
-  fullPath = os.path.join(TEST_DIRECTORY, test)
-  ret = Popen('./glc < ' + fullPath, shell = True, stderr = STDOUT, stdout = log)
-  ret.wait()
-  return ret
-
-def runTest(glslFile, outFile):
-  bcFile = os.path.join(TEST_DIRECTORY, '%s.bc' % glslFile.split('.')[0])
-  with open(bcFile, "w") as log:
-    glcResult = run(glslFile, log)
-  gliResult = Popen('./gli ' + bcFile, shell = True, stderr = STDOUT, stdout = PIPE)
-  result = Popen('diff -w - ' + outFile, shell = True, stdin = gliResult.stdout, stdout = PIPE)
+# compiles the shader and by default makes the harness's calls in one
+# process. A test's .flags file, if it has one, holds the rest of the
+# command line instead, "--dispatch 8x8 shade -globals <file.dat>" say,
+# which may go on into a shell pipeline turning raw output into text.
+# glc's messages are part of its output, the shell's own are not; a test
+# of a failure pipes glc into cat, so the shell reports the signal glc
+# aborts on apart from it
+def runTest(glslFile, outFile, flags, cache):
+  fullPath = os.path.join(TEST_DIRECTORY, glslFile)
+  glcResult = Popen('./glc -jit-cache=' + cache + ' < ' + fullPath + ' 2>&1 ' + flags, shell = True, stderr = open(os.devnull, 'w'), stdout = PIPE)
+  result = Popen('diff -w - ' + outFile, shell = True, stdin = glcResult.stdout, stdout = PIPE)
   return colorifyTestResult(glslFile, result)
 
+# the cache's objects by name, each with its inode, which a new object
+# stored under the same name would change
+def cachedObjects(cache):
+  objects = {}
+  for name in os.listdir(cache):
+    objects[name] = os.stat(os.path.join(cache, name)).st_ino
+  return objects
+
+# runs a test with an empty cache, then again: the second run has to
+# give the same results without storing anything
+def runCacheTest(testName):
+  cache = os.path.join(JIT_CACHE, 'hit')
+  Popen('rm -rf ' + cache, shell = True).wait()
+  glslFile = testName + '.glsl'
+  outFile = os.path.join(TEST_DIRECTORY, testName + '.out')
+  flags = '--run ' + os.path.join(TEST_DIRECTORY, testName + '.dat')
+  if not (runTest(glslFile, outFile, flags, cache)): return 0
+  before = cachedObjects(cache)
+  passed = runTest(glslFile, outFile, flags, cache)
+  if (len(before) == 0 or cachedObjects(cache) != before):
+    print 'Second run of %s compiled again instead of loading %s' % (glslFile, cache)
+    print 'Result: ' + '\033[0;36m' + 'FAIL' + '\033[0;0m' + '\n'
+    return 0
+  return passed
+
 def colorifyTestResult(glslFile, result): 
   output = ''.join(result.stdout.readlines())
   print '++ Executing %s' % (glslFile)
@@ -0,0 +1,108 @@
+/* File: threadpool.cc
+ * -------------------
+ * Implementation of the work-stealing thread pool.
+ */
+
+#include <stdlib.h>
+#include <new>
+#include "threadpool.h"
+#include "utility.h"
+
+ThreadPool::ThreadPool(int numThreads) :
+    nextQueue(0),
+    queued(0),
+    unfinished(0),
+    stopping(false)
+{
+    if (numThreads <= 0)
+        numThreads = std::thread::hardware_concurrency();
+    if (numThreads <= 0)
+        numThreads = 1;
+    // C++14's new ignores alignment beyond the default, so the queues
+    // are placed in storage aligned by hand
+    for (int i = 0; i < numThreads; i++) {
+        void *storage;
+        if (posix_memalign(&storage, alignof(Queue), sizeof(Queue)) != 0)
+            Failure("Out of memory for the thread pool");
+        queues.push_back(new (storage) Queue());
+    }
+    for (int i = 0; i < numThreads; i++)
+        workers.push_back(std::thread(&ThreadPool::WorkerLoop, this, i));
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (size_t i = 0; i < workers.size(); i++)
+        workers[i].join();
+    for (size_t i = 0; i < queues.size(); i++) {
+        queues[i]->~Queue();
+        free(queues[i]);
+    }
+}
+
+void ThreadPool::Submit(const Task &task) {
+    Queue *q = queues[nextQueue];
+    nextQueue = (nextQueue + 1) % queues.size();
+    unfinished++;
+    {
+        std::lock_guard<std::mutex> guard(q->lock);
+        q->tasks.push_back(task);
+    }
+    {
+        // under the sleep lock so a worker about to sleep sees the task
+        std::lock_guard<std::mutex> guard(sleepLock);
+        queued++;
+    }
+    wake.notify_one();
+}
+
+void ThreadPool::Wait() {
+    std::unique_lock<std::mutex> guard(sleepLock);
+    idle.wait(guard, [this] { return unfinished == 0; });
+}
+
+// the newest task of the worker's own deque, else the oldest of the
+// first other deque that has one
+bool ThreadPool::TakeTask(int worker, Task &task) {
+    int n = queues.size();
+    for (int i = 0; i < n; i++) {
+        Queue *q = queues[(worker + i) % n];
+        std::lock_guard<std::mutex> guard(q->lock);
+        if (q->tasks.empty())
+            continue;
+        if (i == 0) {
+            task = q->tasks.back();
+            q->tasks.pop_back();
+        }
+        else {
+            task = q->tasks.front();
+            q->tasks.pop_front();
+        }
+        queued--;
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::WorkerLoop(int worker) {
+    for (;;) {
+        Task task;
+        if (TakeTask(worker, task)) {
+            task(worker);
+            if (--unfinished == 0) {
+                std::lock_guard<std::mutex> guard(sleepLock);
+                idle.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> guard(sleepLock);
+        wake.wait(guard, [this] { return stopping || queued > 0; });
+        if (stopping && queued == 0)
+            return;
+    }
+}
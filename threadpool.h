@@ -0,0 +1,59 @@
+/**
+ * File: threadpool.h
+ * ------------------
+ * A fixed set of worker threads running tasks by work stealing. Each
+ * worker has its own deque: it runs the task it queued last first and,
+ * once its deque is empty, steals the oldest task of another worker, so
+ * tasks of very uneven cost still keep every core busy to the end.
+ */
+
+#ifndef _H_threadpool
+#define _H_threadpool
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+  public:
+    // a task is told which worker runs it, for per-worker scratch state
+    typedef std::function<void(int worker)> Task;
+
+    // numThreads 0 sizes the pool to the machine's hardware threads
+    explicit ThreadPool(int numThreads = 0);
+    ~ThreadPool();
+
+    int NumWorkers() const { return (int)workers.size(); }
+
+    // queues a task, spreading them round robin over the workers' deques
+    void Submit(const Task &task);
+    // returns once every task submitted so far has finished
+    void Wait();
+
+  private:
+    // one per worker, on its own cache line so taking from your own
+    // deque never contends with a neighbour's
+    struct alignas(64) Queue {
+        std::mutex lock;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::thread> workers;
+    std::vector<Queue*> queues;
+    int nextQueue;
+
+    std::mutex sleepLock;
+    std::condition_variable wake, idle;
+    std::atomic<int> queued;     // tasks waiting in some deque
+    std::atomic<int> unfinished; // tasks submitted and not yet done
+    bool stopping;
+
+    bool TakeTask(int worker, Task &task);
+    void WorkerLoop(int worker);
+};
+
+#endif
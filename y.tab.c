@@ -1,21 +1,22 @@
-/* A Bison parser, made by GNU Bison 2.7.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
-   
-      Copyright (C) 1984, 1989-1990, 2000-2012 Free Software Foundation, Inc.
-   
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
    the Free Software Foundation, either version 3 of the License, or
    (at your option) any later version.
-   
+
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
    GNU General Public License for more details.
-   
+
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -26,13 +27,17 @@
    special exception, which will cause the skeleton and the resulting
    Bison output files to be licensed under the GNU General Public
    License without this special exception.
-   
+
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -40,11 +45,11 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "2.7"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -61,8 +66,7 @@
 
 
 
-/* Copy the first part of user declarations.  */
-/* Line 371 of yacc.c  */
+/* First part of user prologue.  */
 #line 11 "parser.y"
 
 
@@ -78,31 +82,37 @@
 
 void yyerror(const char *msg); // standard error-handling routine
 
+Program *parsedProgram = NULL; // result of the last successful yyparse()
+
 
-/* Line 371 of yacc.c  */
-#line 84 "y.tab.c"
+#line 89 "y.tab.c"
 
-# ifndef YY_NULL
-#  if defined __cplusplus && 201103L <= __cplusplus
-#   define YY_NULL nullptr
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
 #  else
-#   define YY_NULL 0
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
-
-/* In a future release of Bison, this section will be replaced
-   by #include "y.tab.h".  */
+/* Use api.header.include to #include this header
+   instead of duplicating it here.  */
 #ifndef YY_YY_Y_TAB_H_INCLUDED
 # define YY_YY_Y_TAB_H_INCLUDED
-/* Enabling traces.  */
+/* Debug traces.  */
 #ifndef YYDEBUG
 # define YYDEBUG 1
 #endif
@@ -110,87 +120,96 @@ void yyerror(const char *msg); // standard error-handling routine
 extern int yydebug;
 #endif
 
-/* Tokens.  */
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     T_Void = 258,
-     T_Bool = 259,
-     T_Int = 260,
-     T_Float = 261,
-     T_Uint = 262,
-     T_Bvec2 = 263,
-     T_Bvec3 = 264,
-     T_Bvec4 = 265,
-     T_Ivec2 = 266,
-     T_Ivec3 = 267,
-     T_Ivec4 = 268,
-     T_Uvec2 = 269,
-     T_Uvec3 = 270,
-     T_Uvec4 = 271,
-     T_Vec2 = 272,
-     T_Vec3 = 273,
-     T_Vec4 = 274,
-     T_Mat2 = 275,
-     T_Mat3 = 276,
-     T_Mat4 = 277,
-     T_While = 278,
-     T_For = 279,
-     T_If = 280,
-     T_Else = 281,
-     T_Return = 282,
-     T_Break = 283,
-     T_Continue = 284,
-     T_Do = 285,
-     T_Switch = 286,
-     T_Case = 287,
-     T_Default = 288,
-     T_In = 289,
-     T_Out = 290,
-     T_Const = 291,
-     T_Uniform = 292,
-     T_LeftParen = 293,
-     T_RightParen = 294,
-     T_LeftBracket = 295,
-     T_RightBracket = 296,
-     T_LeftBrace = 297,
-     T_RightBrace = 298,
-     T_Dot = 299,
-     T_Comma = 300,
-     T_Colon = 301,
-     T_Semicolon = 302,
-     T_Question = 303,
-     T_LessEqual = 304,
-     T_GreaterEqual = 305,
-     T_EQ = 306,
-     T_NE = 307,
-     T_And = 308,
-     T_Or = 309,
-     T_Plus = 310,
-     T_Star = 311,
-     T_MulAssign = 312,
-     T_DivAssign = 313,
-     T_AddAssign = 314,
-     T_SubAssign = 315,
-     T_Equal = 316,
-     T_LeftAngle = 317,
-     T_RightAngle = 318,
-     T_Dash = 319,
-     T_Slash = 320,
-     T_Inc = 321,
-     T_Dec = 322,
-     T_Identifier = 323,
-     T_IntConstant = 324,
-     T_FloatConstant = 325,
-     T_BoolConstant = 326,
-     T_FieldSelection = 327,
-     LOWEST = 328,
-     LOWER_THAN_ELSE = 329
-   };
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    T_Void = 258,                  /* T_Void  */
+    T_Bool = 259,                  /* T_Bool  */
+    T_Int = 260,                   /* T_Int  */
+    T_Float = 261,                 /* T_Float  */
+    T_Uint = 262,                  /* T_Uint  */
+    T_Bvec2 = 263,                 /* T_Bvec2  */
+    T_Bvec3 = 264,                 /* T_Bvec3  */
+    T_Bvec4 = 265,                 /* T_Bvec4  */
+    T_Ivec2 = 266,                 /* T_Ivec2  */
+    T_Ivec3 = 267,                 /* T_Ivec3  */
+    T_Ivec4 = 268,                 /* T_Ivec4  */
+    T_Uvec2 = 269,                 /* T_Uvec2  */
+    T_Uvec3 = 270,                 /* T_Uvec3  */
+    T_Uvec4 = 271,                 /* T_Uvec4  */
+    T_Vec2 = 272,                  /* T_Vec2  */
+    T_Vec3 = 273,                  /* T_Vec3  */
+    T_Vec4 = 274,                  /* T_Vec4  */
+    T_Mat2 = 275,                  /* T_Mat2  */
+    T_Mat3 = 276,                  /* T_Mat3  */
+    T_Mat4 = 277,                  /* T_Mat4  */
+    T_While = 278,                 /* T_While  */
+    T_For = 279,                   /* T_For  */
+    T_If = 280,                    /* T_If  */
+    T_Else = 281,                  /* T_Else  */
+    T_Return = 282,                /* T_Return  */
+    T_Break = 283,                 /* T_Break  */
+    T_Continue = 284,              /* T_Continue  */
+    T_Do = 285,                    /* T_Do  */
+    T_Switch = 286,                /* T_Switch  */
+    T_Case = 287,                  /* T_Case  */
+    T_Default = 288,               /* T_Default  */
+    T_In = 289,                    /* T_In  */
+    T_Out = 290,                   /* T_Out  */
+    T_Const = 291,                 /* T_Const  */
+    T_Uniform = 292,               /* T_Uniform  */
+    T_LeftParen = 293,             /* T_LeftParen  */
+    T_RightParen = 294,            /* T_RightParen  */
+    T_LeftBracket = 295,           /* T_LeftBracket  */
+    T_RightBracket = 296,          /* T_RightBracket  */
+    T_LeftBrace = 297,             /* T_LeftBrace  */
+    T_RightBrace = 298,            /* T_RightBrace  */
+    T_Dot = 299,                   /* T_Dot  */
+    T_Comma = 300,                 /* T_Comma  */
+    T_Colon = 301,                 /* T_Colon  */
+    T_Semicolon = 302,             /* T_Semicolon  */
+    T_Question = 303,              /* T_Question  */
+    T_LessEqual = 304,             /* T_LessEqual  */
+    T_GreaterEqual = 305,          /* T_GreaterEqual  */
+    T_EQ = 306,                    /* T_EQ  */
+    T_NE = 307,                    /* T_NE  */
+    T_And = 308,                   /* T_And  */
+    T_Or = 309,                    /* T_Or  */
+    T_Plus = 310,                  /* T_Plus  */
+    T_Star = 311,                  /* T_Star  */
+    T_MulAssign = 312,             /* T_MulAssign  */
+    T_DivAssign = 313,             /* T_DivAssign  */
+    T_AddAssign = 314,             /* T_AddAssign  */
+    T_SubAssign = 315,             /* T_SubAssign  */
+    T_Equal = 316,                 /* T_Equal  */
+    T_LeftAngle = 317,             /* T_LeftAngle  */
+    T_RightAngle = 318,            /* T_RightAngle  */
+    T_Dash = 319,                  /* T_Dash  */
+    T_Slash = 320,                 /* T_Slash  */
+    T_Inc = 321,                   /* T_Inc  */
+    T_Dec = 322,                   /* T_Dec  */
+    T_Identifier = 323,            /* T_Identifier  */
+    T_IntConstant = 324,           /* T_IntConstant  */
+    T_FloatConstant = 325,         /* T_FloatConstant  */
+    T_BoolConstant = 326,          /* T_BoolConstant  */
+    T_FieldSelection = 327,        /* T_FieldSelection  */
+    T_Pragma = 328,                /* T_Pragma  */
+    LOWEST = 329,                  /* LOWEST  */
+    LOWER_THAN_ELSE = 330          /* LOWER_THAN_ELSE  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
-/* Tokens.  */
+/* Token kinds.  */
+#define YYEMPTY -2
+#define YYEOF 0
+#define YYerror 256
+#define YYUNDEF 257
 #define T_Void 258
 #define T_Bool 259
 #define T_Int 260
@@ -261,16 +280,15 @@ extern int yydebug;
 #define T_FloatConstant 325
 #define T_BoolConstant 326
 #define T_FieldSelection 327
-#define LOWEST 328
-#define LOWER_THAN_ELSE 329
-
-
+#define T_Pragma 328
+#define LOWEST 329
+#define LOWER_THAN_ELSE 330
 
+/* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
+union YYSTYPE
 {
-/* Line 387 of yacc.c  */
-#line 41 "parser.y"
+#line 43 "parser.y"
 
     int integerConstant;
     bool boolConstant;
@@ -290,80 +308,244 @@ typedef union YYSTYPE
     Identifier *funcId;
     List<Expr*> *argList;
 
+#line 312 "y.tab.c"
 
-/* Line 387 of yacc.c  */
-#line 296 "y.tab.c"
-} YYSTYPE;
+};
+typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
 # define YYSTYPE_IS_DECLARED 1
 #endif
 
+/* Location type.  */
 #if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
-typedef struct YYLTYPE
+typedef struct YYLTYPE YYLTYPE;
+struct YYLTYPE
 {
   int first_line;
   int first_column;
   int last_line;
   int last_column;
-} YYLTYPE;
-# define yyltype YYLTYPE /* obsolescent; will be withdrawn */
+};
 # define YYLTYPE_IS_DECLARED 1
 # define YYLTYPE_IS_TRIVIAL 1
 #endif
 
+
 extern YYSTYPE yylval;
 extern YYLTYPE yylloc;
-#ifdef YYPARSE_PARAM
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void *YYPARSE_PARAM);
-#else
-int yyparse ();
-#endif
-#else /* ! YYPARSE_PARAM */
-#if defined __STDC__ || defined __cplusplus
+
 int yyparse (void);
-#else
-int yyparse ();
-#endif
-#endif /* ! YYPARSE_PARAM */
+
 
 #endif /* !YY_YY_Y_TAB_H_INCLUDED  */
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_T_Void = 3,                     /* T_Void  */
+  YYSYMBOL_T_Bool = 4,                     /* T_Bool  */
+  YYSYMBOL_T_Int = 5,                      /* T_Int  */
+  YYSYMBOL_T_Float = 6,                    /* T_Float  */
+  YYSYMBOL_T_Uint = 7,                     /* T_Uint  */
+  YYSYMBOL_T_Bvec2 = 8,                    /* T_Bvec2  */
+  YYSYMBOL_T_Bvec3 = 9,                    /* T_Bvec3  */
+  YYSYMBOL_T_Bvec4 = 10,                   /* T_Bvec4  */
+  YYSYMBOL_T_Ivec2 = 11,                   /* T_Ivec2  */
+  YYSYMBOL_T_Ivec3 = 12,                   /* T_Ivec3  */
+  YYSYMBOL_T_Ivec4 = 13,                   /* T_Ivec4  */
+  YYSYMBOL_T_Uvec2 = 14,                   /* T_Uvec2  */
+  YYSYMBOL_T_Uvec3 = 15,                   /* T_Uvec3  */
+  YYSYMBOL_T_Uvec4 = 16,                   /* T_Uvec4  */
+  YYSYMBOL_T_Vec2 = 17,                    /* T_Vec2  */
+  YYSYMBOL_T_Vec3 = 18,                    /* T_Vec3  */
+  YYSYMBOL_T_Vec4 = 19,                    /* T_Vec4  */
+  YYSYMBOL_T_Mat2 = 20,                    /* T_Mat2  */
+  YYSYMBOL_T_Mat3 = 21,                    /* T_Mat3  */
+  YYSYMBOL_T_Mat4 = 22,                    /* T_Mat4  */
+  YYSYMBOL_T_While = 23,                   /* T_While  */
+  YYSYMBOL_T_For = 24,                     /* T_For  */
+  YYSYMBOL_T_If = 25,                      /* T_If  */
+  YYSYMBOL_T_Else = 26,                    /* T_Else  */
+  YYSYMBOL_T_Return = 27,                  /* T_Return  */
+  YYSYMBOL_T_Break = 28,                   /* T_Break  */
+  YYSYMBOL_T_Continue = 29,                /* T_Continue  */
+  YYSYMBOL_T_Do = 30,                      /* T_Do  */
+  YYSYMBOL_T_Switch = 31,                  /* T_Switch  */
+  YYSYMBOL_T_Case = 32,                    /* T_Case  */
+  YYSYMBOL_T_Default = 33,                 /* T_Default  */
+  YYSYMBOL_T_In = 34,                      /* T_In  */
+  YYSYMBOL_T_Out = 35,                     /* T_Out  */
+  YYSYMBOL_T_Const = 36,                   /* T_Const  */
+  YYSYMBOL_T_Uniform = 37,                 /* T_Uniform  */
+  YYSYMBOL_T_LeftParen = 38,               /* T_LeftParen  */
+  YYSYMBOL_T_RightParen = 39,              /* T_RightParen  */
+  YYSYMBOL_T_LeftBracket = 40,             /* T_LeftBracket  */
+  YYSYMBOL_T_RightBracket = 41,            /* T_RightBracket  */
+  YYSYMBOL_T_LeftBrace = 42,               /* T_LeftBrace  */
+  YYSYMBOL_T_RightBrace = 43,              /* T_RightBrace  */
+  YYSYMBOL_T_Dot = 44,                     /* T_Dot  */
+  YYSYMBOL_T_Comma = 45,                   /* T_Comma  */
+  YYSYMBOL_T_Colon = 46,                   /* T_Colon  */
+  YYSYMBOL_T_Semicolon = 47,               /* T_Semicolon  */
+  YYSYMBOL_T_Question = 48,                /* T_Question  */
+  YYSYMBOL_T_LessEqual = 49,               /* T_LessEqual  */
+  YYSYMBOL_T_GreaterEqual = 50,            /* T_GreaterEqual  */
+  YYSYMBOL_T_EQ = 51,                      /* T_EQ  */
+  YYSYMBOL_T_NE = 52,                      /* T_NE  */
+  YYSYMBOL_T_And = 53,                     /* T_And  */
+  YYSYMBOL_T_Or = 54,                      /* T_Or  */
+  YYSYMBOL_T_Plus = 55,                    /* T_Plus  */
+  YYSYMBOL_T_Star = 56,                    /* T_Star  */
+  YYSYMBOL_T_MulAssign = 57,               /* T_MulAssign  */
+  YYSYMBOL_T_DivAssign = 58,               /* T_DivAssign  */
+  YYSYMBOL_T_AddAssign = 59,               /* T_AddAssign  */
+  YYSYMBOL_T_SubAssign = 60,               /* T_SubAssign  */
+  YYSYMBOL_T_Equal = 61,                   /* T_Equal  */
+  YYSYMBOL_T_LeftAngle = 62,               /* T_LeftAngle  */
+  YYSYMBOL_T_RightAngle = 63,              /* T_RightAngle  */
+  YYSYMBOL_T_Dash = 64,                    /* T_Dash  */
+  YYSYMBOL_T_Slash = 65,                   /* T_Slash  */
+  YYSYMBOL_T_Inc = 66,                     /* T_Inc  */
+  YYSYMBOL_T_Dec = 67,                     /* T_Dec  */
+  YYSYMBOL_T_Identifier = 68,              /* T_Identifier  */
+  YYSYMBOL_T_IntConstant = 69,             /* T_IntConstant  */
+  YYSYMBOL_T_FloatConstant = 70,           /* T_FloatConstant  */
+  YYSYMBOL_T_BoolConstant = 71,            /* T_BoolConstant  */
+  YYSYMBOL_T_FieldSelection = 72,          /* T_FieldSelection  */
+  YYSYMBOL_T_Pragma = 73,                  /* T_Pragma  */
+  YYSYMBOL_LOWEST = 74,                    /* LOWEST  */
+  YYSYMBOL_LOWER_THAN_ELSE = 75,           /* LOWER_THAN_ELSE  */
+  YYSYMBOL_YYACCEPT = 76,                  /* $accept  */
+  YYSYMBOL_Program = 77,                   /* Program  */
+  YYSYMBOL_DeclList = 78,                  /* DeclList  */
+  YYSYMBOL_Decl = 79,                      /* Decl  */
+  YYSYMBOL_Declaration = 80,               /* Declaration  */
+  YYSYMBOL_FuncDecl = 81,                  /* FuncDecl  */
+  YYSYMBOL_ParameterList = 82,             /* ParameterList  */
+  YYSYMBOL_SingleDecl = 83,                /* SingleDecl  */
+  YYSYMBOL_Initializer = 84,               /* Initializer  */
+  YYSYMBOL_TypeQualify = 85,               /* TypeQualify  */
+  YYSYMBOL_TypeDecl = 86,                  /* TypeDecl  */
+  YYSYMBOL_CompoundStatement = 87,         /* CompoundStatement  */
+  YYSYMBOL_StatementList = 88,             /* StatementList  */
+  YYSYMBOL_Statement = 89,                 /* Statement  */
+  YYSYMBOL_SingleStatement = 90,           /* SingleStatement  */
+  YYSYMBOL_SelectionStmt = 91,             /* SelectionStmt  */
+  YYSYMBOL_SwitchStmt = 92,                /* SwitchStmt  */
+  YYSYMBOL_CaseStmt = 93,                  /* CaseStmt  */
+  YYSYMBOL_JumpStmt = 94,                  /* JumpStmt  */
+  YYSYMBOL_WhileStmt = 95,                 /* WhileStmt  */
+  YYSYMBOL_ForStmt = 96,                   /* ForStmt  */
+  YYSYMBOL_PrimaryExpr = 97,               /* PrimaryExpr  */
+  YYSYMBOL_FunctionCallExpr = 98,          /* FunctionCallExpr  */
+  YYSYMBOL_FunctionCallHeaderNoParameters = 99, /* FunctionCallHeaderNoParameters  */
+  YYSYMBOL_FunctionCallHeaderWithParameters = 100, /* FunctionCallHeaderWithParameters  */
+  YYSYMBOL_ArgumentList = 101,             /* ArgumentList  */
+  YYSYMBOL_FunctionIdentifier = 102,       /* FunctionIdentifier  */
+  YYSYMBOL_PostfixExpr = 103,              /* PostfixExpr  */
+  YYSYMBOL_UnaryExpr = 104,                /* UnaryExpr  */
+  YYSYMBOL_MultiExpr = 105,                /* MultiExpr  */
+  YYSYMBOL_AdditionExpr = 106,             /* AdditionExpr  */
+  YYSYMBOL_RelationExpr = 107,             /* RelationExpr  */
+  YYSYMBOL_EqualityExpr = 108,             /* EqualityExpr  */
+  YYSYMBOL_LogicAndExpr = 109,             /* LogicAndExpr  */
+  YYSYMBOL_LogicOrExpr = 110,              /* LogicOrExpr  */
+  YYSYMBOL_Expression = 111,               /* Expression  */
+  YYSYMBOL_AssignOp = 112                  /* AssignOp  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
 
-/* Copy the second part of user declarations.  */
 
-/* Line 390 of yacc.c  */
-#line 337 "y.tab.c"
 
 #ifdef short
 # undef short
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
-#else
-typedef unsigned char yytype_uint8;
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
-#elif (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
 typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-typedef short int yytype_int8;
+typedef short yytype_int16;
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef short int yytype_int16;
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -371,16 +553,28 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_uint8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
@@ -394,32 +588,71 @@ typedef short int yytype_int16;
 # endif
 #endif
 
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-/* Identity function, used to suppress warnings about constant conditions.  */
-#ifndef lint
-# define YYID(N) (N)
-#else
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static int
-YYID (int yyi)
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
 #else
-static int
-YYID (yyi)
-    int yyi;
+# define YY_INITIAL_VALUE(Value) Value
 #endif
-{
-  return yyi;
-}
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
 #endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -436,8 +669,7 @@ YYID (yyi)
 #    define alloca _alloca
 #   else
 #    define YYSTACK_ALLOC alloca
-#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
 #     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
       /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
 #     ifndef EXIT_SUCCESS
@@ -449,8 +681,8 @@ YYID (yyi)
 # endif
 
 # ifdef YYSTACK_ALLOC
-   /* Pacify GCC's `empty if-body' warning.  */
-#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (YYID (0))
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
     /* The OS might guarantee only one guard page at the bottom of the stack,
        and a page size can be as small as 4096 bytes.  So we cannot safely
@@ -466,7 +698,7 @@ YYID (yyi)
 #  endif
 #  if (defined __cplusplus && ! defined EXIT_SUCCESS \
        && ! ((defined YYMALLOC || defined malloc) \
-	     && (defined YYFREE || defined free)))
+             && (defined YYFREE || defined free)))
 #   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
 #   ifndef EXIT_SUCCESS
 #    define EXIT_SUCCESS 0
@@ -474,42 +706,40 @@ YYID (yyi)
 #  endif
 #  ifndef YYMALLOC
 #   define YYMALLOC malloc
-#   if ! defined malloc && ! defined EXIT_SUCCESS && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined malloc && ! defined EXIT_SUCCESS
 void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 #  ifndef YYFREE
 #   define YYFREE free
-#   if ! defined free && ! defined EXIT_SUCCESS && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined free && ! defined EXIT_SUCCESS
 void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
-	 || (defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL \
-	     && defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+         || (defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL \
+             && defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
 
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
   YYLTYPE yyls_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE) + sizeof (YYLTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE) \
+             + YYSIZEOF (YYLTYPE)) \
       + 2 * YYSTACK_GAP_MAXIMUM)
 
 # define YYCOPY_NEEDED 1
@@ -519,16 +749,16 @@ union yyalloc
    elements in the stack, and YYPTR gives the new location of the
    stack.  Advance YYPTR to a properly aligned location for the next
    stack.  */
-# define YYSTACK_RELOCATE(Stack_alloc, Stack)				\
-    do									\
-      {									\
-	YYSIZE_T yynewbytes;						\
-	YYCOPY (&yyptr->Stack_alloc, Stack, yysize);			\
-	Stack = &yyptr->Stack_alloc;					\
-	yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-	yyptr += yynewbytes / sizeof (*yyptr);				\
-      }									\
-    while (YYID (0))
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
 
 #endif
 
@@ -538,16 +768,16 @@ union yyalloc
 # ifndef YYCOPY
 #  if defined __GNUC__ && 1 < __GNUC__
 #   define YYCOPY(Dst, Src, Count) \
-      __builtin_memcpy (Dst, Src, (Count) * sizeof (*(Src)))
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
 #  else
 #   define YYCOPY(Dst, Src, Count)              \
       do                                        \
         {                                       \
-          YYSIZE_T yyi;                         \
+          YYPTRDIFF_T yyi;                      \
           for (yyi = 0; yyi < (Count); yyi++)   \
             (Dst)[yyi] = (Src)[yyi];            \
         }                                       \
-      while (YYID (0))
+      while (0)
 #  endif
 # endif
 #endif /* !YYCOPY_NEEDED */
@@ -555,26 +785,31 @@ union yyalloc
 /* YYFINAL -- State number of the termination state.  */
 #define YYFINAL  23
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   386
+#define YYLAST   581
 
 /* YYNTOKENS -- Number of terminals.  */
-#define YYNTOKENS  75
+#define YYNTOKENS  76
 /* YYNNTS -- Number of nonterminals.  */
 #define YYNNTS  37
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  109
-/* YYNRULES -- Number of states.  */
-#define YYNSTATES  192
+#define YYNRULES  114
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  209
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   330
 
-/* YYTRANSLATE(YYLEX) -- Bison symbol number corresponding to YYLEX.  */
-#define YYUNDEFTOK  2
-#define YYMAXUTOK   329
 
-#define YYTRANSLATE(YYX)						\
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
-/* YYTRANSLATE[YYLEX] -- Bison symbol number corresponding to YYLEX.  */
-static const yytype_uint8 yytranslate[] =
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -608,405 +843,381 @@ static const yytype_uint8 yytranslate[] =
       35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
       45,    46,    47,    48,    49,    50,    51,    52,    53,    54,
       55,    56,    57,    58,    59,    60,    61,    62,    63,    64,
-      65,    66,    67,    68,    69,    70,    71,    72,    73,    74
+      65,    66,    67,    68,    69,    70,    71,    72,    73,    74,
+      75
 };
 
 #if YYDEBUG
-/* YYPRHS[YYN] -- Index of the first RHS symbol of rule number YYN in
-   YYRHS.  */
-static const yytype_uint16 yyprhs[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
-       0,     0,     3,     5,     8,    10,    12,    15,    18,    21,
-      26,    32,    34,    38,    41,    45,    50,    56,    62,    69,
-      71,    73,    75,    77,    79,    81,    83,    85,    87,    89,
-      91,    93,    95,    97,    99,   102,   106,   108,   111,   113,
-     115,   117,   120,   123,   125,   127,   129,   131,   133,   135,
-     143,   149,   157,   162,   166,   169,   172,   175,   179,   185,
-     195,   197,   199,   201,   203,   207,   210,   213,   217,   220,
-     224,   226,   230,   232,   234,   239,   241,   244,   247,   251,
-     253,   256,   259,   262,   265,   267,   271,   275,   277,   281,
-     285,   287,   291,   295,   299,   303,   305,   309,   313,   315,
-     319,   321,   325,   327,   333,   337,   339,   341,   343,   345
+       0,   138,   138,   155,   156,   167,   168,   179,   180,   183,
+     189,   196,   197,   200,   205,   210,   216,   221,   226,   231,
+     236,   244,   247,   248,   249,   250,   253,   254,   255,   256,
+     257,   258,   259,   260,   261,   262,   265,   266,   269,   270,
+     273,   274,   277,   278,   282,   283,   284,   285,   286,   287,
+     288,   289,   300,   304,   310,   315,   316,   319,   320,   321,
+     322,   325,   328,   334,   337,   338,   339,   340,   343,   344,
+     345,   346,   350,   351,   354,   357,   358,   361,   364,   365,
+     366,   369,   374,   379,   386,   387,   392,   397,   402,   409,
+     410,   415,   422,   423,   428,   435,   436,   441,   446,   451,
+     458,   459,   464,   471,   472,   479,   480,   487,   488,   492,
+     498,   499,   500,   501,   502
 };
+#endif
 
-/* YYRHS -- A `-1'-separated list of the rules' RHS.  */
-static const yytype_int8 yyrhs[] =
-{
-      76,     0,    -1,    77,    -1,    77,    78,    -1,    78,    -1,
-      79,    -1,    80,    86,    -1,    80,    47,    -1,    82,    47,
-      -1,    85,    68,    38,    39,    -1,    85,    68,    38,    81,
-      39,    -1,    82,    -1,    81,    45,    82,    -1,    85,    68,
-      -1,    84,    85,    68,    -1,    85,    68,    61,    83,    -1,
-      84,    85,    68,    61,    83,    -1,    85,    68,    40,    69,
-      41,    -1,    84,    85,    68,    40,    69,    41,    -1,   110,
-      -1,    34,    -1,    35,    -1,    36,    -1,    37,    -1,     5,
-      -1,     3,    -1,     6,    -1,     4,    -1,    17,    -1,    18,
-      -1,    19,    -1,    20,    -1,    21,    -1,    22,    -1,    42,
-      43,    -1,    42,    87,    43,    -1,    88,    -1,    87,    88,
-      -1,    86,    -1,    89,    -1,    47,    -1,    82,    47,    -1,
-     110,    47,    -1,    90,    -1,    91,    -1,    92,    -1,    93,
-      -1,    94,    -1,    95,    -1,    25,    38,   110,    39,    88,
-      26,    88,    -1,    25,    38,   110,    39,    88,    -1,    31,
-      38,   110,    39,    42,    87,    43,    -1,    32,   110,    46,
-      88,    -1,    33,    46,    88,    -1,    28,    47,    -1,    29,
-      47,    -1,    27,    47,    -1,    27,   110,    47,    -1,    23,
-      38,   110,    39,    88,    -1,    24,    38,   110,    47,   110,
-      47,   110,    39,    88,    -1,    68,    -1,    69,    -1,    70,
-      -1,    71,    -1,    38,   110,    39,    -1,    99,    39,    -1,
-      98,    39,    -1,   101,    38,     3,    -1,   101,    38,    -1,
-     101,    38,   100,    -1,   110,    -1,   100,    45,   110,    -1,
-      68,    -1,    96,    -1,   102,    40,   110,    41,    -1,    97,
-      -1,   102,    66,    -1,   102,    67,    -1,   102,    44,    72,
-      -1,   102,    -1,    66,   103,    -1,    67,   103,    -1,    55,
-     103,    -1,    64,   103,    -1,   103,    -1,   104,    56,   103,
-      -1,   104,    65,   103,    -1,   104,    -1,   105,    55,   104,
-      -1,   105,    64,   104,    -1,   105,    -1,   106,    62,   105,
-      -1,   106,    63,   105,    -1,   106,    50,   105,    -1,   106,
-      49,   105,    -1,   106,    -1,   107,    51,   106,    -1,   107,
-      52,   106,    -1,   107,    -1,   108,    53,   107,    -1,   108,
-      -1,   109,    54,   108,    -1,   109,    -1,   109,    48,   109,
-      46,   109,    -1,   103,   111,   110,    -1,    61,    -1,    59,
-      -1,    60,    -1,    57,    -1,    58,    -1
-};
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
 
-/* YYRLINE[YYN] -- source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
-{
-       0,   135,   135,   151,   152,   163,   164,   175,   176,   179,
-     185,   192,   193,   196,   201,   206,   212,   217,   222,   230,
-     233,   234,   235,   236,   239,   240,   241,   242,   243,   244,
-     245,   246,   247,   248,   251,   252,   255,   256,   259,   260,
-     263,   264,   268,   269,   270,   271,   272,   273,   274,   277,
-     281,   287,   292,   293,   296,   297,   298,   299,   302,   305,
-     311,   314,   315,   316,   317,   320,   321,   324,   325,   328,
-     331,   332,   335,   338,   339,   340,   343,   348,   353,   360,
-     361,   366,   371,   376,   383,   384,   389,   396,   397,   402,
-     409,   410,   415,   420,   425,   432,   433,   438,   445,   446,
-     453,   454,   461,   462,   466,   472,   473,   474,   475,   476
-};
-#endif
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
 
-#if YYDEBUG || YYERROR_VERBOSE || 0
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "T_Void", "T_Bool", "T_Int", "T_Float",
-  "T_Uint", "T_Bvec2", "T_Bvec3", "T_Bvec4", "T_Ivec2", "T_Ivec3",
-  "T_Ivec4", "T_Uvec2", "T_Uvec3", "T_Uvec4", "T_Vec2", "T_Vec3", "T_Vec4",
-  "T_Mat2", "T_Mat3", "T_Mat4", "T_While", "T_For", "T_If", "T_Else",
-  "T_Return", "T_Break", "T_Continue", "T_Do", "T_Switch", "T_Case",
-  "T_Default", "T_In", "T_Out", "T_Const", "T_Uniform", "T_LeftParen",
-  "T_RightParen", "T_LeftBracket", "T_RightBracket", "T_LeftBrace",
-  "T_RightBrace", "T_Dot", "T_Comma", "T_Colon", "T_Semicolon",
-  "T_Question", "T_LessEqual", "T_GreaterEqual", "T_EQ", "T_NE", "T_And",
-  "T_Or", "T_Plus", "T_Star", "T_MulAssign", "T_DivAssign", "T_AddAssign",
-  "T_SubAssign", "T_Equal", "T_LeftAngle", "T_RightAngle", "T_Dash",
-  "T_Slash", "T_Inc", "T_Dec", "T_Identifier", "T_IntConstant",
-  "T_FloatConstant", "T_BoolConstant", "T_FieldSelection", "LOWEST",
-  "LOWER_THAN_ELSE", "$accept", "Program", "DeclList", "Decl",
-  "Declaration", "FuncDecl", "ParameterList", "SingleDecl", "Initializer",
-  "TypeQualify", "TypeDecl", "CompoundStatement", "StatementList",
-  "Statement", "SingleStatement", "SelectionStmt", "SwitchStmt",
-  "CaseStmt", "JumpStmt", "WhileStmt", "ForStmt", "PrimaryExpr",
-  "FunctionCallExpr", "FunctionCallHeaderNoParameters",
-  "FunctionCallHeaderWithParameters", "ArgumentList", "FunctionIdentifier",
-  "PostfixExpr", "UnaryExpr", "MultiExpr", "AdditionExpr", "RelationExpr",
-  "EqualityExpr", "LogicAndExpr", "LogicOrExpr", "Expression", "AssignOp", YY_NULL
+  "\"end of file\"", "error", "\"invalid token\"", "T_Void", "T_Bool",
+  "T_Int", "T_Float", "T_Uint", "T_Bvec2", "T_Bvec3", "T_Bvec4", "T_Ivec2",
+  "T_Ivec3", "T_Ivec4", "T_Uvec2", "T_Uvec3", "T_Uvec4", "T_Vec2",
+  "T_Vec3", "T_Vec4", "T_Mat2", "T_Mat3", "T_Mat4", "T_While", "T_For",
+  "T_If", "T_Else", "T_Return", "T_Break", "T_Continue", "T_Do",
+  "T_Switch", "T_Case", "T_Default", "T_In", "T_Out", "T_Const",
+  "T_Uniform", "T_LeftParen", "T_RightParen", "T_LeftBracket",
+  "T_RightBracket", "T_LeftBrace", "T_RightBrace", "T_Dot", "T_Comma",
+  "T_Colon", "T_Semicolon", "T_Question", "T_LessEqual", "T_GreaterEqual",
+  "T_EQ", "T_NE", "T_And", "T_Or", "T_Plus", "T_Star", "T_MulAssign",
+  "T_DivAssign", "T_AddAssign", "T_SubAssign", "T_Equal", "T_LeftAngle",
+  "T_RightAngle", "T_Dash", "T_Slash", "T_Inc", "T_Dec", "T_Identifier",
+  "T_IntConstant", "T_FloatConstant", "T_BoolConstant", "T_FieldSelection",
+  "T_Pragma", "LOWEST", "LOWER_THAN_ELSE", "$accept", "Program",
+  "DeclList", "Decl", "Declaration", "FuncDecl", "ParameterList",
+  "SingleDecl", "Initializer", "TypeQualify", "TypeDecl",
+  "CompoundStatement", "StatementList", "Statement", "SingleStatement",
+  "SelectionStmt", "SwitchStmt", "CaseStmt", "JumpStmt", "WhileStmt",
+  "ForStmt", "PrimaryExpr", "FunctionCallExpr",
+  "FunctionCallHeaderNoParameters", "FunctionCallHeaderWithParameters",
+  "ArgumentList", "FunctionIdentifier", "PostfixExpr", "UnaryExpr",
+  "MultiExpr", "AdditionExpr", "RelationExpr", "EqualityExpr",
+  "LogicAndExpr", "LogicOrExpr", "Expression", "AssignOp", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[YYLEX-NUM] -- Internal token number corresponding to
-   token YYLEX-NUM.  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288,   289,   290,   291,   292,   293,   294,
-     295,   296,   297,   298,   299,   300,   301,   302,   303,   304,
-     305,   306,   307,   308,   309,   310,   311,   312,   313,   314,
-     315,   316,   317,   318,   319,   320,   321,   322,   323,   324,
-     325,   326,   327,   328,   329
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-/* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
-{
-       0,    75,    76,    77,    77,    78,    78,    79,    79,    80,
-      80,    81,    81,    82,    82,    82,    82,    82,    82,    83,
-      84,    84,    84,    84,    85,    85,    85,    85,    85,    85,
-      85,    85,    85,    85,    86,    86,    87,    87,    88,    88,
-      89,    89,    89,    89,    89,    89,    89,    89,    89,    90,
-      90,    91,    92,    92,    93,    93,    93,    93,    94,    95,
-      96,    96,    96,    96,    96,    97,    97,    98,    98,    99,
-     100,   100,   101,   102,   102,   102,   102,   102,   102,   103,
-     103,   103,   103,   103,   104,   104,   104,   105,   105,   105,
-     106,   106,   106,   106,   106,   107,   107,   107,   108,   108,
-     109,   109,   110,   110,   110,   111,   111,   111,   111,   111
-};
+#define YYPACT_NINF (-132)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-/* YYR2[YYN] -- Number of symbols composing right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
+#define YYTABLE_NINF (-78)
+
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
 {
-       0,     2,     1,     2,     1,     1,     2,     2,     2,     4,
-       5,     1,     3,     2,     3,     4,     5,     5,     6,     1,
-       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     1,     2,     3,     1,     2,     1,     1,
-       1,     2,     2,     1,     1,     1,     1,     1,     1,     7,
-       5,     7,     4,     3,     2,     2,     2,     3,     5,     9,
-       1,     1,     1,     1,     3,     2,     2,     3,     2,     3,
-       1,     3,     1,     1,     4,     1,     2,     2,     3,     1,
-       2,     2,     2,     2,     1,     3,     3,     1,     3,     3,
-       1,     3,     3,     3,     3,     1,     3,     3,     1,     3,
-       1,     3,     1,     5,     3,     1,     1,     1,     1,     1
+     544,  -132,  -132,  -132,  -132,  -132,  -132,  -132,  -132,  -132,
+    -132,  -132,  -132,  -132,  -132,    46,   544,  -132,  -132,    11,
+       5,    64,   -12,  -132,  -132,   218,  -132,  -132,  -132,    -9,
+     -27,    28,    40,    58,   100,    52,    53,    63,   429,    56,
+     429,  -132,  -132,   429,   429,   429,   429,    71,  -132,  -132,
+    -132,   389,    65,   -30,  -132,   275,  -132,  -132,  -132,  -132,
+    -132,  -132,  -132,  -132,  -132,  -132,    72,    74,    78,   -35,
+      14,   -41,   -36,   -23,    25,    57,   -25,    76,   -28,   507,
+     429,   429,   429,   429,   429,  -132,   -20,    79,  -132,  -132,
+     429,    81,   389,    86,  -132,  -132,  -132,  -132,  -132,  -132,
+     429,   429,   -26,  -132,  -132,  -132,  -132,   468,   429,    59,
+    -132,  -132,  -132,  -132,  -132,  -132,  -132,   429,   429,   429,
+     429,   429,   429,   429,   429,   429,   429,   429,   429,   429,
+     429,  -132,   429,   429,  -132,    -3,  -132,    61,    91,  -132,
+    -132,    98,    94,   103,  -132,   104,   389,  -132,  -132,    -2,
+    -132,   107,   105,   108,   109,  -132,  -132,  -132,  -132,  -132,
+     -41,   -41,   -36,   -36,   -36,   -36,   -23,   -23,    25,   -24,
+      57,   113,  -132,  -132,   544,    84,   389,   429,   389,   114,
+    -132,  -132,   429,   111,  -132,   429,    96,  -132,   429,  -132,
+     115,   132,   389,  -132,   429,   106,   429,  -132,   429,   389,
+     332,     9,  -132,   122,  -132,  -132,  -132,   389,  -132
 };
 
-/* YYDEFACT[STATE-NAME] -- Default reduction number in state STATE-NUM.
-   Performed when YYTABLE doesn't specify something else to do.  Zero
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
    means the default is an error.  */
-static const yytype_uint8 yydefact[] =
+static const yytype_int8 yydefact[] =
 {
-       0,    25,    27,    24,    26,    28,    29,    30,    31,    32,
-      33,    20,    21,    22,    23,     0,     2,     4,     5,     0,
+       0,    27,    29,    26,    28,    30,    31,    32,    33,    34,
+      35,    22,    23,    24,    25,     0,     2,     4,     5,     0,
        0,     0,     0,     1,     3,     0,     7,     6,     8,     0,
       13,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,    34,    40,     0,     0,     0,     0,    60,    61,    62,
-      63,     0,     0,    38,     0,    36,    39,    43,    44,    45,
-      46,    47,    48,    73,    75,     0,     0,     0,    79,    84,
-      87,    90,    95,    98,   100,   102,     0,    14,     0,     0,
-       0,     0,     0,     0,    56,     0,    54,    55,     0,     0,
-       0,     0,    82,    83,    80,    81,    41,    13,    35,    37,
-      66,    65,    68,     0,     0,    76,    77,   108,   109,   106,
-     107,   105,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,    42,     0,     0,     9,
-       0,    11,     0,    15,    19,     0,     0,     0,    57,     0,
-       0,    53,    64,    67,    69,    70,     0,    78,   104,    85,
-      86,    84,    88,    89,    94,    93,    91,    92,    96,    97,
-      99,     0,   101,     0,    16,    10,     0,    17,     0,     0,
-       0,     0,    52,     0,    74,     0,    18,    12,    58,     0,
-      50,     0,    71,   103,     0,     0,     0,     0,    49,    51,
-       0,    59
-};
-
-/* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int16 yydefgoto[] =
-{
-      -1,    15,    16,    17,    18,    19,   130,    51,   133,    21,
-      52,    53,    54,    55,    56,    57,    58,    59,    60,    61,
-      62,    63,    64,    65,    66,   144,    67,    68,    69,    70,
-      71,    72,    73,    74,    75,    76,   112
+       0,    36,    42,     0,     0,     0,     0,    63,    64,    65,
+      66,     0,     0,     0,    40,     0,    38,    41,    45,    46,
+      47,    48,    49,    50,    78,    80,     0,     0,     0,    84,
+      89,    92,    95,   100,   103,   105,   107,     0,    14,     0,
+       0,     0,     0,     0,     0,    59,     0,     0,    57,    58,
+       0,     0,     0,     0,    87,    88,    85,    86,    51,    43,
+       0,     0,    13,    37,    39,    69,    68,    73,     0,     0,
+      81,    82,   113,   114,   111,   112,   110,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,    44,     0,     0,     9,     0,    11,     0,     0,    15,
+      21,     0,     0,     0,    60,     0,     0,    56,    67,     0,
+      75,     0,    27,    74,     0,    83,   109,    90,    91,    89,
+      93,    94,    99,    98,    96,    97,   101,   102,   104,     0,
+     106,     0,    16,    10,     0,    17,     0,     0,     0,     0,
+      55,    70,     0,     0,    79,     0,    18,    12,     0,    61,
+       0,    53,     0,    76,     0,   108,     0,    19,     0,     0,
+       0,     0,    20,     0,    52,    54,    71,     0,    62
 };
 
-/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-   STATE-NUM.  */
-#define YYPACT_NINF -119
-static const yytype_int16 yypact[] =
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int16 yypgoto[] =
 {
-     107,  -119,  -119,  -119,  -119,  -119,  -119,  -119,  -119,  -119,
-    -119,  -119,  -119,  -119,  -119,    12,   107,  -119,  -119,    21,
-      -5,   355,   -12,  -119,  -119,   150,  -119,  -119,  -119,    13,
-     -30,    76,    79,    92,   -34,    46,    85,    97,    93,    91,
-      93,  -119,  -119,    93,    93,    93,    93,   101,  -119,  -119,
-    -119,   100,    82,  -119,   205,  -119,  -119,  -119,  -119,  -119,
-    -119,  -119,  -119,  -119,  -119,   110,   113,   127,   -26,    62,
-     -45,    -2,     2,    -6,   123,   -39,   133,   -37,    55,   120,
-      93,    93,    93,    93,  -119,   143,  -119,  -119,    93,   145,
-     315,   155,  -119,  -119,  -119,  -119,  -119,   -18,  -119,  -119,
-    -119,  -119,    16,    93,   124,  -119,  -119,  -119,  -119,  -119,
-    -119,  -119,    93,    93,    93,    93,    93,    93,    93,    93,
-      93,    93,    93,    93,    93,    93,  -119,   126,    93,  -119,
-      70,  -119,   161,  -119,  -119,   164,   157,   167,  -119,   168,
-     315,  -119,  -119,  -119,   170,  -119,   171,  -119,  -119,  -119,
-    -119,  -119,   -45,   -45,    -2,    -2,    -2,    -2,     2,     2,
-      -6,   -29,   123,   172,  -119,  -119,   107,  -119,   315,    93,
-     315,   189,  -119,    93,  -119,    93,  -119,  -119,  -119,   188,
-     218,   315,  -119,   191,    93,   315,   260,   207,  -119,  -119,
-     315,  -119
+    -132,  -132,  -132,   147,  -132,  -132,  -132,     1,  -131,  -132,
+       0,   146,   -19,   -48,  -132,  -132,  -132,  -132,  -132,  -132,
+    -132,  -132,  -132,  -132,  -132,  -101,  -132,  -132,    90,   -71,
+     -61,   -32,    44,    47,  -125,     7,  -132
 };
 
-/* YYPGOTO[NTERM-NUM].  */
-static const yytype_int16 yypgoto[] =
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_uint8 yydefgoto[] =
 {
-    -119,  -119,  -119,   233,  -119,  -119,  -119,     0,   122,  -119,
-      23,   232,    72,   -52,  -119,  -119,  -119,  -119,  -119,  -119,
-    -119,  -119,  -119,  -119,  -119,  -119,  -119,  -119,   -17,   -49,
-      81,    24,   131,   130,  -118,   -33,  -119
+       0,    15,    16,    17,    18,    19,   135,    52,   139,    21,
+      86,    54,    55,    56,    57,    58,    59,    60,    61,    62,
+      63,    64,    65,    66,    67,   149,    68,    69,    70,    71,
+      72,    73,    74,    75,    76,    77,   117
 };
 
-/* YYTABLE[YYPACT[STATE-NUM]].  What to do in state STATE-NUM.  If
-   positive, shift that token.  If negative, reduce the rule which
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
    number is the opposite.  If YYTABLE_NINF, syntax error.  */
-#define YYTABLE_NINF -73
 static const yytype_int16 yytable[] =
 {
-      20,    85,    99,   127,    40,    89,   161,    91,    78,   124,
-      79,   113,    23,    84,   103,   125,    20,   175,   104,   143,
-     114,    43,    79,    22,   128,   125,    92,    93,    94,    95,
-      44,    80,    45,    46,    47,    48,    49,    50,   141,    22,
-     105,   106,    28,    80,    29,   121,   122,   134,   135,   136,
-     137,   117,   118,   115,    40,   139,    30,   183,     1,     2,
-       3,     4,   116,    25,   119,   120,   152,   153,    26,   145,
-     146,    43,     5,     6,     7,     8,     9,    10,   131,   148,
-      44,    77,    45,    46,    47,    48,    49,    50,   172,    11,
-      12,    13,    14,    86,   129,   134,   149,   150,   151,   151,
-     151,   151,   151,   151,   151,   151,   151,   151,   151,   165,
-       1,     2,     3,     4,    81,   166,   178,    82,   180,   107,
-     108,   109,   110,   111,     5,     6,     7,     8,     9,    10,
-      83,    40,    87,   188,    99,    88,   179,    90,   191,   -72,
-     182,    11,    12,    13,    14,   158,   159,    96,    43,   100,
-      97,   187,   101,     1,     2,     3,     4,    44,   151,    45,
-      46,    47,    48,    49,    50,   102,   177,     5,     6,     7,
-       8,     9,    10,    31,    32,    33,   123,    34,    35,    36,
-     126,    37,    38,    39,    11,    12,    13,    14,    40,   132,
-     138,   140,    25,    41,   142,   163,   147,    42,   154,   155,
-     156,   157,   167,   168,   169,    43,   170,   171,     1,     2,
-       3,     4,   174,   176,    44,   173,    45,    46,    47,    48,
-      49,    50,     5,     6,     7,     8,     9,    10,    31,    32,
-      33,   181,    34,    35,    36,   184,    37,    38,    39,    11,
-      12,    13,    14,    40,   185,   125,   190,    25,    98,    24,
-     164,    27,    42,   186,   160,   162,     0,     0,     0,     0,
-      43,     0,     0,     1,     2,     3,     4,     0,     0,    44,
-       0,    45,    46,    47,    48,    49,    50,     5,     6,     7,
-       8,     9,    10,    31,    32,    33,     0,    34,    35,    36,
-       0,    37,    38,    39,    11,    12,    13,    14,    40,     0,
-       0,     0,    25,   189,     0,     0,     0,    42,     0,     0,
-       0,     0,     0,     0,     0,    43,     0,     0,     1,     2,
-       3,     4,     0,     0,    44,     0,    45,    46,    47,    48,
-      49,    50,     5,     6,     7,     8,     9,    10,    31,    32,
+      22,    20,   172,    98,   169,   108,   153,   104,   100,   109,
+     101,    79,   132,    80,    80,   118,    22,    20,   100,   120,
+     101,    29,   185,   129,   119,    53,   122,   123,   121,   130,
+     130,   110,   111,   133,    81,    81,   173,   181,   102,   124,
+     125,    87,   174,   182,   147,    91,    23,    93,   206,   160,
+     161,    53,    28,    25,   182,    53,    30,   197,    26,    78,
+     195,   162,   163,   164,   165,   202,    82,     1,     2,     3,
+       4,   112,   113,   114,   115,   116,   126,   127,    83,   137,
+     136,     5,     6,     7,     8,     9,    10,   138,   140,   141,
+     142,   143,    53,   201,   166,   167,    84,   145,   180,    88,
+      89,    90,    92,     1,     2,     3,     4,   150,   151,   -77,
+     128,   105,    99,   106,   150,   154,   107,     5,     6,     7,
+       8,     9,    10,   131,   156,   148,   144,   146,   189,   102,
+     191,   155,   175,    94,    95,    96,    97,   176,    40,   171,
+     140,   177,   178,   179,   -72,   188,    53,    85,   183,   194,
+     184,   204,   104,   182,   186,    43,   192,   196,   199,   208,
+     130,   207,   198,    24,    44,    27,    45,    46,    47,    48,
+      49,    50,   168,   200,   137,   187,    53,   170,    53,     0,
+       0,     0,     0,     0,   190,     0,     0,     0,     0,   193,
+       0,     0,    53,     0,     0,   140,     0,     0,     0,    53,
+      53,   150,     0,   140,     0,   203,     0,    53,   157,   158,
+     159,   159,   159,   159,   159,   159,   159,   159,   159,   159,
+     159,     1,     2,     3,     4,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     5,     6,     7,     8,     9,
+      10,    31,    32,    33,     0,    34,    35,    36,     0,    37,
+      38,    39,    11,    12,    13,    14,    40,     0,     0,     0,
+      25,    41,     0,     0,     0,    42,     0,     0,     0,     0,
+       0,     0,     0,    43,     0,   159,     0,     0,     1,     2,
+       3,     4,    44,     0,    45,    46,    47,    48,    49,    50,
+       0,    51,     5,     6,     7,     8,     9,    10,    31,    32,
       33,     0,    34,    35,    36,     0,    37,    38,    39,    11,
-      12,    13,    14,    40,     0,     0,     0,    25,     1,     2,
-       3,     4,    42,     0,     0,     0,     0,     0,     0,     0,
-      43,     0,     5,     6,     7,     8,     9,    10,     0,    44,
-       0,    45,    46,    47,    48,    49,    50
+      12,    13,    14,    40,     0,     0,     0,    25,   103,     0,
+       0,     0,    42,     0,     0,     0,     0,     0,     0,     0,
+      43,     0,     0,     0,     0,     1,     2,     3,     4,    44,
+       0,    45,    46,    47,    48,    49,    50,     0,    51,     5,
+       6,     7,     8,     9,    10,    31,    32,    33,     0,    34,
+      35,    36,     0,    37,    38,    39,    11,    12,    13,    14,
+      40,     0,     0,     0,    25,   205,     0,     0,     0,    42,
+       0,     0,     0,     0,     0,     0,     0,    43,     0,     0,
+       0,     0,     1,     2,     3,     4,    44,     0,    45,    46,
+      47,    48,    49,    50,     0,    51,     5,     6,     7,     8,
+       9,    10,    31,    32,    33,     0,    34,    35,    36,     0,
+      37,    38,    39,    11,    12,    13,    14,    40,     0,     0,
+       0,    25,     1,     2,     3,     4,    42,     0,     0,     0,
+       0,     0,     0,     0,    43,     0,     5,     6,     7,     8,
+       9,    10,     0,    44,     0,    45,    46,    47,    48,    49,
+      50,     0,    51,     0,     0,     0,     0,    40,     0,     0,
+       0,   152,     2,     3,     4,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,    43,     5,     6,     7,     8,     9,
+      10,     0,     0,    44,     0,    45,    46,    47,    48,    49,
+      50,     0,     0,     0,     0,     0,    40,     0,     0,     0,
+       1,     2,     3,     4,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,    43,     5,     6,     7,     8,     9,    10,
+       0,     0,    44,     0,    45,    46,    47,    48,    49,    50,
+       0,    11,    12,    13,    14,     0,   134,     1,     2,     3,
+       4,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     5,     6,     7,     8,     9,    10,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,    11,    12,
+      13,    14
 };
 
-#define yypact_value_is_default(Yystate) \
-  (!!((Yystate) == (-119)))
-
-#define yytable_value_is_error(Yytable_value) \
-  YYID (0)
-
 static const yytype_int16 yycheck[] =
 {
-       0,    34,    54,    40,    38,    38,   124,    40,    38,    48,
-      40,    56,     0,    47,    40,    54,    16,    46,    44,     3,
-      65,    55,    40,     0,    61,    54,    43,    44,    45,    46,
-      64,    61,    66,    67,    68,    69,    70,    71,    90,    16,
-      66,    67,    47,    61,    21,    51,    52,    80,    81,    82,
-      83,    49,    50,    55,    38,    88,    68,   175,     3,     4,
-       5,     6,    64,    42,    62,    63,   115,   116,    47,   102,
-     103,    55,    17,    18,    19,    20,    21,    22,    78,   112,
-      64,    68,    66,    67,    68,    69,    70,    71,   140,    34,
-      35,    36,    37,    47,    39,   128,   113,   114,   115,   116,
-     117,   118,   119,   120,   121,   122,   123,   124,   125,    39,
-       3,     4,     5,     6,    38,    45,   168,    38,   170,    57,
-      58,    59,    60,    61,    17,    18,    19,    20,    21,    22,
-      38,    38,    47,   185,   186,    38,   169,    46,   190,    38,
-     173,    34,    35,    36,    37,   121,   122,    47,    55,    39,
-      68,   184,    39,     3,     4,     5,     6,    64,   175,    66,
-      67,    68,    69,    70,    71,    38,   166,    17,    18,    19,
-      20,    21,    22,    23,    24,    25,    53,    27,    28,    29,
-      47,    31,    32,    33,    34,    35,    36,    37,    38,    69,
-      47,    46,    42,    43,    39,    69,    72,    47,   117,   118,
-     119,   120,    41,    39,    47,    55,    39,    39,     3,     4,
-       5,     6,    41,    41,    64,    45,    66,    67,    68,    69,
-      70,    71,    17,    18,    19,    20,    21,    22,    23,    24,
-      25,    42,    27,    28,    29,    47,    31,    32,    33,    34,
-      35,    36,    37,    38,    26,    54,    39,    42,    43,    16,
-     128,    19,    47,   181,   123,   125,    -1,    -1,    -1,    -1,
-      55,    -1,    -1,     3,     4,     5,     6,    -1,    -1,    64,
-      -1,    66,    67,    68,    69,    70,    71,    17,    18,    19,
-      20,    21,    22,    23,    24,    25,    -1,    27,    28,    29,
-      -1,    31,    32,    33,    34,    35,    36,    37,    38,    -1,
-      -1,    -1,    42,    43,    -1,    -1,    -1,    47,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    55,    -1,    -1,     3,     4,
-       5,     6,    -1,    -1,    64,    -1,    66,    67,    68,    69,
-      70,    71,    17,    18,    19,    20,    21,    22,    23,    24,
+       0,     0,   133,    51,   129,    40,   107,    55,    38,    44,
+      40,    38,    40,    40,    40,    56,    16,    16,    38,    55,
+      40,    21,    46,    48,    65,    25,    49,    50,    64,    54,
+      54,    66,    67,    61,    61,    61,    39,    39,    68,    62,
+      63,    34,    45,    45,    92,    38,     0,    40,    39,   120,
+     121,    51,    47,    42,    45,    55,    68,   188,    47,    68,
+     185,   122,   123,   124,   125,   196,    38,     3,     4,     5,
+       6,    57,    58,    59,    60,    61,    51,    52,    38,    79,
+      79,    17,    18,    19,    20,    21,    22,    80,    81,    82,
+      83,    84,    92,   194,   126,   127,    38,    90,   146,    47,
+      47,    38,    46,     3,     4,     5,     6,   100,   101,    38,
+      53,    39,    47,    39,   107,   108,    38,    17,    18,    19,
+      20,    21,    22,    47,   117,    39,    47,    46,   176,    68,
+     178,    72,    41,    43,    44,    45,    46,    39,    38,   132,
+     133,    47,    39,    39,    39,    61,   146,    47,    41,    38,
+      41,   199,   200,    45,    41,    55,    42,    61,    26,   207,
+      54,    39,    47,    16,    64,    19,    66,    67,    68,    69,
+      70,    71,   128,   192,   174,   174,   176,   130,   178,    -1,
+      -1,    -1,    -1,    -1,   177,    -1,    -1,    -1,    -1,   182,
+      -1,    -1,   192,    -1,    -1,   188,    -1,    -1,    -1,   199,
+     200,   194,    -1,   196,    -1,   198,    -1,   207,   118,   119,
+     120,   121,   122,   123,   124,   125,   126,   127,   128,   129,
+     130,     3,     4,     5,     6,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    17,    18,    19,    20,    21,
+      22,    23,    24,    25,    -1,    27,    28,    29,    -1,    31,
+      32,    33,    34,    35,    36,    37,    38,    -1,    -1,    -1,
+      42,    43,    -1,    -1,    -1,    47,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    55,    -1,   185,    -1,    -1,     3,     4,
+       5,     6,    64,    -1,    66,    67,    68,    69,    70,    71,
+      -1,    73,    17,    18,    19,    20,    21,    22,    23,    24,
       25,    -1,    27,    28,    29,    -1,    31,    32,    33,    34,
-      35,    36,    37,    38,    -1,    -1,    -1,    42,     3,     4,
-       5,     6,    47,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      55,    -1,    17,    18,    19,    20,    21,    22,    -1,    64,
-      -1,    66,    67,    68,    69,    70,    71
+      35,    36,    37,    38,    -1,    -1,    -1,    42,    43,    -1,
+      -1,    -1,    47,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      55,    -1,    -1,    -1,    -1,     3,     4,     5,     6,    64,
+      -1,    66,    67,    68,    69,    70,    71,    -1,    73,    17,
+      18,    19,    20,    21,    22,    23,    24,    25,    -1,    27,
+      28,    29,    -1,    31,    32,    33,    34,    35,    36,    37,
+      38,    -1,    -1,    -1,    42,    43,    -1,    -1,    -1,    47,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    55,    -1,    -1,
+      -1,    -1,     3,     4,     5,     6,    64,    -1,    66,    67,
+      68,    69,    70,    71,    -1,    73,    17,    18,    19,    20,
+      21,    22,    23,    24,    25,    -1,    27,    28,    29,    -1,
+      31,    32,    33,    34,    35,    36,    37,    38,    -1,    -1,
+      -1,    42,     3,     4,     5,     6,    47,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    55,    -1,    17,    18,    19,    20,
+      21,    22,    -1,    64,    -1,    66,    67,    68,    69,    70,
+      71,    -1,    73,    -1,    -1,    -1,    -1,    38,    -1,    -1,
+      -1,     3,     4,     5,     6,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    55,    17,    18,    19,    20,    21,
+      22,    -1,    -1,    64,    -1,    66,    67,    68,    69,    70,
+      71,    -1,    -1,    -1,    -1,    -1,    38,    -1,    -1,    -1,
+       3,     4,     5,     6,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    55,    17,    18,    19,    20,    21,    22,
+      -1,    -1,    64,    -1,    66,    67,    68,    69,    70,    71,
+      -1,    34,    35,    36,    37,    -1,    39,     3,     4,     5,
+       6,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    17,    18,    19,    20,    21,    22,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    34,    35,
+      36,    37
 };
 
-/* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-   symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
        0,     3,     4,     5,     6,    17,    18,    19,    20,    21,
-      22,    34,    35,    36,    37,    76,    77,    78,    79,    80,
-      82,    84,    85,     0,    78,    42,    47,    86,    47,    85,
+      22,    34,    35,    36,    37,    77,    78,    79,    80,    81,
+      83,    85,    86,     0,    79,    42,    47,    87,    47,    86,
       68,    23,    24,    25,    27,    28,    29,    31,    32,    33,
       38,    43,    47,    55,    64,    66,    67,    68,    69,    70,
-      71,    82,    85,    86,    87,    88,    89,    90,    91,    92,
-      93,    94,    95,    96,    97,    98,    99,   101,   102,   103,
-     104,   105,   106,   107,   108,   109,   110,    68,    38,    40,
-      61,    38,    38,    38,    47,   110,    47,    47,    38,   110,
-      46,   110,   103,   103,   103,   103,    47,    68,    43,    88,
-      39,    39,    38,    40,    44,    66,    67,    57,    58,    59,
-      60,    61,   111,    56,    65,    55,    64,    49,    50,    62,
-      63,    51,    52,    53,    48,    54,    47,    40,    61,    39,
-      81,    82,    69,    83,   110,   110,   110,   110,    47,   110,
-      46,    88,    39,     3,   100,   110,   110,    72,   110,   103,
-     103,   103,   104,   104,   105,   105,   105,   105,   106,   106,
-     107,   109,   108,    69,    83,    39,    45,    41,    39,    47,
-      39,    39,    88,    45,    41,    46,    41,    82,    88,   110,
-      88,    42,   110,   109,    47,    26,    87,   110,    88,    43,
-      39,    88
+      71,    73,    83,    86,    87,    88,    89,    90,    91,    92,
+      93,    94,    95,    96,    97,    98,    99,   100,   102,   103,
+     104,   105,   106,   107,   108,   109,   110,   111,    68,    38,
+      40,    61,    38,    38,    38,    47,    86,   111,    47,    47,
+      38,   111,    46,   111,   104,   104,   104,   104,    89,    47,
+      38,    40,    68,    43,    89,    39,    39,    38,    40,    44,
+      66,    67,    57,    58,    59,    60,    61,   112,    56,    65,
+      55,    64,    49,    50,    62,    63,    51,    52,    53,    48,
+      54,    47,    40,    61,    39,    82,    83,    86,   111,    84,
+     111,   111,   111,   111,    47,   111,    46,    89,    39,   101,
+     111,   111,     3,   101,   111,    72,   111,   104,   104,   104,
+     105,   105,   106,   106,   106,   106,   107,   107,   108,   110,
+     109,   111,    84,    39,    45,    41,    39,    47,    39,    39,
+      89,    39,    45,    41,    41,    46,    41,    83,    61,    89,
+     111,    89,    42,   111,    38,   110,    61,    84,    47,    26,
+      88,   101,    84,   111,    89,    43,    39,    39,    89
 };
 
-#define yyerrok		(yyerrstatus = 0)
-#define yyclearin	(yychar = YYEMPTY)
-#define YYEMPTY		(-2)
-#define YYEOF		0
-
-#define YYACCEPT	goto yyacceptlab
-#define YYABORT		goto yyabortlab
-#define YYERROR		goto yyerrorlab
-
-
-/* Like YYERROR except do call yyerror.  This remains here temporarily
-   to ease the transition to the new meaning of YYERROR, for GCC.
-   Once GCC version 2 has supplanted version 1, this can go.  However,
-   YYFAIL appears to be in use.  Nevertheless, it is formally deprecated
-   in Bison 2.4.2's NEWS entry, where a plan to phase it out is
-   discussed.  */
-
-#define YYFAIL		goto yyerrlab
-#if defined YYFAIL
-  /* This is here to suppress warnings from the GCC cpp's
-     -Wunused-macros.  Normally we don't worry about that warning, but
-     some users do, and we want to make it easy for users to remove
-     YYFAIL uses, which will produce warnings from Bison 2.5.  */
-#endif
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
+{
+       0,    76,    77,    78,    78,    79,    79,    80,    80,    81,
+      81,    82,    82,    83,    83,    83,    83,    83,    83,    83,
+      83,    84,    85,    85,    85,    85,    86,    86,    86,    86,
+      86,    86,    86,    86,    86,    86,    87,    87,    88,    88,
+      89,    89,    90,    90,    90,    90,    90,    90,    90,    90,
+      90,    90,    91,    91,    92,    93,    93,    94,    94,    94,
+      94,    95,    96,    97,    97,    97,    97,    97,    98,    98,
+      98,    98,    99,    99,   100,   101,   101,   102,   103,   103,
+     103,   103,   103,   103,   104,   104,   104,   104,   104,   105,
+     105,   105,   106,   106,   106,   107,   107,   107,   107,   107,
+     108,   108,   108,   109,   109,   110,   110,   111,   111,   111,
+     112,   112,   112,   112,   112
+};
 
-#define YYRECOVERING()  (!!yyerrstatus)
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     1,     2,     1,     1,     2,     2,     2,     4,
+       5,     1,     3,     2,     3,     4,     5,     5,     6,     7,
+       8,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     2,     3,     1,     2,
+       1,     1,     1,     2,     2,     1,     1,     1,     1,     1,
+       1,     2,     7,     5,     7,     4,     3,     2,     2,     2,
+       3,     5,     9,     1,     1,     1,     1,     3,     2,     2,
+       4,     7,     3,     2,     3,     1,     3,     1,     1,     4,
+       1,     2,     2,     3,     1,     2,     2,     2,     2,     1,
+       3,     3,     1,     3,     3,     1,     3,     3,     3,     3,
+       1,     3,     3,     1,     3,     1,     3,     1,     5,     3,
+       1,     1,     1,     1,     1
+};
+
+
+enum { YYENOMEM = -2 };
+
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
 
-#define YYBACKUP(Token, Value)                                  \
-do                                                              \
-  if (yychar == YYEMPTY)                                        \
-    {                                                           \
-      yychar = (Token);                                         \
-      yylval = (Value);                                         \
-      YYPOPSTACK (yylen);                                       \
-      yystate = *yyssp;                                         \
-      goto yybackup;                                            \
-    }                                                           \
-  else                                                          \
-    {                                                           \
-      yyerror (YY_("syntax error: cannot back up")); \
-      YYERROR;							\
-    }								\
-while (YYID (0))
-
-/* Error token number */
-#define YYTERROR	1
-#define YYERRCODE	256
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
+
 /* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
    If N is 0, then set CURRENT to the empty location which ends
    the previous symbol: RHS[0] (always defined).  */
@@ -1014,7 +1225,7 @@ while (YYID (0))
 #ifndef YYLLOC_DEFAULT
 # define YYLLOC_DEFAULT(Current, Rhs, N)                                \
     do                                                                  \
-      if (YYID (N))                                                     \
+      if (N)                                                            \
         {                                                               \
           (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;        \
           (Current).first_column = YYRHSLOC (Rhs, 1).first_column;      \
@@ -1028,160 +1239,132 @@ while (YYID (0))
           (Current).first_column = (Current).last_column =              \
             YYRHSLOC (Rhs, 0).last_column;                              \
         }                                                               \
-    while (YYID (0))
+    while (0)
 #endif
 
 #define YYRHSLOC(Rhs, K) ((Rhs)[K])
 
 
-/* YY_LOCATION_PRINT -- Print the location on the stream.
+/* Enable debugging if requested.  */
+#if YYDEBUG
+
+# ifndef YYFPRINTF
+#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYFPRINTF fprintf
+# endif
+
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+/* YYLOCATION_PRINT -- Print the location on the stream.
    This macro was not mandated originally: define only if we know
    we won't break user code: when these are the locations we know.  */
 
-#ifndef YY_LOCATION_PRINT
-# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+# ifndef YYLOCATION_PRINT
+
+#  if defined YY_LOCATION_PRINT
+
+   /* Temporary convenience wrapper in case some people defined the
+      undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YYLOCATION_PRINT(File, Loc)  YY_LOCATION_PRINT(File, *(Loc))
+
+#  elif defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
 
 /* Print *YYLOCP on YYO.  Private, do not rely on its existence. */
 
-__attribute__((__unused__))
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static unsigned
+YY_ATTRIBUTE_UNUSED
+static int
 yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
-#else
-static unsigned
-yy_location_print_ (yyo, yylocp)
-    FILE *yyo;
-    YYLTYPE const * const yylocp;
-#endif
 {
-  unsigned res = 0;
+  int res = 0;
   int end_col = 0 != yylocp->last_column ? yylocp->last_column - 1 : 0;
   if (0 <= yylocp->first_line)
     {
-      res += fprintf (yyo, "%d", yylocp->first_line);
+      res += YYFPRINTF (yyo, "%d", yylocp->first_line);
       if (0 <= yylocp->first_column)
-        res += fprintf (yyo, ".%d", yylocp->first_column);
+        res += YYFPRINTF (yyo, ".%d", yylocp->first_column);
     }
   if (0 <= yylocp->last_line)
     {
       if (yylocp->first_line < yylocp->last_line)
         {
-          res += fprintf (yyo, "-%d", yylocp->last_line);
+          res += YYFPRINTF (yyo, "-%d", yylocp->last_line);
           if (0 <= end_col)
-            res += fprintf (yyo, ".%d", end_col);
+            res += YYFPRINTF (yyo, ".%d", end_col);
         }
       else if (0 <= end_col && yylocp->first_column < end_col)
-        res += fprintf (yyo, "-%d", end_col);
+        res += YYFPRINTF (yyo, "-%d", end_col);
     }
   return res;
- }
+}
 
-#  define YY_LOCATION_PRINT(File, Loc)          \
-  yy_location_print_ (File, &(Loc))
+#   define YYLOCATION_PRINT  yy_location_print_
 
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
-#endif
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT(File, Loc)  YYLOCATION_PRINT(File, &(Loc))
 
+#  else
 
-/* YYLEX -- calling `yylex' with the right arguments.  */
-#ifdef YYLEX_PARAM
-# define YYLEX yylex (YYLEX_PARAM)
-#else
-# define YYLEX yylex ()
-#endif
+#   define YYLOCATION_PRINT(File, Loc) ((void) 0)
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT  YYLOCATION_PRINT
 
-/* Enable debugging if requested.  */
-#if YYDEBUG
+#  endif
+# endif /* !defined YYLOCATION_PRINT */
 
-# ifndef YYFPRINTF
-#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
-#  define YYFPRINTF fprintf
-# endif
 
-# define YYDPRINTF(Args)			\
-do {						\
-  if (yydebug)					\
-    YYFPRINTF Args;				\
-} while (YYID (0))
-
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)			  \
-do {									  \
-  if (yydebug)								  \
-    {									  \
-      YYFPRINTF (stderr, "%s ", Title);					  \
-      yy_symbol_print (stderr,						  \
-		  Type, Value, Location); \
-      YYFPRINTF (stderr, "\n");						  \
-    }									  \
-} while (YYID (0))
-
-
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
-
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
-#else
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value, Location); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
 static void
-yy_symbol_value_print (yyoutput, yytype, yyvaluep, yylocationp)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-    YYLTYPE const * const yylocationp;
-#endif
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
 {
-  FILE *yyo = yyoutput;
-  YYUSE (yyo);
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (yylocationp);
   if (!yyvaluep)
     return;
-  YYUSE (yylocationp);
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# else
-  YYUSE (yyoutput);
-# endif
-  switch (yytype)
-    {
-      default:
-        break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
-#else
-static void
-yy_symbol_print (yyoutput, yytype, yyvaluep, yylocationp)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-    YYLTYPE const * const yylocationp;
-#endif
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
 {
-  if (yytype < YYNTOKENS)
-    YYFPRINTF (yyoutput, "token %s (", yytname[yytype]);
-  else
-    YYFPRINTF (yyoutput, "nterm %s (", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  YY_LOCATION_PRINT (yyoutput, *yylocationp);
-  YYFPRINTF (yyoutput, ": ");
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep, yylocationp);
-  YYFPRINTF (yyoutput, ")");
+  YYLOCATION_PRINT (yyo, yylocationp);
+  YYFPRINTF (yyo, ": ");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, yylocationp);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -1189,16 +1372,8 @@ yy_symbol_print (yyoutput, yytype, yyvaluep, yylocationp)
 | TOP (included).                                                   |
 `------------------------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
-#else
-static void
-yy_stack_print (yybottom, yytop)
-    yytype_int16 *yybottom;
-    yytype_int16 *yytop;
-#endif
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -1209,64 +1384,57 @@ yy_stack_print (yybottom, yytop)
   YYFPRINTF (stderr, "\n");
 }
 
-# define YY_STACK_PRINT(Bottom, Top)				\
-do {								\
-  if (yydebug)							\
-    yy_stack_print ((Bottom), (Top));				\
-} while (YYID (0))
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
 
 
 /*------------------------------------------------.
 | Report that the YYRULE is going to be reduced.  |
 `------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_reduce_print (YYSTYPE *yyvsp, YYLTYPE *yylsp, int yyrule)
-#else
-static void
-yy_reduce_print (yyvsp, yylsp, yyrule)
-    YYSTYPE *yyvsp;
-    YYLTYPE *yylsp;
-    int yyrule;
-#endif
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
+                 int yyrule)
 {
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  unsigned long int yylno = yyrline[yyrule];
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
-	     yyrule - 1, yylno);
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
-      yy_symbol_print (stderr, yyrhs[yyprhs[yyrule] + yyi],
-		       &(yyvsp[(yyi + 1) - (yynrhs)])
-		       , &(yylsp[(yyi + 1) - (yynrhs)])		       );
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)],
+                       &(yylsp[(yyi + 1) - (yynrhs)]));
       YYFPRINTF (stderr, "\n");
     }
 }
 
-# define YY_REDUCE_PRINT(Rule)		\
-do {					\
-  if (yydebug)				\
-    yy_reduce_print (yyvsp, yylsp, Rule); \
-} while (YYID (0))
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, yylsp, Rule); \
+} while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
 
 
 /* YYINITDEPTH -- initial size of the parser's stacks.  */
-#ifndef	YYINITDEPTH
+#ifndef YYINITDEPTH
 # define YYINITDEPTH 200
 #endif
 
@@ -1282,383 +1450,93 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
-
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static YYSIZE_T
-yystrlen (const char *yystr)
-#else
-static YYSIZE_T
-yystrlen (yystr)
-    const char *yystr;
-#endif
-{
-  YYSIZE_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
-
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-#else
-static char *
-yystpcpy (yydest, yysrc)
-    char *yydest;
-    const char *yysrc;
-#endif
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
-
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
-
-  return yyd - 1;
-}
-#  endif
-# endif
-
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYSIZE_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-	switch (*++yyp)
-	  {
-	  case '\'':
-	  case ',':
-	    goto do_not_strip_quotes;
-
-	  case '\\':
-	    if (*++yyp != '\\')
-	      goto do_not_strip_quotes;
-	    /* Fall through.  */
-	  default:
-	    if (yyres)
-	      yyres[yyn] = *yyp;
-	    yyn++;
-	    break;
-
-	  case '"':
-	    if (yyres)
-	      yyres[yyn] = '\0';
-	    return yyn;
-	  }
-    do_not_strip_quotes: ;
-    }
 
-  if (! yyres)
-    return yystrlen (yystr);
 
-  return yystpcpy (yyres, yystr) - yyres;
-}
-# endif
 
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
-
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
-static int
-yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
-                yytype_int16 *yyssp, int yytoken)
-{
-  YYSIZE_T yysize0 = yytnamerr (YY_NULL, yytname[yytoken]);
-  YYSIZE_T yysize = yysize0;
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULL;
-  /* Arguments of yyformat. */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-  /* Number of reported tokens (one for the "unexpected", one per
-     "expected"). */
-  int yycount = 0;
-
-  /* There are many possibilities here to consider:
-     - Assume YYFAIL is not used.  It's too flawed to consider.  See
-       <http://lists.gnu.org/archive/html/bison-patches/2009-12/msg00024.html>
-       for details.  YYERROR is fine as it does not invoke this
-       function.
-     - If this state is a consistent state with a default action, then
-       the only way this function was invoked is if the default action
-       is an error action.  In that case, don't check for expected
-       tokens because there are none.
-     - The only way there can be no lookahead present (in yychar) is if
-       this state is a consistent state with a default action.  Thus,
-       detecting the absence of a lookahead is sufficient to determine
-       that there is no unexpected or expected token to report.  In that
-       case, just report a simple "syntax error".
-     - Don't assume there isn't a lookahead just because this state is a
-       consistent state with a default action.  There might have been a
-       previous inconsistent state, consistent state with a non-default
-       action, or user semantic action that manipulated yychar.
-     - Of course, the expected token list depends on states to have
-       correct lookahead information, and it depends on the parser not
-       to perform extra reductions after fetching a lookahead from the
-       scanner and before detecting a syntax error.  Thus, state merging
-       (from LALR or IELR) and default reductions corrupt the expected
-       token list.  However, the list is correct for canonical LR with
-       one exception: it will still contain any token that will not be
-       accepted due to an error action in a later state.
-  */
-  if (yytoken != YYEMPTY)
-    {
-      int yyn = yypact[*yyssp];
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYSIZE_T yysize1 = yysize + yytnamerr (YY_NULL, yytname[yyx]);
-                  if (! (yysize <= yysize1
-                         && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-                    return 2;
-                  yysize = yysize1;
-                }
-              }
-        }
-    }
-
-  switch (yycount)
-    {
-# define YYCASE_(N, S)                      \
-      case N:                               \
-        yyformat = S;                       \
-      break
-      YYCASE_(0, YY_("syntax error"));
-      YYCASE_(1, YY_("syntax error, unexpected %s"));
-      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
-      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
-      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
-      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
-    }
-
-  {
-    YYSIZE_T yysize1 = yysize + yystrlen (yyformat);
-    if (! (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-      return 2;
-    yysize = yysize1;
-  }
-
-  if (*yymsg_alloc < yysize)
-    {
-      *yymsg_alloc = 2 * yysize;
-      if (! (yysize <= *yymsg_alloc
-             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
-        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
-    }
-
-  /* Avoid sprintf, as that infringes on the user's name space.
-     Don't have undefined behavior even if the translation
-     produced a string with the wrong number of "%s"s.  */
-  {
-    char *yyp = *yymsg;
-    int yyi = 0;
-    while ((*yyp = *yyformat) != '\0')
-      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
-        {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
-          yyformat += 2;
-        }
-      else
-        {
-          yyp++;
-          yyformat++;
-        }
-  }
-  return 0;
-}
-#endif /* YYERROR_VERBOSE */
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, YYLTYPE *yylocationp)
-#else
 static void
-yydestruct (yymsg, yytype, yyvaluep, yylocationp)
-    const char *yymsg;
-    int yytype;
-    YYSTYPE *yyvaluep;
-    YYLTYPE *yylocationp;
-#endif
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, YYLTYPE *yylocationp)
 {
-  YYUSE (yyvaluep);
-  YYUSE (yylocationp);
-
+  YY_USE (yyvaluep);
+  YY_USE (yylocationp);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
-  switch (yytype)
-    {
-
-      default:
-        break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-
-
-/* The lookahead symbol.  */
+/* Lookahead token kind.  */
 int yychar;
 
-
-#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-# define YY_IGNORE_MAYBE_UNINITIALIZED_END
-#endif
-#ifndef YY_INITIAL_VALUE
-# define YY_INITIAL_VALUE(Value) /* Nothing. */
-#endif
-
 /* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval YY_INITIAL_VALUE(yyval_default);
-
+YYSTYPE yylval;
 /* Location data for the lookahead symbol.  */
 YYLTYPE yylloc
 # if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
   = { 1, 1, 1, 1 }
 # endif
 ;
-
-
 /* Number of syntax errors so far.  */
 int yynerrs;
 
 
+
+
 /*----------.
 | yyparse.  |
 `----------*/
 
-#ifdef YYPARSE_PARAM
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-int
-yyparse (void *YYPARSE_PARAM)
-#else
-int
-yyparse (YYPARSE_PARAM)
-    void *YYPARSE_PARAM;
-#endif
-#else /* ! YYPARSE_PARAM */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 int
 yyparse (void)
-#else
-int
-yyparse ()
-
-#endif
-#endif
 {
-    int yystate;
+    yy_state_fast_t yystate = 0;
     /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
-
-    /* The stacks and their tools:
-       `yyss': related to states.
-       `yyvs': related to semantic values.
-       `yyls': related to locations.
+    int yyerrstatus = 0;
 
-       Refer to the stacks through separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    /* The semantic value stack.  */
+    /* The semantic value stack: array, bottom, top.  */
     YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
-    /* The location stack.  */
+    /* The location stack: array, bottom, top.  */
     YYLTYPE yylsa[YYINITDEPTH];
-    YYLTYPE *yyls;
-    YYLTYPE *yylsp;
-
-    /* The locations where the error started and ended.  */
-    YYLTYPE yyerror_range[3];
-
-    YYSIZE_T yystacksize;
+    YYLTYPE *yyls = yylsa;
+    YYLTYPE *yylsp = yyls;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
   YYLTYPE yyloc;
 
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+  /* The locations where the error started and ended.  */
+  YYLTYPE yyerror_range[3];
+
+
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N), yylsp -= (N))
 
@@ -1666,109 +1544,113 @@ yyparse ()
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yylsp = yyls = yylsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   yylsp[0] = yylloc;
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
-	/* Give user a chance to reallocate the stack.  Use copies of
-	   these so that the &'s don't force the real ones into
-	   memory.  */
-	YYSTYPE *yyvs1 = yyvs;
-	yytype_int16 *yyss1 = yyss;
-	YYLTYPE *yyls1 = yyls;
-
-	/* Each stack pointer address is followed by the size of the
-	   data in use in that stack, in bytes.  This used to be a
-	   conditional around just the two extra args, but that might
-	   be undefined if yyoverflow is a macro.  */
-	yyoverflow (YY_("memory exhausted"),
-		    &yyss1, yysize * sizeof (*yyssp),
-		    &yyvs1, yysize * sizeof (*yyvsp),
-		    &yyls1, yysize * sizeof (*yylsp),
-		    &yystacksize);
-
-	yyls = yyls1;
-	yyss = yyss1;
-	yyvs = yyvs1;
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+        YYLTYPE *yyls1 = yyls;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yyls1, yysize * YYSIZEOF (*yylsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+        yyls = yyls1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-	goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
-	yystacksize = YYMAXDEPTH;
+        yystacksize = YYMAXDEPTH;
 
       {
-	yytype_int16 *yyss1 = yyss;
-	union yyalloc *yyptr =
-	  (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
-	if (! yyptr)
-	  goto yyexhaustedlab;
-	YYSTACK_RELOCATE (yyss_alloc, yyss);
-	YYSTACK_RELOCATE (yyvs_alloc, yyvs);
-	YYSTACK_RELOCATE (yyls_alloc, yyls);
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+        YYSTACK_RELOCATE (yyls_alloc, yyls);
 #  undef YYSTACK_RELOCATE
-	if (yyss1 != yyssa)
-	  YYSTACK_FREE (yyss1);
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
       yylsp = yyls + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-		  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
-	YYABORT;
+        YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
@@ -1779,18 +1661,30 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = YYLEX;
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex ();
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      yyerror_range[1] = yylloc;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1818,15 +1712,14 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
   YY_IGNORE_MAYBE_UNINITIALIZED_END
   *++yylsp = yylloc;
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1841,14 +1734,14 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
   yylen = yyr2[yyn];
 
   /* If YYLEN is nonzero, implement the default value of the action:
-     `$$ = $1'.
+     '$$ = $1'.
 
      Otherwise, the following line sets YYVAL to garbage.
      This behavior is undocumented and Bison
@@ -1857,775 +1750,820 @@ yyreduce:
      GCC warning that YYVAL may be used uninitialized.  */
   yyval = yyvsp[1-yylen];
 
-  /* Default location.  */
+  /* Default location. */
   YYLLOC_DEFAULT (yyloc, (yylsp - yylen), yylen);
+  yyerror_range[1] = yyloc;
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 2:
-/* Line 1792 of yacc.c  */
-#line 135 "parser.y"
-    { 
-                                      (yylsp[(1) - (1)]); 
+  case 2: /* Program: DeclList  */
+#line 138 "parser.y"
+                                   { 
+                                      (yylsp[0]); 
                                       /* pp2: The @1 is needed to convince 
                                        * yacc to set up yylloc. You can remove 
                                        * it once you have other uses of @n*/
-                                      Program *program = new Program((yyvsp[(1) - (1)].declList));
-                                      // if no errors, advance to next phase
+                                      Program *program = new Program((yyvsp[0].declList));
+                                      // if no errors, hand the tree to main() for
+                                      // checking and code generation
                                       if (ReportError::NumErrors() == 0) {
                                           if ( IsDebugOn("dumpAST") ) {
                                             program->Print(0);
                                           }
-                                          program->Emit();
+                                          parsedProgram = program;
                                       }
                                     }
+#line 1777 "y.tab.c"
     break;
 
-  case 3:
-/* Line 1792 of yacc.c  */
-#line 151 "parser.y"
-    { ((yyval.declList)=(yyvsp[(1) - (2)].declList))->Append((yyvsp[(2) - (2)].decl)); }
+  case 3: /* DeclList: DeclList Decl  */
+#line 155 "parser.y"
+                                    { ((yyval.declList)=(yyvsp[-1].declList))->Append((yyvsp[0].decl)); }
+#line 1783 "y.tab.c"
     break;
 
-  case 4:
-/* Line 1792 of yacc.c  */
-#line 152 "parser.y"
-    { ((yyval.declList) = new List<Decl*>)->Append((yyvsp[(1) - (1)].decl)); }
+  case 4: /* DeclList: Decl  */
+#line 156 "parser.y"
+                                    { ((yyval.declList) = new List<Decl*>)->Append((yyvsp[0].decl)); }
+#line 1789 "y.tab.c"
     break;
 
-  case 5:
-/* Line 1792 of yacc.c  */
-#line 163 "parser.y"
-    { (yyval.decl) = (yyvsp[(1) - (1)].decl); }
+  case 5: /* Decl: Declaration  */
+#line 167 "parser.y"
+                                             { (yyval.decl) = (yyvsp[0].decl); }
+#line 1795 "y.tab.c"
     break;
 
-  case 6:
-/* Line 1792 of yacc.c  */
-#line 164 "parser.y"
-    { (yyvsp[(1) - (2)].funcDecl)->SetFunctionBody((yyvsp[(2) - (2)].stmt)); (yyval.decl) = (yyvsp[(1) - (2)].funcDecl); }
+  case 6: /* Decl: FuncDecl CompoundStatement  */
+#line 168 "parser.y"
+                                             { (yyvsp[-1].funcDecl)->SetFunctionBody((yyvsp[0].stmt)); (yyval.decl) = (yyvsp[-1].funcDecl); }
+#line 1801 "y.tab.c"
     break;
 
-  case 7:
-/* Line 1792 of yacc.c  */
-#line 175 "parser.y"
-    { (yyval.decl) = (yyvsp[(1) - (2)].funcDecl); }
+  case 7: /* Declaration: FuncDecl T_Semicolon  */
+#line 179 "parser.y"
+                                     { (yyval.decl) = (yyvsp[-1].funcDecl); }
+#line 1807 "y.tab.c"
     break;
 
-  case 8:
-/* Line 1792 of yacc.c  */
-#line 176 "parser.y"
-    { (yyval.decl) = (yyvsp[(1) - (2)].varDecl); }
+  case 8: /* Declaration: SingleDecl T_Semicolon  */
+#line 180 "parser.y"
+                                     { (yyval.decl) = (yyvsp[-1].varDecl); }
+#line 1813 "y.tab.c"
     break;
 
-  case 9:
-/* Line 1792 of yacc.c  */
-#line 180 "parser.y"
-    {
-                            Identifier *id = new Identifier(yylloc, (const char *)(yyvsp[(2) - (4)].identifier)); 
+  case 9: /* FuncDecl: TypeDecl T_Identifier T_LeftParen T_RightParen  */
+#line 184 "parser.y"
+                         {
+                            Identifier *id = new Identifier(yylloc, (const char *)(yyvsp[-2].identifier)); 
                             List<VarDecl *> *formals = new List<VarDecl *>;
-                            (yyval.funcDecl) = new FnDecl(id, (yyvsp[(1) - (4)].typeDecl), formals);
+                            (yyval.funcDecl) = new FnDecl(id, (yyvsp[-3].typeDecl), formals);
                          }
+#line 1823 "y.tab.c"
     break;
 
-  case 10:
-/* Line 1792 of yacc.c  */
-#line 186 "parser.y"
-    {
-                            Identifier *id = new Identifier(yylloc, (const char *)(yyvsp[(2) - (5)].identifier)); 
-                            (yyval.funcDecl) = new FnDecl(id, (yyvsp[(1) - (5)].typeDecl), (yyvsp[(4) - (5)].varDeclList));
+  case 10: /* FuncDecl: TypeDecl T_Identifier T_LeftParen ParameterList T_RightParen  */
+#line 190 "parser.y"
+                         {
+                            Identifier *id = new Identifier(yylloc, (const char *)(yyvsp[-3].identifier)); 
+                            (yyval.funcDecl) = new FnDecl(id, (yyvsp[-4].typeDecl), (yyvsp[-1].varDeclList));
                          }
+#line 1832 "y.tab.c"
     break;
 
-  case 11:
-/* Line 1792 of yacc.c  */
-#line 192 "parser.y"
-    { ((yyval.varDeclList) = new List<VarDecl *>)->Append((yyvsp[(1) - (1)].varDecl));  }
+  case 11: /* ParameterList: SingleDecl  */
+#line 196 "parser.y"
+                           { ((yyval.varDeclList) = new List<VarDecl *>)->Append((yyvsp[0].varDecl));  }
+#line 1838 "y.tab.c"
     break;
 
-  case 12:
-/* Line 1792 of yacc.c  */
-#line 193 "parser.y"
-    { ((yyval.varDeclList) = (yyvsp[(1) - (3)].varDeclList))->Append((yyvsp[(3) - (3)].varDecl)); }
+  case 12: /* ParameterList: ParameterList T_Comma SingleDecl  */
+#line 197 "parser.y"
+                                                 { ((yyval.varDeclList) = (yyvsp[-2].varDeclList))->Append((yyvsp[0].varDecl)); }
+#line 1844 "y.tab.c"
     break;
 
-  case 13:
-/* Line 1792 of yacc.c  */
-#line 197 "parser.y"
-    {
-                            Identifier *id = new Identifier(yylloc, (const char *)(yyvsp[(2) - (2)].identifier)); 
-                            (yyval.varDecl) = new VarDecl(id, (yyvsp[(1) - (2)].typeDecl));
+  case 13: /* SingleDecl: TypeDecl T_Identifier  */
+#line 201 "parser.y"
+                         {
+                            Identifier *id = new Identifier(yylloc, (const char *)(yyvsp[0].identifier)); 
+                            (yyval.varDecl) = new VarDecl(id, (yyvsp[-1].typeDecl));
                          }
+#line 1853 "y.tab.c"
     break;
 
-  case 14:
-/* Line 1792 of yacc.c  */
-#line 202 "parser.y"
-    {
-                            Identifier *id = new Identifier(yylloc, (const char *)(yyvsp[(3) - (3)].identifier)); 
-                            (yyval.varDecl) = new VarDecl(id, (yyvsp[(2) - (3)].typeDecl), (yyvsp[(1) - (3)].typeQualifier));
+  case 14: /* SingleDecl: TypeQualify TypeDecl T_Identifier  */
+#line 206 "parser.y"
+                         {
+                            Identifier *id = new Identifier(yylloc, (const char *)(yyvsp[0].identifier)); 
+                            (yyval.varDecl) = new VarDecl(id, (yyvsp[-1].typeDecl), (yyvsp[-2].typeQualifier));
                          }
+#line 1862 "y.tab.c"
     break;
 
-  case 15:
-/* Line 1792 of yacc.c  */
-#line 207 "parser.y"
-    {
+  case 15: /* SingleDecl: TypeDecl T_Identifier T_Equal Initializer  */
+#line 211 "parser.y"
+                         {
                             // incomplete: drop the initializer here
-                            Identifier *id = new Identifier(yylloc, (const char *)(yyvsp[(2) - (4)].identifier)); 
-                            (yyval.varDecl) = new VarDecl(id, (yyvsp[(1) - (4)].typeDecl), (yyvsp[(4) - (4)].expression));
+                            Identifier *id = new Identifier(yylloc, (const char *)(yyvsp[-2].identifier)); 
+                            (yyval.varDecl) = new VarDecl(id, (yyvsp[-3].typeDecl), (yyvsp[0].expression));
                          }
+#line 1872 "y.tab.c"
     break;
 
-  case 16:
-/* Line 1792 of yacc.c  */
-#line 213 "parser.y"
-    {
-                            Identifier *id = new Identifier(yylloc, (const char *)(yyvsp[(3) - (5)].identifier)); 
-                            (yyval.varDecl) = new VarDecl(id, (yyvsp[(2) - (5)].typeDecl), (yyvsp[(1) - (5)].typeQualifier), (yyvsp[(5) - (5)].expression));
+  case 16: /* SingleDecl: TypeQualify TypeDecl T_Identifier T_Equal Initializer  */
+#line 217 "parser.y"
+                         {
+                            Identifier *id = new Identifier(yylloc, (const char *)(yyvsp[-2].identifier)); 
+                            (yyval.varDecl) = new VarDecl(id, (yyvsp[-3].typeDecl), (yyvsp[-4].typeQualifier), (yyvsp[0].expression));
                          }
+#line 1881 "y.tab.c"
     break;
 
-  case 17:
-/* Line 1792 of yacc.c  */
-#line 218 "parser.y"
-    { 
-                            Identifier *id = new Identifier((yylsp[(2) - (5)]), (const char *)(yyvsp[(2) - (5)].identifier));
-                            (yyval.varDecl) = new VarDecl(id, new ArrayType((yylsp[(1) - (5)]), (yyvsp[(1) - (5)].typeDecl), (yyvsp[(4) - (5)].integerConstant)));
+  case 17: /* SingleDecl: TypeDecl T_Identifier T_LeftBracket Expression T_RightBracket  */
+#line 222 "parser.y"
+                         { 
+                            Identifier *id = new Identifier((yylsp[-3]), (const char *)(yyvsp[-3].identifier));
+                            (yyval.varDecl) = new VarDecl(id, new ArrayType((yylsp[-4]), (yyvsp[-4].typeDecl), (yyvsp[-1].expression)));
                          }
+#line 1890 "y.tab.c"
     break;
 
-  case 18:
-/* Line 1792 of yacc.c  */
-#line 223 "parser.y"
-    { 
-                            Identifier *id = new Identifier((yylsp[(3) - (6)]), (yyvsp[(3) - (6)].identifier));
-                            (yyval.varDecl) = new VarDecl(id, new ArrayType((yylsp[(2) - (6)]), (yyvsp[(2) - (6)].typeDecl), (yyvsp[(5) - (6)].integerConstant)), (yyvsp[(1) - (6)].typeQualifier));
+  case 18: /* SingleDecl: TypeQualify TypeDecl T_Identifier T_LeftBracket Expression T_RightBracket  */
+#line 227 "parser.y"
+                         { 
+                            Identifier *id = new Identifier((yylsp[-3]), (yyvsp[-3].identifier));
+                            (yyval.varDecl) = new VarDecl(id, new ArrayType((yylsp[-4]), (yyvsp[-4].typeDecl), (yyvsp[-1].expression)), (yyvsp[-5].typeQualifier));
                          }
+#line 1899 "y.tab.c"
     break;
 
-  case 19:
-/* Line 1792 of yacc.c  */
-#line 230 "parser.y"
-    { (yyval.expression) = (yyvsp[(1) - (1)].expression); }
+  case 19: /* SingleDecl: TypeDecl T_Identifier T_LeftBracket Expression T_RightBracket T_Equal Initializer  */
+#line 232 "parser.y"
+                         { 
+                            Identifier *id = new Identifier((yylsp[-5]), (const char *)(yyvsp[-5].identifier));
+                            (yyval.varDecl) = new VarDecl(id, new ArrayType((yylsp[-6]), (yyvsp[-6].typeDecl), (yyvsp[-3].expression)), (yyvsp[0].expression));
+                         }
+#line 1908 "y.tab.c"
     break;
 
-  case 20:
-/* Line 1792 of yacc.c  */
-#line 233 "parser.y"
-    {(yyval.typeQualifier) = TypeQualifier::inTypeQualifier;}
+  case 20: /* SingleDecl: TypeQualify TypeDecl T_Identifier T_LeftBracket Expression T_RightBracket T_Equal Initializer  */
+#line 237 "parser.y"
+                         { 
+                            Identifier *id = new Identifier((yylsp[-5]), (yyvsp[-5].identifier));
+                            (yyval.varDecl) = new VarDecl(id, new ArrayType((yylsp[-6]), (yyvsp[-6].typeDecl), (yyvsp[-3].expression)), (yyvsp[-7].typeQualifier), (yyvsp[0].expression));
+                         }
+#line 1917 "y.tab.c"
     break;
 
-  case 21:
-/* Line 1792 of yacc.c  */
-#line 234 "parser.y"
-    {(yyval.typeQualifier) = TypeQualifier::outTypeQualifier;}
+  case 21: /* Initializer: Expression  */
+#line 244 "parser.y"
+                                   { (yyval.expression) = (yyvsp[0].expression); }
+#line 1923 "y.tab.c"
     break;
 
-  case 22:
-/* Line 1792 of yacc.c  */
-#line 235 "parser.y"
-    {(yyval.typeQualifier) = TypeQualifier::constTypeQualifier;}
+  case 22: /* TypeQualify: T_In  */
+#line 247 "parser.y"
+                            {(yyval.typeQualifier) = TypeQualifier::inTypeQualifier;}
+#line 1929 "y.tab.c"
     break;
 
-  case 23:
-/* Line 1792 of yacc.c  */
-#line 236 "parser.y"
-    {(yyval.typeQualifier) = TypeQualifier::uniformTypeQualifier;}
+  case 23: /* TypeQualify: T_Out  */
+#line 248 "parser.y"
+                            {(yyval.typeQualifier) = TypeQualifier::outTypeQualifier;}
+#line 1935 "y.tab.c"
     break;
 
-  case 24:
-/* Line 1792 of yacc.c  */
-#line 239 "parser.y"
-    { (yyval.typeDecl) = Type::intType;    }
+  case 24: /* TypeQualify: T_Const  */
+#line 249 "parser.y"
+                            {(yyval.typeQualifier) = TypeQualifier::constTypeQualifier;}
+#line 1941 "y.tab.c"
     break;
 
-  case 25:
-/* Line 1792 of yacc.c  */
-#line 240 "parser.y"
-    { (yyval.typeDecl) = Type::voidType;   }
+  case 25: /* TypeQualify: T_Uniform  */
+#line 250 "parser.y"
+                            {(yyval.typeQualifier) = TypeQualifier::uniformTypeQualifier;}
+#line 1947 "y.tab.c"
     break;
 
-  case 26:
-/* Line 1792 of yacc.c  */
-#line 241 "parser.y"
-    { (yyval.typeDecl) = Type::floatType;  }
+  case 26: /* TypeDecl: T_Int  */
+#line 253 "parser.y"
+                                         { (yyval.typeDecl) = Type::intType;    }
+#line 1953 "y.tab.c"
     break;
 
-  case 27:
-/* Line 1792 of yacc.c  */
-#line 242 "parser.y"
-    { (yyval.typeDecl) = Type::boolType;   }
+  case 27: /* TypeDecl: T_Void  */
+#line 254 "parser.y"
+                                         { (yyval.typeDecl) = Type::voidType;   }
+#line 1959 "y.tab.c"
     break;
 
-  case 28:
-/* Line 1792 of yacc.c  */
-#line 243 "parser.y"
-    { (yyval.typeDecl) = Type::vec2Type;   }
+  case 28: /* TypeDecl: T_Float  */
+#line 255 "parser.y"
+                                         { (yyval.typeDecl) = Type::floatType;  }
+#line 1965 "y.tab.c"
     break;
 
-  case 29:
-/* Line 1792 of yacc.c  */
-#line 244 "parser.y"
-    { (yyval.typeDecl) = Type::vec3Type;   }
+  case 29: /* TypeDecl: T_Bool  */
+#line 256 "parser.y"
+                                         { (yyval.typeDecl) = Type::boolType;   }
+#line 1971 "y.tab.c"
     break;
 
-  case 30:
-/* Line 1792 of yacc.c  */
-#line 245 "parser.y"
-    { (yyval.typeDecl) = Type::vec4Type;   }
+  case 30: /* TypeDecl: T_Vec2  */
+#line 257 "parser.y"
+                                         { (yyval.typeDecl) = Type::vec2Type;   }
+#line 1977 "y.tab.c"
     break;
 
-  case 31:
-/* Line 1792 of yacc.c  */
-#line 246 "parser.y"
-    { (yyval.typeDecl) = Type::mat2Type;   }
+  case 31: /* TypeDecl: T_Vec3  */
+#line 258 "parser.y"
+                                         { (yyval.typeDecl) = Type::vec3Type;   }
+#line 1983 "y.tab.c"
     break;
 
-  case 32:
-/* Line 1792 of yacc.c  */
-#line 247 "parser.y"
-    { (yyval.typeDecl) = Type::mat3Type;   }
+  case 32: /* TypeDecl: T_Vec4  */
+#line 259 "parser.y"
+                                         { (yyval.typeDecl) = Type::vec4Type;   }
+#line 1989 "y.tab.c"
     break;
 
-  case 33:
-/* Line 1792 of yacc.c  */
-#line 248 "parser.y"
-    { (yyval.typeDecl) = Type::mat4Type;   }
+  case 33: /* TypeDecl: T_Mat2  */
+#line 260 "parser.y"
+                                         { (yyval.typeDecl) = Type::mat2Type;   }
+#line 1995 "y.tab.c"
     break;
 
-  case 34:
-/* Line 1792 of yacc.c  */
-#line 251 "parser.y"
-    { (yyval.stmt) = new StmtBlock(new List<VarDecl*>, new List<Stmt *>); }
+  case 34: /* TypeDecl: T_Mat3  */
+#line 261 "parser.y"
+                                         { (yyval.typeDecl) = Type::mat3Type;   }
+#line 2001 "y.tab.c"
     break;
 
-  case 35:
-/* Line 1792 of yacc.c  */
-#line 252 "parser.y"
-    { (yyval.stmt) = new StmtBlock(new List<VarDecl*>, (yyvsp[(2) - (3)].stmtList)); }
+  case 35: /* TypeDecl: T_Mat4  */
+#line 262 "parser.y"
+                                         { (yyval.typeDecl) = Type::mat4Type;   }
+#line 2007 "y.tab.c"
     break;
 
-  case 36:
-/* Line 1792 of yacc.c  */
-#line 255 "parser.y"
-    { ((yyval.stmtList) = new List<Stmt*>)->Append((yyvsp[(1) - (1)].stmt)); }
+  case 36: /* CompoundStatement: T_LeftBrace T_RightBrace  */
+#line 265 "parser.y"
+                                                           { (yyval.stmt) = new StmtBlock(new List<VarDecl*>, new List<Stmt *>); }
+#line 2013 "y.tab.c"
     break;
 
-  case 37:
-/* Line 1792 of yacc.c  */
-#line 256 "parser.y"
-    { ((yyval.stmtList) = (yyvsp[(1) - (2)].stmtList))->Append((yyvsp[(2) - (2)].stmt)); }
+  case 37: /* CompoundStatement: T_LeftBrace StatementList T_RightBrace  */
+#line 266 "parser.y"
+                                                           { (yyval.stmt) = new StmtBlock(new List<VarDecl*>, (yyvsp[-1].stmtList)); }
+#line 2019 "y.tab.c"
     break;
 
-  case 38:
-/* Line 1792 of yacc.c  */
-#line 259 "parser.y"
-    { (yyval.stmt) = (yyvsp[(1) - (1)].stmt); }
+  case 38: /* StatementList: Statement  */
+#line 269 "parser.y"
+                                              { ((yyval.stmtList) = new List<Stmt*>)->Append((yyvsp[0].stmt)); }
+#line 2025 "y.tab.c"
     break;
 
-  case 39:
-/* Line 1792 of yacc.c  */
-#line 260 "parser.y"
-    { (yyval.stmt) = (yyvsp[(1) - (1)].stmt); }
+  case 39: /* StatementList: StatementList Statement  */
+#line 270 "parser.y"
+                                              { ((yyval.stmtList) = (yyvsp[-1].stmtList))->Append((yyvsp[0].stmt)); }
+#line 2031 "y.tab.c"
     break;
 
-  case 40:
-/* Line 1792 of yacc.c  */
-#line 263 "parser.y"
-    { (yyval.stmt) = new EmptyExpr();  }
+  case 40: /* Statement: CompoundStatement  */
+#line 273 "parser.y"
+                                           { (yyval.stmt) = (yyvsp[0].stmt); }
+#line 2037 "y.tab.c"
     break;
 
-  case 41:
-/* Line 1792 of yacc.c  */
-#line 265 "parser.y"
-    {
-                                       (yyval.stmt) = new DeclStmt((yyvsp[(1) - (2)].varDecl));
+  case 41: /* Statement: SingleStatement  */
+#line 274 "parser.y"
+                                           { (yyval.stmt) = (yyvsp[0].stmt); }
+#line 2043 "y.tab.c"
+    break;
+
+  case 42: /* SingleStatement: T_Semicolon  */
+#line 277 "parser.y"
+                                     { (yyval.stmt) = new EmptyExpr();  }
+#line 2049 "y.tab.c"
+    break;
+
+  case 43: /* SingleStatement: SingleDecl T_Semicolon  */
+#line 279 "parser.y"
+                                     {
+                                       (yyval.stmt) = new DeclStmt((yyvsp[-1].varDecl));
                                      }
+#line 2057 "y.tab.c"
     break;
 
-  case 42:
-/* Line 1792 of yacc.c  */
-#line 268 "parser.y"
-    { (yyval.stmt) = (yyvsp[(1) - (2)].expression); }
+  case 44: /* SingleStatement: Expression T_Semicolon  */
+#line 282 "parser.y"
+                                           { (yyval.stmt) = (yyvsp[-1].expression); }
+#line 2063 "y.tab.c"
     break;
 
-  case 43:
-/* Line 1792 of yacc.c  */
-#line 269 "parser.y"
-    { (yyval.stmt) = (yyvsp[(1) - (1)].stmt); }
+  case 45: /* SingleStatement: SelectionStmt  */
+#line 283 "parser.y"
+                                     { (yyval.stmt) = (yyvsp[0].stmt); }
+#line 2069 "y.tab.c"
     break;
 
-  case 44:
-/* Line 1792 of yacc.c  */
-#line 270 "parser.y"
-    { (yyval.stmt) = (yyvsp[(1) - (1)].stmt); }
+  case 46: /* SingleStatement: SwitchStmt  */
+#line 284 "parser.y"
+                                     { (yyval.stmt) = (yyvsp[0].stmt); }
+#line 2075 "y.tab.c"
     break;
 
-  case 45:
-/* Line 1792 of yacc.c  */
-#line 271 "parser.y"
-    { (yyval.stmt) = (yyvsp[(1) - (1)].stmt); }
+  case 47: /* SingleStatement: CaseStmt  */
+#line 285 "parser.y"
+                                     { (yyval.stmt) = (yyvsp[0].stmt); }
+#line 2081 "y.tab.c"
     break;
 
-  case 46:
-/* Line 1792 of yacc.c  */
-#line 272 "parser.y"
-    { (yyval.stmt) = (yyvsp[(1) - (1)].stmt); }
+  case 48: /* SingleStatement: JumpStmt  */
+#line 286 "parser.y"
+                                     { (yyval.stmt) = (yyvsp[0].stmt); }
+#line 2087 "y.tab.c"
     break;
 
-  case 47:
-/* Line 1792 of yacc.c  */
-#line 273 "parser.y"
-    { (yyval.stmt) = (yyvsp[(1) - (1)].stmt); }
+  case 49: /* SingleStatement: WhileStmt  */
+#line 287 "parser.y"
+                                     { (yyval.stmt) = (yyvsp[0].stmt); }
+#line 2093 "y.tab.c"
     break;
 
-  case 48:
-/* Line 1792 of yacc.c  */
-#line 274 "parser.y"
-    { (yyval.stmt) = (yyvsp[(1) - (1)].stmt); }
+  case 50: /* SingleStatement: ForStmt  */
+#line 288 "parser.y"
+                                     { (yyval.stmt) = (yyvsp[0].stmt); }
+#line 2099 "y.tab.c"
+    break;
+
+  case 51: /* SingleStatement: T_Pragma Statement  */
+#line 290 "parser.y"
+                                     {
+                                       // the only pragmas recognized are hints on loops
+                                       LoopStmt *loop = dynamic_cast<LoopStmt*>((yyvsp[0].stmt));
+                                       if (loop == NULL || !loop->AddPragma((yyvsp[-1].identifier)))
+                                         ReportError::Formatted(&(yylsp[-1]),
+                                           "#pragma %s is not a hint on the loop following it", (yyvsp[-1].identifier));
+                                       (yyval.stmt) = (yyvsp[0].stmt);
+                                     }
+#line 2112 "y.tab.c"
     break;
 
-  case 49:
-/* Line 1792 of yacc.c  */
-#line 278 "parser.y"
-    {
-                                        (yyval.stmt) = new IfStmt((yyvsp[(3) - (7)].expression), (yyvsp[(5) - (7)].stmt), (yyvsp[(7) - (7)].stmt));
+  case 52: /* SelectionStmt: T_If T_LeftParen Expression T_RightParen Statement T_Else Statement  */
+#line 301 "parser.y"
+                                     {
+                                        (yyval.stmt) = new IfStmt((yyvsp[-4].expression), (yyvsp[-2].stmt), (yyvsp[0].stmt));
                                      }
+#line 2120 "y.tab.c"
     break;
 
-  case 50:
-/* Line 1792 of yacc.c  */
-#line 282 "parser.y"
-    {
-                                        (yyval.stmt) = new IfStmt((yyvsp[(3) - (5)].expression), (yyvsp[(5) - (5)].stmt), NULL);
+  case 53: /* SelectionStmt: T_If T_LeftParen Expression T_RightParen Statement  */
+#line 305 "parser.y"
+                                     {
+                                        (yyval.stmt) = new IfStmt((yyvsp[-2].expression), (yyvsp[0].stmt), NULL);
                                      }
+#line 2128 "y.tab.c"
     break;
 
-  case 51:
-/* Line 1792 of yacc.c  */
-#line 288 "parser.y"
-    {
-                                        (yyval.stmt) = new SwitchStmt((yyvsp[(3) - (7)].expression), (yyvsp[(6) - (7)].stmtList), NULL);
+  case 54: /* SwitchStmt: T_Switch T_LeftParen Expression T_RightParen T_LeftBrace StatementList T_RightBrace  */
+#line 311 "parser.y"
+                                     {
+                                        (yyval.stmt) = new SwitchStmt((yyvsp[-4].expression), (yyvsp[-1].stmtList), NULL);
                                      }
+#line 2136 "y.tab.c"
     break;
 
-  case 52:
-/* Line 1792 of yacc.c  */
-#line 292 "parser.y"
-    { (yyval.stmt) = new Case((yyvsp[(2) - (4)].expression), (yyvsp[(4) - (4)].stmt)); }
+  case 55: /* CaseStmt: T_Case Expression T_Colon Statement  */
+#line 315 "parser.y"
+                                                          { (yyval.stmt) = new Case((yyvsp[-2].expression), (yyvsp[0].stmt)); }
+#line 2142 "y.tab.c"
     break;
 
-  case 53:
-/* Line 1792 of yacc.c  */
-#line 293 "parser.y"
-    { (yyval.stmt) = new Default((yyvsp[(3) - (3)].stmt)); }
+  case 56: /* CaseStmt: T_Default T_Colon Statement  */
+#line 316 "parser.y"
+                                                          { (yyval.stmt) = new Default((yyvsp[0].stmt)); }
+#line 2148 "y.tab.c"
     break;
 
-  case 54:
-/* Line 1792 of yacc.c  */
-#line 296 "parser.y"
-    { (yyval.stmt) = new BreakStmt(yylloc); }
+  case 57: /* JumpStmt: T_Break T_Semicolon  */
+#line 319 "parser.y"
+                                              { (yyval.stmt) = new BreakStmt(yylloc); }
+#line 2154 "y.tab.c"
     break;
 
-  case 55:
-/* Line 1792 of yacc.c  */
-#line 297 "parser.y"
-    { (yyval.stmt) = new ContinueStmt(yylloc); }
+  case 58: /* JumpStmt: T_Continue T_Semicolon  */
+#line 320 "parser.y"
+                                              { (yyval.stmt) = new ContinueStmt(yylloc); }
+#line 2160 "y.tab.c"
     break;
 
-  case 56:
-/* Line 1792 of yacc.c  */
-#line 298 "parser.y"
-    { (yyval.stmt) = new ReturnStmt(yylloc); }
+  case 59: /* JumpStmt: T_Return T_Semicolon  */
+#line 321 "parser.y"
+                                              { (yyval.stmt) = new ReturnStmt(yylloc); }
+#line 2166 "y.tab.c"
     break;
 
-  case 57:
-/* Line 1792 of yacc.c  */
-#line 299 "parser.y"
-    { (yyval.stmt) = new ReturnStmt(yyloc, (yyvsp[(2) - (3)].expression)); }
+  case 60: /* JumpStmt: T_Return Expression T_Semicolon  */
+#line 322 "parser.y"
+                                                     { (yyval.stmt) = new ReturnStmt(yyloc, (yyvsp[-1].expression)); }
+#line 2172 "y.tab.c"
     break;
 
-  case 58:
-/* Line 1792 of yacc.c  */
-#line 302 "parser.y"
-    { (yyval.stmt) = new WhileStmt((yyvsp[(3) - (5)].expression), (yyvsp[(5) - (5)].stmt)); }
+  case 61: /* WhileStmt: T_While T_LeftParen Expression T_RightParen Statement  */
+#line 325 "parser.y"
+                                                                           { (yyval.stmt) = new WhileStmt((yyvsp[-2].expression), (yyvsp[0].stmt)); }
+#line 2178 "y.tab.c"
     break;
 
-  case 59:
-/* Line 1792 of yacc.c  */
-#line 306 "parser.y"
-    {
-                                    (yyval.stmt) = new ForStmt((yyvsp[(3) - (9)].expression), (yyvsp[(5) - (9)].expression), (yyvsp[(7) - (9)].expression), (yyvsp[(9) - (9)].stmt));
+  case 62: /* ForStmt: T_For T_LeftParen Expression T_Semicolon Expression T_Semicolon Expression T_RightParen Statement  */
+#line 329 "parser.y"
+                                 {
+                                    (yyval.stmt) = new ForStmt((yyvsp[-6].expression), (yyvsp[-4].expression), (yyvsp[-2].expression), (yyvsp[0].stmt));
                                  }
+#line 2186 "y.tab.c"
     break;
 
-  case 60:
-/* Line 1792 of yacc.c  */
-#line 311 "parser.y"
-    { Identifier *id = new Identifier(yylloc, (const char*)(yyvsp[(1) - (1)].identifier));
+  case 63: /* PrimaryExpr: T_Identifier  */
+#line 334 "parser.y"
+                                     { Identifier *id = new Identifier(yylloc, (const char*)(yyvsp[0].identifier));
                                        (yyval.expression) = new VarExpr(yyloc, id);
                                      }
+#line 2194 "y.tab.c"
     break;
 
-  case 61:
-/* Line 1792 of yacc.c  */
-#line 314 "parser.y"
-    { (yyval.expression) = new IntConstant(yylloc, (yyvsp[(1) - (1)].integerConstant)); }
+  case 64: /* PrimaryExpr: T_IntConstant  */
+#line 337 "parser.y"
+                                     { (yyval.expression) = new IntConstant(yylloc, (yyvsp[0].integerConstant)); }
+#line 2200 "y.tab.c"
     break;
 
-  case 62:
-/* Line 1792 of yacc.c  */
-#line 315 "parser.y"
-    { (yyval.expression) = new FloatConstant(yylloc, (yyvsp[(1) - (1)].floatConstant)); }
+  case 65: /* PrimaryExpr: T_FloatConstant  */
+#line 338 "parser.y"
+                                     { (yyval.expression) = new FloatConstant(yylloc, (yyvsp[0].floatConstant)); }
+#line 2206 "y.tab.c"
     break;
 
-  case 63:
-/* Line 1792 of yacc.c  */
-#line 316 "parser.y"
-    { (yyval.expression) = new BoolConstant(yylloc, (yyvsp[(1) - (1)].boolConstant)); }
+  case 66: /* PrimaryExpr: T_BoolConstant  */
+#line 339 "parser.y"
+                                     { (yyval.expression) = new BoolConstant(yylloc, (yyvsp[0].boolConstant)); }
+#line 2212 "y.tab.c"
     break;
 
-  case 64:
-/* Line 1792 of yacc.c  */
-#line 317 "parser.y"
-    { (yyval.expression) = (yyvsp[(2) - (3)].expression);}
+  case 67: /* PrimaryExpr: T_LeftParen Expression T_RightParen  */
+#line 340 "parser.y"
+                                                         { (yyval.expression) = (yyvsp[-1].expression);}
+#line 2218 "y.tab.c"
     break;
 
-  case 65:
-/* Line 1792 of yacc.c  */
-#line 320 "parser.y"
-    { (yyval.expression) = (yyvsp[(1) - (2)].expression); }
+  case 68: /* FunctionCallExpr: FunctionCallHeaderWithParameters T_RightParen  */
+#line 343 "parser.y"
+                                                                     { (yyval.expression) = (yyvsp[-1].expression); }
+#line 2224 "y.tab.c"
     break;
 
-  case 66:
-/* Line 1792 of yacc.c  */
-#line 321 "parser.y"
-    { (yyval.expression) = (yyvsp[(1) - (2)].expression); }
+  case 69: /* FunctionCallExpr: FunctionCallHeaderNoParameters T_RightParen  */
+#line 344 "parser.y"
+                                                                     { (yyval.expression) = (yyvsp[-1].expression); }
+#line 2230 "y.tab.c"
     break;
 
-  case 67:
-/* Line 1792 of yacc.c  */
-#line 324 "parser.y"
-    { (yyval.expression) = new Call((yylsp[(1) - (3)]), NULL, (yyvsp[(1) - (3)].funcId), new List<Expr*>); }
+  case 70: /* FunctionCallExpr: TypeDecl T_LeftParen ArgumentList T_RightParen  */
+#line 345 "parser.y"
+                                                                      { (yyval.expression) = new ConstructorExpr((yylsp[-3]), (yyvsp[-3].typeDecl), (yyvsp[-1].argList)); }
+#line 2236 "y.tab.c"
     break;
 
-  case 68:
-/* Line 1792 of yacc.c  */
-#line 325 "parser.y"
-    { (yyval.expression) = new Call((yylsp[(1) - (2)]), NULL, (yyvsp[(1) - (2)].funcId), new List<Expr*>); }
+  case 71: /* FunctionCallExpr: TypeDecl T_LeftBracket Expression T_RightBracket T_LeftParen ArgumentList T_RightParen  */
+#line 347 "parser.y"
+                                       { (yyval.expression) = new ConstructorExpr((yylsp[-6]), new ArrayType((yylsp[-6]), (yyvsp[-6].typeDecl), (yyvsp[-4].expression)), (yyvsp[-1].argList)); }
+#line 2242 "y.tab.c"
     break;
 
-  case 69:
-/* Line 1792 of yacc.c  */
-#line 328 "parser.y"
-    { (yyval.expression) = new Call((yylsp[(1) - (3)]), NULL, (yyvsp[(1) - (3)].funcId), (yyvsp[(3) - (3)].argList));}
+  case 72: /* FunctionCallHeaderNoParameters: FunctionIdentifier T_LeftParen T_Void  */
+#line 350 "parser.y"
+                                                                           { (yyval.expression) = new Call((yylsp[-2]), NULL, (yyvsp[-2].funcId), new List<Expr*>); }
+#line 2248 "y.tab.c"
     break;
 
-  case 70:
-/* Line 1792 of yacc.c  */
-#line 331 "parser.y"
-    { ((yyval.argList) = new List<Expr*>)->Append((yyvsp[(1) - (1)].expression));}
+  case 73: /* FunctionCallHeaderNoParameters: FunctionIdentifier T_LeftParen  */
+#line 351 "parser.y"
+                                                                           { (yyval.expression) = new Call((yylsp[-1]), NULL, (yyvsp[-1].funcId), new List<Expr*>); }
+#line 2254 "y.tab.c"
     break;
 
-  case 71:
-/* Line 1792 of yacc.c  */
-#line 332 "parser.y"
-    { ((yyval.argList) = (yyvsp[(1) - (3)].argList))->Append((yyvsp[(3) - (3)].expression));}
+  case 74: /* FunctionCallHeaderWithParameters: FunctionIdentifier T_LeftParen ArgumentList  */
+#line 354 "parser.y"
+                                                                                 { (yyval.expression) = new Call((yylsp[-2]), NULL, (yyvsp[-2].funcId), (yyvsp[0].argList));}
+#line 2260 "y.tab.c"
     break;
 
-  case 72:
-/* Line 1792 of yacc.c  */
-#line 335 "parser.y"
-    { (yyval.funcId) = new Identifier((yylsp[(1) - (1)]), (yyvsp[(1) - (1)].identifier)); }
+  case 75: /* ArgumentList: Expression  */
+#line 357 "parser.y"
+                                                { ((yyval.argList) = new List<Expr*>)->Append((yyvsp[0].expression));}
+#line 2266 "y.tab.c"
     break;
 
-  case 73:
-/* Line 1792 of yacc.c  */
-#line 338 "parser.y"
-    { (yyval.expression) = (yyvsp[(1) - (1)].expression); }
+  case 76: /* ArgumentList: ArgumentList T_Comma Expression  */
+#line 358 "parser.y"
+                                                { ((yyval.argList) = (yyvsp[-2].argList))->Append((yyvsp[0].expression));}
+#line 2272 "y.tab.c"
     break;
 
-  case 74:
-/* Line 1792 of yacc.c  */
-#line 339 "parser.y"
-    { (yyval.expression) = new ArrayAccess((yylsp[(1) - (4)]), (yyvsp[(1) - (4)].expression), (yyvsp[(3) - (4)].expression)); }
+  case 77: /* FunctionIdentifier: T_Identifier  */
+#line 361 "parser.y"
+                                          { (yyval.funcId) = new Identifier((yylsp[0]), (yyvsp[0].identifier)); }
+#line 2278 "y.tab.c"
     break;
 
-  case 75:
-/* Line 1792 of yacc.c  */
-#line 341 "parser.y"
-    {
+  case 78: /* PostfixExpr: PrimaryExpr  */
+#line 364 "parser.y"
+                                     { (yyval.expression) = (yyvsp[0].expression); }
+#line 2284 "y.tab.c"
+    break;
+
+  case 79: /* PostfixExpr: PostfixExpr T_LeftBracket Expression T_RightBracket  */
+#line 365 "parser.y"
+                                                                         { (yyval.expression) = new ArrayAccess((yylsp[-3]), (yyvsp[-3].expression), (yyvsp[-1].expression)); }
+#line 2290 "y.tab.c"
+    break;
+
+  case 80: /* PostfixExpr: FunctionCallExpr  */
+#line 367 "parser.y"
+                                       {
                                        }
+#line 2297 "y.tab.c"
     break;
 
-  case 76:
-/* Line 1792 of yacc.c  */
-#line 344 "parser.y"
-    {
-                                          Operator *op = new Operator(yylloc, (const char *)(yyvsp[(2) - (2)].identifier));
-                                          (yyval.expression) = new PostfixExpr((yyvsp[(1) - (2)].expression), op);
+  case 81: /* PostfixExpr: PostfixExpr T_Inc  */
+#line 370 "parser.y"
+                                       {
+                                          Operator *op = new Operator(yylloc, (const char *)(yyvsp[0].identifier));
+                                          (yyval.expression) = new PostfixExpr((yyvsp[-1].expression), op);
                                        }
+#line 2306 "y.tab.c"
     break;
 
-  case 77:
-/* Line 1792 of yacc.c  */
-#line 349 "parser.y"
-    {
-                                          Operator *op = new Operator(yylloc, (const char *)(yyvsp[(2) - (2)].identifier));
-                                          (yyval.expression) = new PostfixExpr((yyvsp[(1) - (2)].expression), op);
+  case 82: /* PostfixExpr: PostfixExpr T_Dec  */
+#line 375 "parser.y"
+                                       {
+                                          Operator *op = new Operator(yylloc, (const char *)(yyvsp[0].identifier));
+                                          (yyval.expression) = new PostfixExpr((yyvsp[-1].expression), op);
                                        }
+#line 2315 "y.tab.c"
     break;
 
-  case 78:
-/* Line 1792 of yacc.c  */
-#line 354 "parser.y"
-    {
-                                          Identifier *id = new Identifier(yylloc, (const char *)(yyvsp[(3) - (3)].identifier));
-                                          (yyval.expression) = new FieldAccess((yyvsp[(1) - (3)].expression), id);
+  case 83: /* PostfixExpr: PostfixExpr T_Dot T_FieldSelection  */
+#line 380 "parser.y"
+                                       {
+                                          Identifier *id = new Identifier(yylloc, (const char *)(yyvsp[0].identifier));
+                                          (yyval.expression) = new FieldAccess((yyvsp[-2].expression), id);
                                        }
+#line 2324 "y.tab.c"
     break;
 
-  case 79:
-/* Line 1792 of yacc.c  */
-#line 360 "parser.y"
-    { (yyval.expression) = (yyvsp[(1) - (1)].expression); }
+  case 84: /* UnaryExpr: PostfixExpr  */
+#line 386 "parser.y"
+                                     { (yyval.expression) = (yyvsp[0].expression); }
+#line 2330 "y.tab.c"
     break;
 
-  case 80:
-/* Line 1792 of yacc.c  */
-#line 362 "parser.y"
-    {
-                             Operator *op = new Operator(yylloc, (yyvsp[(1) - (2)].identifier));
-                             (yyval.expression) = new ArithmeticExpr(op, (yyvsp[(2) - (2)].expression));
+  case 85: /* UnaryExpr: T_Inc UnaryExpr  */
+#line 388 "parser.y"
+                           {
+                             Operator *op = new Operator(yylloc, (yyvsp[-1].identifier));
+                             (yyval.expression) = new ArithmeticExpr(op, (yyvsp[0].expression));
                            }
+#line 2339 "y.tab.c"
     break;
 
-  case 81:
-/* Line 1792 of yacc.c  */
-#line 367 "parser.y"
-    {
-                             Operator *op = new Operator(yylloc, (yyvsp[(1) - (2)].identifier));
-                             (yyval.expression) = new ArithmeticExpr(op, (yyvsp[(2) - (2)].expression));
+  case 86: /* UnaryExpr: T_Dec UnaryExpr  */
+#line 393 "parser.y"
+                           {
+                             Operator *op = new Operator(yylloc, (yyvsp[-1].identifier));
+                             (yyval.expression) = new ArithmeticExpr(op, (yyvsp[0].expression));
                            }
+#line 2348 "y.tab.c"
     break;
 
-  case 82:
-/* Line 1792 of yacc.c  */
-#line 372 "parser.y"
-    {
-                             Operator *op = new Operator(yylloc, (yyvsp[(1) - (2)].identifier));
-                             (yyval.expression) = new ArithmeticExpr(op, (yyvsp[(2) - (2)].expression));
+  case 87: /* UnaryExpr: T_Plus UnaryExpr  */
+#line 398 "parser.y"
+                           {
+                             Operator *op = new Operator(yylloc, (yyvsp[-1].identifier));
+                             (yyval.expression) = new ArithmeticExpr(op, (yyvsp[0].expression));
                            }
+#line 2357 "y.tab.c"
     break;
 
-  case 83:
-/* Line 1792 of yacc.c  */
-#line 377 "parser.y"
-    {
-                             Operator *op = new Operator(yylloc, (yyvsp[(1) - (2)].identifier));
-                             (yyval.expression) = new ArithmeticExpr(op, (yyvsp[(2) - (2)].expression));
+  case 88: /* UnaryExpr: T_Dash UnaryExpr  */
+#line 403 "parser.y"
+                           {
+                             Operator *op = new Operator(yylloc, (yyvsp[-1].identifier));
+                             (yyval.expression) = new ArithmeticExpr(op, (yyvsp[0].expression));
                            }
+#line 2366 "y.tab.c"
     break;
 
-  case 84:
-/* Line 1792 of yacc.c  */
-#line 383 "parser.y"
-    { (yyval.expression) = (yyvsp[(1) - (1)].expression); }
+  case 89: /* MultiExpr: UnaryExpr  */
+#line 409 "parser.y"
+                                     { (yyval.expression) = (yyvsp[0].expression); }
+#line 2372 "y.tab.c"
     break;
 
-  case 85:
-/* Line 1792 of yacc.c  */
-#line 385 "parser.y"
-    {
-                             Operator *op = new Operator(yylloc, (yyvsp[(2) - (3)].identifier));
-                             (yyval.expression) = new ArithmeticExpr((yyvsp[(1) - (3)].expression), op, (yyvsp[(3) - (3)].expression));
+  case 90: /* MultiExpr: MultiExpr T_Star UnaryExpr  */
+#line 411 "parser.y"
+                           {
+                             Operator *op = new Operator(yylloc, (yyvsp[-1].identifier));
+                             (yyval.expression) = new ArithmeticExpr((yyvsp[-2].expression), op, (yyvsp[0].expression));
                            }
+#line 2381 "y.tab.c"
     break;
 
-  case 86:
-/* Line 1792 of yacc.c  */
-#line 390 "parser.y"
-    {
-                             Operator *op = new Operator(yylloc, (yyvsp[(2) - (3)].identifier));
-                             (yyval.expression) = new ArithmeticExpr((yyvsp[(1) - (3)].expression), op, (yyvsp[(3) - (3)].expression));
+  case 91: /* MultiExpr: MultiExpr T_Slash UnaryExpr  */
+#line 416 "parser.y"
+                           {
+                             Operator *op = new Operator(yylloc, (yyvsp[-1].identifier));
+                             (yyval.expression) = new ArithmeticExpr((yyvsp[-2].expression), op, (yyvsp[0].expression));
                            }
+#line 2390 "y.tab.c"
     break;
 
-  case 87:
-/* Line 1792 of yacc.c  */
-#line 396 "parser.y"
-    { (yyval.expression) = (yyvsp[(1) - (1)].expression); }
+  case 92: /* AdditionExpr: MultiExpr  */
+#line 422 "parser.y"
+                                     { (yyval.expression) = (yyvsp[0].expression); }
+#line 2396 "y.tab.c"
     break;
 
-  case 88:
-/* Line 1792 of yacc.c  */
-#line 398 "parser.y"
-    {
-                             Operator *op = new Operator(yylloc, (yyvsp[(2) - (3)].identifier));
-                             (yyval.expression) = new ArithmeticExpr((yyvsp[(1) - (3)].expression), op, (yyvsp[(3) - (3)].expression));
+  case 93: /* AdditionExpr: AdditionExpr T_Plus MultiExpr  */
+#line 424 "parser.y"
+                           {
+                             Operator *op = new Operator(yylloc, (yyvsp[-1].identifier));
+                             (yyval.expression) = new ArithmeticExpr((yyvsp[-2].expression), op, (yyvsp[0].expression));
                            }
+#line 2405 "y.tab.c"
     break;
 
-  case 89:
-/* Line 1792 of yacc.c  */
-#line 403 "parser.y"
-    {
-                             Operator *op = new Operator(yylloc, (yyvsp[(2) - (3)].identifier));
-                             (yyval.expression) = new ArithmeticExpr((yyvsp[(1) - (3)].expression), op, (yyvsp[(3) - (3)].expression));
+  case 94: /* AdditionExpr: AdditionExpr T_Dash MultiExpr  */
+#line 429 "parser.y"
+                           {
+                             Operator *op = new Operator(yylloc, (yyvsp[-1].identifier));
+                             (yyval.expression) = new ArithmeticExpr((yyvsp[-2].expression), op, (yyvsp[0].expression));
                            }
+#line 2414 "y.tab.c"
     break;
 
-  case 90:
-/* Line 1792 of yacc.c  */
-#line 409 "parser.y"
-    { (yyval.expression) = (yyvsp[(1) - (1)].expression); }
+  case 95: /* RelationExpr: AdditionExpr  */
+#line 435 "parser.y"
+                                        { (yyval.expression) = (yyvsp[0].expression); }
+#line 2420 "y.tab.c"
     break;
 
-  case 91:
-/* Line 1792 of yacc.c  */
-#line 411 "parser.y"
-    {
-                             Operator *op = new Operator(yylloc, (yyvsp[(2) - (3)].identifier));
-                             (yyval.expression) = new RelationalExpr((yyvsp[(1) - (3)].expression), op, (yyvsp[(3) - (3)].expression));
+  case 96: /* RelationExpr: RelationExpr T_LeftAngle AdditionExpr  */
+#line 437 "parser.y"
+                           {
+                             Operator *op = new Operator(yylloc, (yyvsp[-1].identifier));
+                             (yyval.expression) = new RelationalExpr((yyvsp[-2].expression), op, (yyvsp[0].expression));
                            }
+#line 2429 "y.tab.c"
     break;
 
-  case 92:
-/* Line 1792 of yacc.c  */
-#line 416 "parser.y"
-    {
-                             Operator *op = new Operator(yylloc, (yyvsp[(2) - (3)].identifier));
-                             (yyval.expression) = new RelationalExpr((yyvsp[(1) - (3)].expression), op, (yyvsp[(3) - (3)].expression));
+  case 97: /* RelationExpr: RelationExpr T_RightAngle AdditionExpr  */
+#line 442 "parser.y"
+                           {
+                             Operator *op = new Operator(yylloc, (yyvsp[-1].identifier));
+                             (yyval.expression) = new RelationalExpr((yyvsp[-2].expression), op, (yyvsp[0].expression));
                            }
+#line 2438 "y.tab.c"
     break;
 
-  case 93:
-/* Line 1792 of yacc.c  */
-#line 421 "parser.y"
-    {
-                             Operator *op = new Operator(yylloc, (yyvsp[(2) - (3)].identifier));
-                             (yyval.expression) = new RelationalExpr((yyvsp[(1) - (3)].expression), op, (yyvsp[(3) - (3)].expression));
+  case 98: /* RelationExpr: RelationExpr T_GreaterEqual AdditionExpr  */
+#line 447 "parser.y"
+                           {
+                             Operator *op = new Operator(yylloc, (yyvsp[-1].identifier));
+                             (yyval.expression) = new RelationalExpr((yyvsp[-2].expression), op, (yyvsp[0].expression));
                            }
+#line 2447 "y.tab.c"
     break;
 
-  case 94:
-/* Line 1792 of yacc.c  */
-#line 426 "parser.y"
-    {
-                             Operator *op = new Operator(yylloc, (yyvsp[(2) - (3)].identifier));
-                             (yyval.expression) = new RelationalExpr((yyvsp[(1) - (3)].expression), op, (yyvsp[(3) - (3)].expression));
+  case 99: /* RelationExpr: RelationExpr T_LessEqual AdditionExpr  */
+#line 452 "parser.y"
+                           {
+                             Operator *op = new Operator(yylloc, (yyvsp[-1].identifier));
+                             (yyval.expression) = new RelationalExpr((yyvsp[-2].expression), op, (yyvsp[0].expression));
                            }
+#line 2456 "y.tab.c"
     break;
 
-  case 95:
-/* Line 1792 of yacc.c  */
-#line 432 "parser.y"
-    { (yyval.expression) = (yyvsp[(1) - (1)].expression); }
+  case 100: /* EqualityExpr: RelationExpr  */
+#line 458 "parser.y"
+                                        { (yyval.expression) = (yyvsp[0].expression); }
+#line 2462 "y.tab.c"
     break;
 
-  case 96:
-/* Line 1792 of yacc.c  */
-#line 434 "parser.y"
-    {
-                             Operator *op = new Operator(yylloc, (yyvsp[(2) - (3)].identifier));
-                             (yyval.expression) = new EqualityExpr((yyvsp[(1) - (3)].expression), op, (yyvsp[(3) - (3)].expression));
+  case 101: /* EqualityExpr: EqualityExpr T_EQ RelationExpr  */
+#line 460 "parser.y"
+                           {
+                             Operator *op = new Operator(yylloc, (yyvsp[-1].identifier));
+                             (yyval.expression) = new EqualityExpr((yyvsp[-2].expression), op, (yyvsp[0].expression));
                            }
+#line 2471 "y.tab.c"
     break;
 
-  case 97:
-/* Line 1792 of yacc.c  */
-#line 439 "parser.y"
-    {
-                             Operator *op = new Operator(yylloc, (yyvsp[(2) - (3)].identifier));
-                             (yyval.expression) = new EqualityExpr((yyvsp[(1) - (3)].expression), op, (yyvsp[(3) - (3)].expression));
+  case 102: /* EqualityExpr: EqualityExpr T_NE RelationExpr  */
+#line 465 "parser.y"
+                           {
+                             Operator *op = new Operator(yylloc, (yyvsp[-1].identifier));
+                             (yyval.expression) = new EqualityExpr((yyvsp[-2].expression), op, (yyvsp[0].expression));
                            }
+#line 2480 "y.tab.c"
     break;
 
-  case 98:
-/* Line 1792 of yacc.c  */
-#line 445 "parser.y"
-    { (yyval.expression) = (yyvsp[(1) - (1)].expression); }
+  case 103: /* LogicAndExpr: EqualityExpr  */
+#line 471 "parser.y"
+                                        { (yyval.expression) = (yyvsp[0].expression); }
+#line 2486 "y.tab.c"
     break;
 
-  case 99:
-/* Line 1792 of yacc.c  */
-#line 447 "parser.y"
-    {
-                             Operator *op = new Operator(yylloc, (yyvsp[(2) - (3)].identifier));
-                             (yyval.expression) = new LogicalExpr((yyvsp[(1) - (3)].expression), op, (yyvsp[(3) - (3)].expression));
+  case 104: /* LogicAndExpr: LogicAndExpr T_And EqualityExpr  */
+#line 473 "parser.y"
+                           {
+                             Operator *op = new Operator(yylloc, (yyvsp[-1].identifier));
+                             (yyval.expression) = new LogicalExpr((yyvsp[-2].expression), op, (yyvsp[0].expression));
                            }
+#line 2495 "y.tab.c"
     break;
 
-  case 100:
-/* Line 1792 of yacc.c  */
-#line 453 "parser.y"
-    { (yyval.expression) = (yyvsp[(1) - (1)].expression); }
+  case 105: /* LogicOrExpr: LogicAndExpr  */
+#line 479 "parser.y"
+                                        { (yyval.expression) = (yyvsp[0].expression); }
+#line 2501 "y.tab.c"
     break;
 
-  case 101:
-/* Line 1792 of yacc.c  */
-#line 455 "parser.y"
-    {
-                             Operator *op = new Operator(yylloc, (yyvsp[(2) - (3)].identifier));
-                             (yyval.expression) = new LogicalExpr((yyvsp[(1) - (3)].expression), op, (yyvsp[(3) - (3)].expression));
+  case 106: /* LogicOrExpr: LogicOrExpr T_Or LogicAndExpr  */
+#line 481 "parser.y"
+                           {
+                             Operator *op = new Operator(yylloc, (yyvsp[-1].identifier));
+                             (yyval.expression) = new LogicalExpr((yyvsp[-2].expression), op, (yyvsp[0].expression));
                            }
+#line 2510 "y.tab.c"
     break;
 
-  case 102:
-/* Line 1792 of yacc.c  */
-#line 461 "parser.y"
-    { (yyval.expression) = (yyvsp[(1) - (1)].expression); }
+  case 107: /* Expression: LogicOrExpr  */
+#line 487 "parser.y"
+                                       { (yyval.expression) = (yyvsp[0].expression); }
+#line 2516 "y.tab.c"
     break;
 
-  case 103:
-/* Line 1792 of yacc.c  */
-#line 463 "parser.y"
-    {
-                             (yyval.expression) = new ConditionalExpr((yyvsp[(1) - (5)].expression), (yyvsp[(3) - (5)].expression), (yyvsp[(5) - (5)].expression));
+  case 108: /* Expression: LogicOrExpr T_Question LogicOrExpr T_Colon LogicOrExpr  */
+#line 489 "parser.y"
+                           {
+                             (yyval.expression) = new ConditionalExpr((yyvsp[-4].expression), (yyvsp[-2].expression), (yyvsp[0].expression));
                            }
+#line 2524 "y.tab.c"
     break;
 
-  case 104:
-/* Line 1792 of yacc.c  */
-#line 467 "parser.y"
-    {
-                             (yyval.expression) = new AssignExpr((yyvsp[(1) - (3)].expression), (yyvsp[(2) - (3)].ops), (yyvsp[(3) - (3)].expression));
+  case 109: /* Expression: UnaryExpr AssignOp Expression  */
+#line 493 "parser.y"
+                           {
+                             (yyval.expression) = new AssignExpr((yyvsp[-2].expression), (yyvsp[-1].ops), (yyvsp[0].expression));
                            }
+#line 2532 "y.tab.c"
     break;
 
-  case 105:
-/* Line 1792 of yacc.c  */
-#line 472 "parser.y"
-    { (yyval.ops) = new Operator(yylloc, (yyvsp[(1) - (1)].identifier));   }
+  case 110: /* AssignOp: T_Equal  */
+#line 498 "parser.y"
+                                     { (yyval.ops) = new Operator(yylloc, (yyvsp[0].identifier));   }
+#line 2538 "y.tab.c"
     break;
 
-  case 106:
-/* Line 1792 of yacc.c  */
-#line 473 "parser.y"
-    { (yyval.ops) = new Operator(yylloc, "+=");  }
+  case 111: /* AssignOp: T_AddAssign  */
+#line 499 "parser.y"
+                                     { (yyval.ops) = new Operator(yylloc, "+=");  }
+#line 2544 "y.tab.c"
     break;
 
-  case 107:
-/* Line 1792 of yacc.c  */
-#line 474 "parser.y"
-    { (yyval.ops) = new Operator(yylloc, "-=");  }
+  case 112: /* AssignOp: T_SubAssign  */
+#line 500 "parser.y"
+                                     { (yyval.ops) = new Operator(yylloc, "-=");  }
+#line 2550 "y.tab.c"
     break;
 
-  case 108:
-/* Line 1792 of yacc.c  */
-#line 475 "parser.y"
-    { (yyval.ops) = new Operator(yylloc, "*=");  }
+  case 113: /* AssignOp: T_MulAssign  */
+#line 501 "parser.y"
+                                     { (yyval.ops) = new Operator(yylloc, "*=");  }
+#line 2556 "y.tab.c"
     break;
 
-  case 109:
-/* Line 1792 of yacc.c  */
-#line 476 "parser.y"
-    { (yyval.ops) = new Operator(yylloc, "/=");  }
+  case 114: /* AssignOp: T_DivAssign  */
+#line 502 "parser.y"
+                                     { (yyval.ops) = new Operator(yylloc, "/=");  }
+#line 2562 "y.tab.c"
     break;
 
 
-/* Line 1792 of yacc.c  */
-#line 2629 "y.tab.c"
+#line 2566 "y.tab.c"
+
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -2639,97 +2577,60 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
   *++yylsp = yyloc;
 
-  /* Now `shift' the result of the reduction.  Determine what state
+  /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
 
-/*------------------------------------.
-| yyerrlab -- here on detecting error |
-`------------------------------------*/
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
       yyerror (YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
-      {
-        char const *yymsgp = YY_("syntax error");
-        int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
-        if (yysyntax_error_status == 0)
-          yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
-          {
-            if (yymsg != yymsgbuf)
-              YYSTACK_FREE (yymsg);
-            yymsg = (char *) YYSTACK_ALLOC (yymsg_alloc);
-            if (!yymsg)
-              {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
-              }
-            else
-              {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
-              }
-          }
-        yyerror (yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
-      }
-# undef YYSYNTAX_ERROR
-#endif
     }
 
   yyerror_range[1] = yylloc;
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
-	 error, discard it.  */
+         error, discard it.  */
 
       if (yychar <= YYEOF)
-	{
-	  /* Return failure if at end of input.  */
-	  if (yychar == YYEOF)
-	    YYABORT;
-	}
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
       else
-	{
-	  yydestruct ("Error: discarding",
-		      yytoken, &yylval, &yylloc);
-	  yychar = YYEMPTY;
-	}
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval, &yylloc);
+          yychar = YYEMPTY;
+        }
     }
 
   /* Else will try to reuse lookahead token after shifting the error
@@ -2741,15 +2642,13 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
-
-  yyerror_range[1] = yylsp[1-yylen];
-  /* Do not reclaim the symbols of the rule which action triggered
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
   YYPOPSTACK (yylen);
   yylen = 0;
@@ -2762,29 +2661,30 @@ yyerrorlab:
 | yyerrlab1 -- common code for both syntax error and YYERROR.  |
 `-------------------------------------------------------------*/
 yyerrlab1:
-  yyerrstatus = 3;	/* Each real token shifted decrements this.  */
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
-	{
-	  yyn += YYTERROR;
-	  if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
-	    {
-	      yyn = yytable[yyn];
-	      if (0 < yyn)
-		break;
-	    }
-	}
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
 
       /* Pop the current state because it cannot handle the error token.  */
       if (yyssp == yyss)
-	YYABORT;
+        YYABORT;
 
       yyerror_range[1] = *yylsp;
       yydestruct ("Error: popping",
-		  yystos[yystate], yyvsp, yylsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, yylsp);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -2795,13 +2695,11 @@ yyerrlab1:
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
   yyerror_range[2] = yylloc;
-  /* Using YYLLOC is tempting, but would change the location of
-     the lookahead.  YYLOC is available though.  */
-  YYLLOC_DEFAULT (yyloc, yyerror_range, 2);
-  *++yylsp = yyloc;
+  ++yylsp;
+  YYLLOC_DEFAULT (*yylsp, yyerror_range, 2);
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2812,26 +2710,30 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
   yyerror (YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
+
 
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
@@ -2840,31 +2742,25 @@ yyreturn:
       yydestruct ("Cleanup: discarding lookahead",
                   yytoken, &yylval, &yylloc);
     }
-  /* Do not reclaim the symbols of the rule which action triggered
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
   YYPOPSTACK (yylen);
   YY_STACK_PRINT (yyss, yyssp);
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-		  yystos[*yyssp], yyvsp, yylsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
-  /* Make sure YYID is used.  */
-  return YYID (yyresult);
-}
 
+  return yyresult;
+}
 
-/* Line 2055 of yacc.c  */
-#line 479 "parser.y"
+#line 505 "parser.y"
 
 
 /* The closing %% above marks the end of the Rules section and the beginning
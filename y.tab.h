@@ -1,21 +1,22 @@
-/* A Bison parser, made by GNU Bison 2.7.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison interface for Yacc-like parsers in C
-   
-      Copyright (C) 1984, 1989-1990, 2000-2012 Free Software Foundation, Inc.
-   
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
    the Free Software Foundation, either version 3 of the License, or
    (at your option) any later version.
-   
+
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
    GNU General Public License for more details.
-   
+
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -26,13 +27,17 @@
    special exception, which will cause the skeleton and the resulting
    Bison output files to be licensed under the GNU General Public
    License without this special exception.
-   
+
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 #ifndef YY_YY_Y_TAB_H_INCLUDED
 # define YY_YY_Y_TAB_H_INCLUDED
-/* Enabling traces.  */
+/* Debug traces.  */
 #ifndef YYDEBUG
 # define YYDEBUG 1
 #endif
@@ -40,87 +45,96 @@
 extern int yydebug;
 #endif
 
-/* Tokens.  */
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     T_Void = 258,
-     T_Bool = 259,
-     T_Int = 260,
-     T_Float = 261,
-     T_Uint = 262,
-     T_Bvec2 = 263,
-     T_Bvec3 = 264,
-     T_Bvec4 = 265,
-     T_Ivec2 = 266,
-     T_Ivec3 = 267,
-     T_Ivec4 = 268,
-     T_Uvec2 = 269,
-     T_Uvec3 = 270,
-     T_Uvec4 = 271,
-     T_Vec2 = 272,
-     T_Vec3 = 273,
-     T_Vec4 = 274,
-     T_Mat2 = 275,
-     T_Mat3 = 276,
-     T_Mat4 = 277,
-     T_While = 278,
-     T_For = 279,
-     T_If = 280,
-     T_Else = 281,
-     T_Return = 282,
-     T_Break = 283,
-     T_Continue = 284,
-     T_Do = 285,
-     T_Switch = 286,
-     T_Case = 287,
-     T_Default = 288,
-     T_In = 289,
-     T_Out = 290,
-     T_Const = 291,
-     T_Uniform = 292,
-     T_LeftParen = 293,
-     T_RightParen = 294,
-     T_LeftBracket = 295,
-     T_RightBracket = 296,
-     T_LeftBrace = 297,
-     T_RightBrace = 298,
-     T_Dot = 299,
-     T_Comma = 300,
-     T_Colon = 301,
-     T_Semicolon = 302,
-     T_Question = 303,
-     T_LessEqual = 304,
-     T_GreaterEqual = 305,
-     T_EQ = 306,
-     T_NE = 307,
-     T_And = 308,
-     T_Or = 309,
-     T_Plus = 310,
-     T_Star = 311,
-     T_MulAssign = 312,
-     T_DivAssign = 313,
-     T_AddAssign = 314,
-     T_SubAssign = 315,
-     T_Equal = 316,
-     T_LeftAngle = 317,
-     T_RightAngle = 318,
-     T_Dash = 319,
-     T_Slash = 320,
-     T_Inc = 321,
-     T_Dec = 322,
-     T_Identifier = 323,
-     T_IntConstant = 324,
-     T_FloatConstant = 325,
-     T_BoolConstant = 326,
-     T_FieldSelection = 327,
-     LOWEST = 328,
-     LOWER_THAN_ELSE = 329
-   };
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    T_Void = 258,                  /* T_Void  */
+    T_Bool = 259,                  /* T_Bool  */
+    T_Int = 260,                   /* T_Int  */
+    T_Float = 261,                 /* T_Float  */
+    T_Uint = 262,                  /* T_Uint  */
+    T_Bvec2 = 263,                 /* T_Bvec2  */
+    T_Bvec3 = 264,                 /* T_Bvec3  */
+    T_Bvec4 = 265,                 /* T_Bvec4  */
+    T_Ivec2 = 266,                 /* T_Ivec2  */
+    T_Ivec3 = 267,                 /* T_Ivec3  */
+    T_Ivec4 = 268,                 /* T_Ivec4  */
+    T_Uvec2 = 269,                 /* T_Uvec2  */
+    T_Uvec3 = 270,                 /* T_Uvec3  */
+    T_Uvec4 = 271,                 /* T_Uvec4  */
+    T_Vec2 = 272,                  /* T_Vec2  */
+    T_Vec3 = 273,                  /* T_Vec3  */
+    T_Vec4 = 274,                  /* T_Vec4  */
+    T_Mat2 = 275,                  /* T_Mat2  */
+    T_Mat3 = 276,                  /* T_Mat3  */
+    T_Mat4 = 277,                  /* T_Mat4  */
+    T_While = 278,                 /* T_While  */
+    T_For = 279,                   /* T_For  */
+    T_If = 280,                    /* T_If  */
+    T_Else = 281,                  /* T_Else  */
+    T_Return = 282,                /* T_Return  */
+    T_Break = 283,                 /* T_Break  */
+    T_Continue = 284,              /* T_Continue  */
+    T_Do = 285,                    /* T_Do  */
+    T_Switch = 286,                /* T_Switch  */
+    T_Case = 287,                  /* T_Case  */
+    T_Default = 288,               /* T_Default  */
+    T_In = 289,                    /* T_In  */
+    T_Out = 290,                   /* T_Out  */
+    T_Const = 291,                 /* T_Const  */
+    T_Uniform = 292,               /* T_Uniform  */
+    T_LeftParen = 293,             /* T_LeftParen  */
+    T_RightParen = 294,            /* T_RightParen  */
+    T_LeftBracket = 295,           /* T_LeftBracket  */
+    T_RightBracket = 296,          /* T_RightBracket  */
+    T_LeftBrace = 297,             /* T_LeftBrace  */
+    T_RightBrace = 298,            /* T_RightBrace  */
+    T_Dot = 299,                   /* T_Dot  */
+    T_Comma = 300,                 /* T_Comma  */
+    T_Colon = 301,                 /* T_Colon  */
+    T_Semicolon = 302,             /* T_Semicolon  */
+    T_Question = 303,              /* T_Question  */
+    T_LessEqual = 304,             /* T_LessEqual  */
+    T_GreaterEqual = 305,          /* T_GreaterEqual  */
+    T_EQ = 306,                    /* T_EQ  */
+    T_NE = 307,                    /* T_NE  */
+    T_And = 308,                   /* T_And  */
+    T_Or = 309,                    /* T_Or  */
+    T_Plus = 310,                  /* T_Plus  */
+    T_Star = 311,                  /* T_Star  */
+    T_MulAssign = 312,             /* T_MulAssign  */
+    T_DivAssign = 313,             /* T_DivAssign  */
+    T_AddAssign = 314,             /* T_AddAssign  */
+    T_SubAssign = 315,             /* T_SubAssign  */
+    T_Equal = 316,                 /* T_Equal  */
+    T_LeftAngle = 317,             /* T_LeftAngle  */
+    T_RightAngle = 318,            /* T_RightAngle  */
+    T_Dash = 319,                  /* T_Dash  */
+    T_Slash = 320,                 /* T_Slash  */
+    T_Inc = 321,                   /* T_Inc  */
+    T_Dec = 322,                   /* T_Dec  */
+    T_Identifier = 323,            /* T_Identifier  */
+    T_IntConstant = 324,           /* T_IntConstant  */
+    T_FloatConstant = 325,         /* T_FloatConstant  */
+    T_BoolConstant = 326,          /* T_BoolConstant  */
+    T_FieldSelection = 327,        /* T_FieldSelection  */
+    T_Pragma = 328,                /* T_Pragma  */
+    LOWEST = 329,                  /* LOWEST  */
+    LOWER_THAN_ELSE = 330          /* LOWER_THAN_ELSE  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
-/* Tokens.  */
+/* Token kinds.  */
+#define YYEMPTY -2
+#define YYEOF 0
+#define YYerror 256
+#define YYUNDEF 257
 #define T_Void 258
 #define T_Bool 259
 #define T_Int 260
@@ -191,16 +205,15 @@ extern int yydebug;
 #define T_FloatConstant 325
 #define T_BoolConstant 326
 #define T_FieldSelection 327
-#define LOWEST 328
-#define LOWER_THAN_ELSE 329
-
-
+#define T_Pragma 328
+#define LOWEST 329
+#define LOWER_THAN_ELSE 330
 
+/* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
+union YYSTYPE
 {
-/* Line 2058 of yacc.c  */
-#line 41 "parser.y"
+#line 43 "parser.y"
 
     int integerConstant;
     bool boolConstant;
@@ -220,42 +233,33 @@ typedef union YYSTYPE
     Identifier *funcId;
     List<Expr*> *argList;
 
+#line 237 "y.tab.h"
 
-/* Line 2058 of yacc.c  */
-#line 226 "y.tab.h"
-} YYSTYPE;
+};
+typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
 # define YYSTYPE_IS_DECLARED 1
 #endif
 
+/* Location type.  */
 #if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
-typedef struct YYLTYPE
+typedef struct YYLTYPE YYLTYPE;
+struct YYLTYPE
 {
   int first_line;
   int first_column;
   int last_line;
   int last_column;
-} YYLTYPE;
-# define yyltype YYLTYPE /* obsolescent; will be withdrawn */
+};
 # define YYLTYPE_IS_DECLARED 1
 # define YYLTYPE_IS_TRIVIAL 1
 #endif
 
+
 extern YYSTYPE yylval;
 extern YYLTYPE yylloc;
-#ifdef YYPARSE_PARAM
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void *YYPARSE_PARAM);
-#else
-int yyparse ();
-#endif
-#else /* ! YYPARSE_PARAM */
-#if defined __STDC__ || defined __cplusplus
+
 int yyparse (void);
-#else
-int yyparse ();
-#endif
-#endif /* ! YYPARSE_PARAM */
+
 
 #endif /* !YY_YY_Y_TAB_H_INCLUDED  */